@@ -0,0 +1,45 @@
+#ifndef __ABI_H
+#define __ABI_H
+
+#include <uint256.h>
+
+/*
+    Incremental decoding of ABI encoded arguments.
+
+    The reader walks the head of the arguments one word at a time, and the
+    elements of a uint256[] are only converted to little endian when they
+    are read with abi_words_next. So a handler can stream through an array
+    of thousands of words, which stay where read_args put them in the arena,
+    without copying or converting it up front.
+
+    Every function returns false if the input is too short or an offset or
+    length points outside of it.
+*/
+
+typedef struct abi_reader {
+    const uint8_t *data; // the arguments, after the selector
+    size_t len;
+    size_t head; // offset of the next head word
+} abi_reader;
+
+// the elements of a uint256[] that haven't been read yet
+typedef struct abi_words {
+    const uint8_t *next;
+    size_t left;
+} abi_words;
+
+void abi_init(abi_reader *r, const uint8_t *data, size_t len);
+
+// the next argument, a static uint256
+bool abi_u256(abi_reader *r, u256 x);
+
+// the next argument, bytes
+bool abi_bytes(abi_reader *r, const uint8_t **data, size_t *n);
+
+// the next argument, a uint256[]
+bool abi_array(abi_reader *r, abi_words *w);
+
+// the next element of the array
+bool abi_words_next(abi_words *w, u256 x);
+
+#endif // __ABI_H
@@ -0,0 +1,36 @@
+#ifndef __ARENA_H
+#define __ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+    A bump allocator for the argument, scratch and return buffers of a call.
+
+    In wasm the arena starts at __heap_base and grows linear memory with
+    memory.grow, which Stylus charges for through pay_for_memory_grow. Native
+    builds reserve up to ARENA_NATIVE_RESERVE bytes of address space at
+    startup and commit it ARENA_NATIVE_STEP bytes at a time as the arena
+    grows, so it is as large as memory allows and never moves.
+
+    ENTRYPOINT resets the arena at the start of every call, so nothing
+    allocated here outlives the call and nothing needs to be freed. Memory
+    that can't be allocated traps in wasm, like running out of gas, and
+    natively aborts with a message on stderr.
+*/
+
+#define ARENA_ALIGN 16
+#define ARENA_NATIVE_RESERVE ((size_t)1 << (sizeof(size_t) > 4 ? 40 : 30))
+#define ARENA_NATIVE_STEP (1 << 20)
+
+// frees everything
+void arena_reset(void);
+
+// returns size bytes aligned to ARENA_ALIGN
+void *arena_alloc(size_t size);
+
+// scratch allocations: everything allocated after a mark is freed by release
+size_t arena_mark(void);
+void arena_release(size_t mark);
+
+#endif // __ARENA_H
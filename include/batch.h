@@ -0,0 +1,38 @@
+#ifndef __BATCH_H
+#define __BATCH_H
+
+#include <uint256.h>
+#include <opcodes.h>
+
+/*
+    Batch programs run several uint256 operations in a single contract call.
+
+    A program is a sequence of instructions over BATCH_REGISTERS registers,
+    which all start out as zero. Every instruction begins with a one byte
+    opcode followed by one byte register references:
+
+      OP_ADD ... OP_SAR   dst, then one register per operand, in the same
+                          order as the arguments of the matching u256_*
+                          function and contract entry point
+      BATCH_LOAD          dst, then a packed literal (see packed.h): a
+                          length n <= 32 and n big endian bytes
+      BATCH_OUT           src, which is appended to the output
+
+    Comparison opcodes write 0 or 1 into dst. Outputs are written as 32 byte
+    big endian words.
+*/
+
+#define BATCH_REGISTERS 16
+
+#define BATCH_LOAD 0x60
+#define BATCH_OUT  0xf3
+
+/*
+    Runs the program and writes at most max_out words to out.
+
+    Returns the number of words written, or -1 if the program is malformed,
+    references a register out of range or produces more than max_out words.
+*/
+int batch_run(const uint8_t *program, size_t len, uint8_t *out, int max_out);
+
+#endif // __BATCH_H
@@ -0,0 +1,158 @@
+#ifndef __BITFIELD_H
+#define __BITFIELD_H
+
+#include <uint256_core.h>
+#include <bebi.h>
+
+/*
+    Bit fields of a 256 bit word, for structs packed into storage slots.
+
+    Fields are numbered from the least significant bit, like the Solidity
+    storage layout: in a word packing (uint64 a, uint32 b, address c), a is
+    at bit 0, b at bit 64 and c at bit 96.
+
+    The functions are static inline and written without data dependent
+    branches, so with a constant offset and length, as generated by
+    BITFIELD_LAYOUT, each accessor compiles to a few straight-line shifts and
+    masks on the limbs the field touches.
+*/
+
+// the low n bits set, for any n
+static inline u64 bitfield_mask(int n) {
+    return n <= 0 ? 0 : n >= 64 ? MAX_U64 : (1ULL << n) - 1;
+}
+
+// res = (x >> off) & (2^len - 1), off + len <= 256
+static inline void u256_extract_bits(u256 res, u256 x, int off, int len) {
+    int q = off / 64;
+    int r = off % 64;
+    u256 t;
+    for (int i = 0; i < 4; i++) {
+        u64 lo = i + q < 4 ? x[i+q] : 0;
+        u64 hi = i + q + 1 < 4 ? x[i+q+1] : 0;
+        t[i] = r == 0 ? lo : (lo >> r) | (hi << (64 - r));
+        t[i] &= bitfield_mask(len - 64*i);
+    }
+    for (int i = 0; i < 4; i++) {
+        res[i] = t[i];
+    }
+}
+
+// the field as a u64, len <= 64
+static inline u64 u256_extract_u64(u256 x, int off, int len) {
+    int q = off / 64;
+    int r = off % 64;
+    u64 lo = x[q];
+    u64 hi = q < 3 ? x[q+1] : 0;
+    u64 v = r == 0 ? lo : (lo >> r) | (hi << (64 - r));
+    return v & bitfield_mask(len);
+}
+
+// sets len bits of x at off to the low len bits of v, off + len <= 256
+static inline void u256_insert_bits(u256 x, u256 v, int off, int len) {
+    int q = off / 64;
+    int r = off % 64;
+    for (int i = 3; i >= 0; i--) {
+        // limb i of v << off, and of the field mask
+        u64 lo = i - q >= 0 ? v[i-q] : 0;
+        u64 lo2 = i - q - 1 >= 0 ? v[i-q-1] : 0;
+        u64 shifted = r == 0 ? lo : (lo << r) | (lo2 >> (64 - r));
+        u64 mask = bitfield_mask(off + len - 64*i) & ~bitfield_mask(off - 64*i);
+        x[i] = (x[i] & ~mask) | (shifted & mask);
+    }
+}
+
+static inline void u256_insert_u64(u256 x, u64 v, int off, int len) {
+    u256 w = {v, 0, 0, 0};
+    u256_insert_bits(x, w, off, len);
+}
+
+/*
+    The same on big endian words, such as the ones read with
+    storage_load_bytes32. Only the limbs that hold the field are loaded.
+*/
+static inline u64 bitfield_load_limb(const bebi32 word, int i) {
+    u64 limb;
+    __builtin_memcpy(&limb, word + (24 - 8*i), 8);
+    return __builtin_bswap64(limb);
+}
+
+static inline void bitfield_store_limb(bebi32 word, int i, u64 limb) {
+    limb = __builtin_bswap64(limb);
+    __builtin_memcpy(word + (24 - 8*i), &limb, 8);
+}
+
+static inline void u256be_extract_bits(u256 res, const bebi32 word, int off,
+                                       int len) {
+    u256 x;
+    for (int i = 0; i < 4; i++) {
+        // limbs outside [off, off+len) are never used
+        bool used = 64*i + 64 > off && 64*i < off + len;
+        x[i] = used ? bitfield_load_limb(word, i) : 0;
+    }
+    u256_extract_bits(res, x, off, len);
+}
+
+static inline u64 u256be_extract_u64(const bebi32 word, int off, int len) {
+    u256 x;
+    u256be_extract_bits(x, word, off, len);
+    return x[0];
+}
+
+static inline void u256be_insert_bits(bebi32 word, u256 v, int off, int len) {
+    u256 x;
+    for (int i = 0; i < 4; i++) {
+        bool used = 64*i + 64 > off && 64*i < off + len;
+        x[i] = used ? bitfield_load_limb(word, i) : 0;
+    }
+    u256_insert_bits(x, v, off, len);
+    for (int i = 0; i < 4; i++) {
+        if (64*i + 64 > off && 64*i < off + len) {
+            bitfield_store_limb(word, i, x[i]);
+        }
+    }
+}
+
+static inline void u256be_insert_u64(bebi32 word, u64 v, int off, int len) {
+    u256 w = {v, 0, 0, 0};
+    u256be_insert_bits(word, w, off, len);
+}
+
+/*
+    Accessors for a packed struct, from a list of fields.
+
+        #define POSITION(F, p)              \
+            F(p, liquidity, 0, 64)          \
+            F(p, last_update, 64, 32)       \
+            F(p, owner, 96, 160)
+
+        BITFIELD_LAYOUT(position, POSITION)
+
+    defines, for every field,
+
+        void position_get_liquidity(u256 res, u256 word);
+        void position_set_liquidity(u256 word, u256 v);
+        void position_be_get_liquidity(u256 res, const bebi32 word);
+        void position_be_set_liquidity(bebi32 word, u256 v);
+
+    and checks at compile time that each field fits in the word.
+*/
+#define BITFIELD_ACCESSORS(prefix, name, off, len)                          \
+    _Static_assert((off) >= 0 && (len) > 0 && (off) + (len) <= 256,         \
+                   #prefix "." #name " doesn't fit in 256 bits");           \
+    static inline void prefix##_get_##name(u256 res, u256 word) {           \
+        u256_extract_bits(res, word, (off), (len));                         \
+    }                                                                       \
+    static inline void prefix##_set_##name(u256 word, u256 v) {             \
+        u256_insert_bits(word, v, (off), (len));                            \
+    }                                                                       \
+    static inline void prefix##_be_get_##name(u256 res, const bebi32 word) {\
+        u256be_extract_bits(res, word, (off), (len));                       \
+    }                                                                       \
+    static inline void prefix##_be_set_##name(bebi32 word, u256 v) {        \
+        u256be_insert_bits(word, v, (off), (len));                          \
+    }
+
+#define BITFIELD_LAYOUT(prefix, FIELDS) FIELDS(BITFIELD_ACCESSORS, prefix)
+
+#endif // __BITFIELD_H
@@ -0,0 +1,57 @@
+#ifndef __BITMAP_H
+#define __BITMAP_H
+
+#include <uint256.h>
+#include <bebi.h>
+
+/*
+    Bitmaps of set indices, packed 256 to a word, with "next set bit at or
+    below / at or above" searches like a Uniswap v3 TickBitmap.
+
+    Bit pos of a word is bit pos % 64 of limb pos / 64, so bit 0 is the
+    least significant. The searches return the index of the set bit found,
+    or -1 if there is none.
+*/
+
+// the highest set bit of x at or below pos, 0 <= pos < 256
+int u256_next_set_bit_le(u256 x, int pos);
+
+// the lowest set bit of x at or above pos, 0 <= pos < 256
+int u256_next_set_bit_ge(u256 x, int pos);
+
+void u256_flip_bit(u256 x, int pos);
+
+/*
+    A bitmap of BITMAP_BITS indices in memory.
+
+    Bit w of the summary word is set when words[w] is nonzero, so a search
+    that runs off the end of its word finds the next nonempty word with one
+    more word search instead of a scan.
+*/
+#define BITMAP_WORDS 256
+#define BITMAP_BITS (BITMAP_WORDS * 256)
+
+typedef struct bitmap {
+    u256 summary;
+    u256 words[BITMAP_WORDS];
+} bitmap;
+
+void bitmap_init(bitmap *b);
+void bitmap_flip(bitmap *b, int index);
+bool bitmap_get(bitmap *b, int index);
+int bitmap_next_le(bitmap *b, int index);
+int bitmap_next_ge(bitmap *b, int index);
+
+/*
+    The same bitmap in storage, through the slot cache.
+
+    The summary is kept in slot base and word w in slot base + 1 + w. A
+    search loads the summary and at most two words, and flip stores one word
+    and, when the word becomes empty or nonempty, the summary.
+*/
+void sbitmap_flip(const bebi32 base, int index);
+bool sbitmap_get(const bebi32 base, int index);
+int sbitmap_next_le(const bebi32 base, int index);
+int sbitmap_next_ge(const bebi32 base, int index);
+
+#endif // __BITMAP_H
@@ -0,0 +1,173 @@
+#ifndef __BN254_H
+#define __BN254_H
+
+#include <uint256.h>
+
+/*
+    BN254 (alt_bn128), the curve of the EVM precompiles 0x06 and 0x07:
+    y^2 = x^3 + 3 over the prime field bn254_fp, with the generator (1, 2)
+    of prime order r and no cofactor.
+
+    Coordinates are kept in the Montgomery form of bn254_fp (see fields.h),
+    in which zero is still zero, so the point at infinity is (0, 0) in both
+    the byte layout and the structs.
+*/
+
+typedef struct bn254_g1 {
+    u256 x;
+    u256 y;
+    bool infinity;
+} bn254_g1;
+
+// the point at infinity has z = 0
+typedef struct bn254_g1j {
+    u256 x;
+    u256 y;
+    u256 z;
+} bn254_g1j;
+
+/*
+    affine, one inversion per operation
+*/
+void bn254_g1_add(bn254_g1 *r, const bn254_g1 *a, const bn254_g1 *b);
+void bn254_g1_double(bn254_g1 *r, const bn254_g1 *a);
+
+// infinity, or on the curve
+bool bn254_g1_valid(const bn254_g1 *a);
+
+/*
+    Jacobian, no inversions. r may be any of the operands.
+*/
+void bn254_g1j_from(bn254_g1j *r, const bn254_g1 *a);
+void bn254_g1j_to(bn254_g1 *r, const bn254_g1j *a);
+void bn254_g1j_double(bn254_g1j *r, const bn254_g1j *a);
+void bn254_g1j_add(bn254_g1j *r, const bn254_g1j *a, const bn254_g1j *b);
+void bn254_g1j_add_affine(bn254_g1j *r, const bn254_g1j *a,
+                          const bn254_g1 *b);
+
+// r = k a, with 5 bit wNAF digits, for any 256 bit k
+void bn254_g1_mul(bn254_g1 *r, const bn254_g1 *a, const u256 k);
+
+/*
+    The EVM byte layout: big endian 32 byte words, x then y.
+
+    from_bytes fails if a coordinate isn't below p or the point isn't on
+    the curve, which is when the precompiles fail.
+*/
+bool bn254_g1_from_bytes(bn254_g1 *r, const uint8_t in[64]);
+void bn254_g1_to_bytes(uint8_t out[64], const bn254_g1 *a);
+
+/*
+    The precompiles, on their raw input and output: input shorter than 128
+    (ecAdd: x1, y1, x2, y2) or 96 bytes (ecMul: x, y, k) is padded with
+    zeros, and longer input is ignored. out gets 64 bytes.
+*/
+bool bn254_ec_add(uint8_t out[64], const uint8_t *in, size_t len);
+bool bn254_ec_mul(uint8_t out[64], const uint8_t *in, size_t len);
+
+/*
+    Multi-scalar multiplication, in src/bn254_msm.c:
+
+        r = scalars[0] points[0] + ... + scalars[n-1] points[n-1]
+
+    for any 256 bit scalars, with Pippenger's method: every window of c bits
+    of the scalars sorts the points into 2^(c-1) buckets by their signed
+    digit, and the buckets are summed with the weights of their digits.
+    Points go into the buckets in batches of affine additions that share a
+    single inversion. The arena holds the digits, 2 bytes per point and
+    window, and the buckets.
+*/
+#define BN254_MSM_MIN_WINDOW 2
+#define BN254_MSM_MAX_WINDOW 16
+
+// fewer points are multiplied one by one, which is faster
+#define BN254_MSM_MIN_POINTS 32
+
+// the window c for n points, about ln n + 2
+int bn254_msm_window(size_t n);
+
+void bn254_g1_msm(bn254_g1 *r, const bn254_g1 *points, const u256 *scalars,
+                  size_t n);
+
+#ifndef __wasm__
+// the same, with the windows shared out over threads
+void bn254_g1_msm_threads(bn254_g1 *r, const bn254_g1 *points,
+                          const u256 *scalars, size_t n, int threads);
+#endif
+
+/*
+    The optimal ate pairing, for the ecPairing precompile 0x08, in
+    src/bn254_pairing.c.
+
+    G2 is the subgroup of order r of the sextic twist y^2 = x^3 + 3 / xi
+    over Fp2 = Fp[u] / (u^2 + 1), with xi = 9 + u. The pairing lands in the
+    tower
+
+        Fp6  = Fp2[v] / (v^3 - xi)
+        Fp12 = Fp6[w] / (w^2 - v)
+
+    whose coefficients are bn254_fp elements in Montgomery form, like G1's.
+*/
+typedef struct bn254_fp2 {
+    u256 c0;
+    u256 c1;
+} bn254_fp2;
+
+typedef struct bn254_fp6 {
+    bn254_fp2 c0;
+    bn254_fp2 c1;
+    bn254_fp2 c2;
+} bn254_fp6;
+
+typedef struct bn254_fp12 {
+    bn254_fp6 c0;
+    bn254_fp6 c1;
+} bn254_fp12;
+
+typedef struct bn254_g2 {
+    bn254_fp2 x;
+    bn254_fp2 y;
+    bool infinity;
+} bn254_g2;
+
+void bn254_fp12_one(bn254_fp12 *r);
+void bn254_fp12_mul(bn254_fp12 *r, const bn254_fp12 *a, const bn254_fp12 *b);
+bool bn254_fp12_eq(const bn254_fp12 *a, const bn254_fp12 *b);
+bool bn254_fp12_is_one(const bn254_fp12 *a);
+
+// infinity, or on the twist and of order r
+bool bn254_g2_valid(const bn254_g2 *a);
+
+// r = k a, for any 256 bit k
+void bn254_g2_mul(bn254_g2 *r, const bn254_g2 *a, const u256 k);
+
+// the EVM layout: x_im, x_re, y_im, y_re, fails like bn254_g1_from_bytes
+// and for points outside of G2
+bool bn254_g2_from_bytes(bn254_g2 *r, const uint8_t in[128]);
+
+/*
+    f = the product of the Miller loops of the n pairs (p[i], q[i]), which
+    share their squarings of f. Pairs with a point at infinity are skipped.
+    The points must be valid. Uses about 200 bytes of arena scratch per pair.
+*/
+void bn254_miller_loop(bn254_fp12 *f, const bn254_g1 *p, const bn254_g2 *q,
+                       size_t n);
+
+// r = f^((p^12 - 1) / r), with cyclotomic squarings in the hard part
+void bn254_final_exp(bn254_fp12 *r, const bn254_fp12 *f);
+
+// r = e(p, q)
+void bn254_pairing(bn254_fp12 *r, const bn254_g1 *p, const bn254_g2 *q);
+
+// whether e(p[0], q[0]) * ... * e(p[n-1], q[n-1]) = 1, with a single final
+// exponentiation
+bool bn254_pairing_check(const bn254_g1 *p, const bn254_g2 *q, size_t n);
+
+/*
+    The ecPairing precompile: len must be a multiple of 192 bytes, the pairs
+    G1 x, y and G2 x_im, x_re, y_im, y_re. out gets a word of 1 if the
+    product of the pairings is 1 and 0 otherwise, and no input gives 1.
+*/
+bool bn254_ec_pairing(uint8_t out[32], const uint8_t *in, size_t len);
+
+#endif // __BN254_H
@@ -0,0 +1,28 @@
+#ifndef __ENV_H
+#define __ENV_H
+
+#include <uint256.h>
+
+/*
+    The call environment, read from the host at most once per call.
+
+    Every getter calls its hostio the first time it's used and returns the
+    cached value afterwards, so library code can ask for the block number or
+    the call value inside a loop without crossing into the host each time.
+    Numeric values are kept as little endian u256s. ENTRYPOINT resets the
+    cache at the start of every call.
+*/
+
+void env_reset(void);
+
+void env_block_number(u256 res);
+void env_block_timestamp(u256 res);
+void env_chainid(u256 res);
+void env_block_basefee(u256 res);
+void env_tx_gas_price(u256 res);
+void env_msg_value(u256 res);
+
+// the sender's address, left padded to a 32 byte big endian word
+const uint8_t *env_msg_sender(void);
+
+#endif // __ENV_H
@@ -0,0 +1,364 @@
+#ifndef __FIELD_H
+#define __FIELD_H
+
+#include <uint256_core.h>
+
+/*
+    Arithmetic modulo a fixed 256 bit prime.
+
+    A field is declared with one of the macros at the end of this file, which
+    define static inline functions prefixed with its name:
+
+        FIELD_PSEUDO_MERSENNE(name, p0, p1, p2, p3, c)
+            p close to 2^256, with c = 2^256 mod p below 2^64. Products are
+            folded with hi * 2^256 = hi * c.
+        FIELD_SOLINAS_P256(name)
+            the NIST P-256 prime, reduced with additions of its 32 bit words
+        FIELD_MONTGOMERY(name, p0, p1, p2, p3, r0, r1, r2, r3)
+            any odd p, with elements kept as a * 2^256 mod p, and
+            r = 2^512 mod p
+
+    The limbs are little endian. The reduction is chosen by the macro, and
+    the moduli reach the kernels below as constants, so each field compiles
+    to its own specialized code. Every field gets the same functions:
+
+        name_from(r, a)     a < p into the field's representation
+        name_to(r, a)       back to a plain u256 below p
+        name_one(r)
+        name_add, name_sub, name_mul(r, a, b)
+        name_neg, name_sqr(r, a)
+        name_sqr_n(r, a, n) n >= 1 squarings
+        name_pow(r, a, e)   e a plain u256
+        name_is_zero(a), name_eq(a, b)
+
+    The fixed exponents, name_inv (inv(0) is 0), name_legendre and, for
+    p = 3 mod 4, name_sqrt, are addition chains generated for the fields of
+    fields.h into field_chains.h, see scripts/gen_chains.js. On top of
+    name_inv, FIELD_INV_BATCH(name) defines
+
+        name_inv_batch(r, a, n, prefix)
+                            r[i] = inv(a[i]) for n elements with one
+                            inversion, given n elements of scratch
+
+    Results may alias the operands. Elements are u256s in the usual limb
+    order, below p.
+*/
+
+/*
+    kernels, with the modulus as an argument
+*/
+// r = a + b mod p
+static inline void field_add(u256 r, const u256 a, const u256 b,
+                             const u256 p) {
+    u256 s, t;
+    u64 carry = 0, borrow = 0;
+    for (int i = 0; i < 4; i++) {
+        carry = add64(&s[i], a[i], b[i], carry);
+    }
+    for (int i = 0; i < 4; i++) {
+        borrow = sub64(&t[i], s[i], p[i], borrow);
+    }
+    // keep s only when it didn't overflow and is below p
+    u64 keep = -((carry ^ 1) & borrow);
+    for (int i = 0; i < 4; i++) {
+        r[i] = (s[i] & keep) | (t[i] & ~keep);
+    }
+}
+
+// r = a - b mod p
+static inline void field_sub(u256 r, const u256 a, const u256 b,
+                             const u256 p) {
+    u64 borrow = 0, carry = 0;
+    for (int i = 0; i < 4; i++) {
+        borrow = sub64(&r[i], a[i], b[i], borrow);
+    }
+    u64 mask = -borrow;
+    for (int i = 0; i < 4; i++) {
+        carry = add64(&r[i], r[i], p[i] & mask, carry);
+    }
+}
+
+// r = (hi * 2^256 + r) - p if that isn't negative, for hi <= 1
+static inline void field_sub_if_above(u256 r, u64 hi, const u256 p) {
+    u256 t;
+    u64 borrow = 0;
+    for (int i = 0; i < 4; i++) {
+        borrow = sub64(&t[i], r[i], p[i], borrow);
+    }
+    u64 keep = -((hi ^ 1) & borrow);
+    for (int i = 0; i < 4; i++) {
+        r[i] = (r[i] & keep) | (t[i] & ~keep);
+    }
+}
+
+/*
+    x mod p for p = 2^256 - c, or any p with 2^256 mod p = c < 2^64: fold
+    the high half in twice, then subtract p twice, which is enough when
+    2^256 < 3p.
+*/
+static inline void field_pm_reduce(u256 r, const u512 x, u64 c,
+                                   const u256 p) {
+    // t = lo + hi * c, five limbs
+    u256 t;
+    u64 hi = 0, carry = 0;
+    for (int i = 0; i < 4; i++) {
+        u64 h, l;
+        umul_hop(&h, &l, hi, x[4+i], c);
+        carry = add64(&t[i], x[i], l, carry);
+        hi = h;
+    }
+    hi += carry;
+
+    // fold the fifth limb, then the carry out of that
+    u64 h, l;
+    mul64(&h, &l, hi, c);
+    carry = add64(&t[0], t[0], l, 0);
+    carry = add64(&t[1], t[1], h, carry);
+    carry = add64(&t[2], t[2], 0, carry);
+    carry = add64(&t[3], t[3], 0, carry);
+    u64 fold = -carry & c;
+    carry = add64(&t[0], t[0], fold, 0);
+    carry = add64(&t[1], t[1], 0, carry);
+    carry = add64(&t[2], t[2], 0, carry);
+    add64(&t[3], t[3], 0, carry);
+
+    field_sub_if_above(t, 0, p);
+    field_sub_if_above(t, 0, p);
+    for (int i = 0; i < 4; i++) {
+        r[i] = t[i];
+    }
+}
+
+/*
+    x mod p for p = 2^256 - 2^224 + 2^192 + 2^96 - 1, from FIPS 186-4
+    appendix D.2.3: a sum of nine 256 bit words made of the 32 bit words of
+    x, accumulated with signed 64 bit columns.
+*/
+static inline void field_p256_reduce(u256 r, const u512 x) {
+    static const u256 p = {0xffffffffffffffffULL, 0x00000000ffffffffULL,
+                           0x0000000000000000ULL, 0xffffffff00000001ULL};
+    int64_t c[16];
+    for (int i = 0; i < 8; i++) {
+        c[2*i] = (int64_t)(x[i] & 0xffffffff);
+        c[2*i+1] = (int64_t)(x[i] >> 32);
+    }
+
+    // column j of s1 + 2 s2 + 2 s3 + s4 + s5 - d1 - d2 - d3 - d4
+    int64_t col[8];
+    col[0] = c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+    col[1] = c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+    col[2] = c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+    col[3] = c[3] + 2*c[11] + 2*c[12] + c[13] - c[15] - c[8] - c[9];
+    col[4] = c[4] + 2*c[12] + 2*c[13] + c[14] - c[9] - c[10];
+    col[5] = c[5] + 2*c[13] + 2*c[14] + c[15] - c[10] - c[11];
+    col[6] = c[6] + 3*c[14] + 2*c[15] + c[13] - c[8] - c[9];
+    col[7] = c[7] + 3*c[15] + c[8] - c[10] - c[11] - c[12] - c[13];
+
+    // carry the columns into 32 bit words and a small signed top word
+    int64_t carry = 0;
+    u64 w[8];
+    for (int j = 0; j < 8; j++) {
+        int64_t v = col[j] + carry;
+        w[j] = (u64)v & 0xffffffff;
+        carry = v >> 32;
+    }
+
+    // 2^256 = 2^224 - 2^192 - 2^96 + 1 mod p: fold the top word until
+    // it is zero, at most twice
+    while (carry != 0) {
+        int64_t k = carry;
+        int64_t fold[8] = {k, 0, 0, -k, 0, 0, -k, k};
+        carry = 0;
+        for (int j = 0; j < 8; j++) {
+            int64_t v = (int64_t)w[j] + fold[j] + carry;
+            w[j] = (u64)v & 0xffffffff;
+            carry = v >> 32;
+        }
+    }
+
+    u256 t;
+    for (int i = 0; i < 4; i++) {
+        t[i] = w[2*i] | (w[2*i+1] << 32);
+    }
+    field_sub_if_above(t, 0, p);
+    for (int i = 0; i < 4; i++) {
+        r[i] = t[i];
+    }
+}
+
+/*
+    Montgomery multiplication, r = a * b / 2^256 mod p, with the operand
+    scanning (CIOS) loop. n0 = -p^-1 mod 2^64.
+*/
+static inline void field_mont_mul(u256 r, const u256 a, const u256 b,
+                                  const u256 p, u64 n0) {
+    u64 t[6] = {0, 0, 0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        u64 carry = 0;
+        for (int j = 0; j < 4; j++) {
+            umul_step(&carry, &t[j], t[j], a[j], b[i], carry);
+        }
+        u64 c = add64(&t[4], t[4], carry, 0);
+        t[5] = c;
+
+        // add m * p, which clears the low limb, and shift down a limb
+        u64 m = t[0] * n0;
+        u64 lo;
+        umul_hop(&carry, &lo, t[0], m, p[0]);
+        for (int j = 1; j < 4; j++) {
+            umul_step(&carry, &t[j-1], t[j], m, p[j], carry);
+        }
+        c = add64(&t[3], t[4], carry, 0);
+        t[4] = t[5] + c;
+    }
+    for (int i = 0; i < 4; i++) {
+        r[i] = t[i];
+    }
+    field_sub_if_above(r, t[4], p);
+}
+
+// -p^-1 mod 2^64 as a constant expression, by Newton's iteration from p
+// itself, which is correct to 3 bits for odd p
+#define FIELD_INV_STEP(p, x) ((x) * (2 - (p) * (x)))
+#define FIELD_N0(p)                                                         \
+    (0 - FIELD_INV_STEP(p, FIELD_INV_STEP(p, FIELD_INV_STEP(p,              \
+         FIELD_INV_STEP(p, FIELD_INV_STEP(p, (u64)(p)))))))
+
+/*
+    functions shared by every kind of field, on top of name_mul, name_P and
+    name_one
+*/
+#define FIELD_COMMON(name)                                                  \
+    static inline void name##_add(u256 r, const u256 a, const u256 b) {     \
+        field_add(r, a, b, name##_P);                                       \
+    }                                                                       \
+    static inline void name##_sub(u256 r, const u256 a, const u256 b) {     \
+        field_sub(r, a, b, name##_P);                                       \
+    }                                                                       \
+    static inline void name##_neg(u256 r, const u256 a) {                   \
+        static const u256 zero = {0, 0, 0, 0};                              \
+        field_sub(r, zero, a, name##_P);                                    \
+    }                                                                       \
+    static inline void name##_sqr(u256 r, const u256 a) {                   \
+        name##_mul(r, a, a);                                                \
+    }                                                                       \
+    static inline void name##_sqr_n(u256 r, const u256 a, int n) {          \
+        name##_mul(r, a, a);                                                \
+        for (int i = 1; i < n; i++) {                                       \
+            name##_mul(r, r, r);                                            \
+        }                                                                   \
+    }                                                                       \
+    static inline bool name##_is_zero(const u256 a) {                       \
+        return (a[0] | a[1] | a[2] | a[3]) == 0;                            \
+    }                                                                       \
+    static inline bool name##_eq(const u256 a, const u256 b) {              \
+        return ((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2])               \
+              | (a[3] ^ b[3])) == 0;                                        \
+    }                                                                       \
+    static inline void name##_pow(u256 r, const u256 a, const u256 e) {     \
+        u256 acc, base;                                                     \
+        name##_one(acc);                                                    \
+        copy_words(base, (u64 *)a, 4);                                      \
+        for (int i = bit_len((u64 *)e) - 1; i >= 0; i--) {                  \
+            name##_sqr(acc, acc);                                           \
+            if ((e[i/64] >> (i%64)) & 1) {                                  \
+                name##_mul(acc, acc, base);                                 \
+            }                                                               \
+        }                                                                   \
+        copy_words(r, acc, 4);                                              \
+    }
+
+#define FIELD_PSEUDO_MERSENNE(name, p0, p1, p2, p3, c)                      \
+    static const u256 name##_P = {p0, p1, p2, p3};                          \
+    static inline void name##_mul(u256 r, const u256 a, const u256 b) {     \
+        u512 x;                                                             \
+        umul(x, a, b);                                                      \
+        field_pm_reduce(r, x, (c), name##_P);                               \
+    }                                                                       \
+    static inline void name##_from(u256 r, const u256 a) {                  \
+        copy_words(r, (u64 *)a, 4);                                         \
+    }                                                                       \
+    static inline void name##_to(u256 r, const u256 a) {                    \
+        copy_words(r, (u64 *)a, 4);                                         \
+    }                                                                       \
+    static inline void name##_one(u256 r) {                                 \
+        r[0] = 1; r[1] = 0; r[2] = 0; r[3] = 0;                             \
+    }                                                                       \
+    FIELD_COMMON(name)
+
+#define FIELD_SOLINAS_P256(name)                                            \
+    static const u256 name##_P = {0xffffffffffffffffULL,                    \
+                                  0x00000000ffffffffULL,                    \
+                                  0x0000000000000000ULL,                    \
+                                  0xffffffff00000001ULL};                   \
+    static inline void name##_mul(u256 r, const u256 a, const u256 b) {     \
+        u512 x;                                                             \
+        umul(x, a, b);                                                      \
+        field_p256_reduce(r, x);                                            \
+    }                                                                       \
+    static inline void name##_from(u256 r, const u256 a) {                  \
+        copy_words(r, (u64 *)a, 4);                                         \
+    }                                                                       \
+    static inline void name##_to(u256 r, const u256 a) {                    \
+        copy_words(r, (u64 *)a, 4);                                         \
+    }                                                                       \
+    static inline void name##_one(u256 r) {                                 \
+        r[0] = 1; r[1] = 0; r[2] = 0; r[3] = 0;                             \
+    }                                                                       \
+    FIELD_COMMON(name)
+
+#define FIELD_MONTGOMERY(name, p0, p1, p2, p3, r0, r1, r2, r3)              \
+    _Static_assert((u64)(p0) * FIELD_N0(p0) == MAX_U64,                     \
+                   #name " needs an odd modulus");                          \
+    static const u256 name##_P = {p0, p1, p2, p3};                          \
+    static const u256 name##_R2 = {r0, r1, r2, r3};                         \
+    static inline void name##_mul(u256 r, const u256 a, const u256 b) {     \
+        field_mont_mul(r, a, b, name##_P, FIELD_N0(p0));                    \
+    }                                                                       \
+    static inline void name##_from(u256 r, const u256 a) {                  \
+        name##_mul(r, a, name##_R2);                                        \
+    }                                                                       \
+    static inline void name##_to(u256 r, const u256 a) {                    \
+        static const u256 one = {1, 0, 0, 0};                               \
+        name##_mul(r, a, one);                                              \
+    }                                                                       \
+    static inline void name##_one(u256 r) {                                 \
+        static const u256 one = {1, 0, 0, 0};                               \
+        name##_from(r, one);                                                \
+    }                                                                       \
+    FIELD_COMMON(name)
+
+/*
+    Montgomery's trick: prefix[i] is the product of the nonzero a's up to i,
+    inverted once and unwound from the end, so n inversions cost one and
+    about three multiplications each. Zeros are left out of the product and their
+    inverse is 0, like name_inv. r may alias a.
+*/
+#define FIELD_INV_BATCH(name)                                               \
+    static inline void name##_inv_batch(u256 *r, const u256 *a, size_t n,   \
+                                        u256 *prefix) {                     \
+        u256 acc, t;                                                        \
+        name##_one(acc);                                                    \
+        for (size_t i = 0; i < n; i++) {                                    \
+            if (!name##_is_zero(a[i])) {                                    \
+                name##_mul(acc, acc, a[i]);                                 \
+            }                                                               \
+            copy_words(prefix[i], acc, 4);                                  \
+        }                                                                   \
+        name##_inv(acc, acc);                                               \
+        for (size_t i = n; i-- > 0;) {                                      \
+            if (name##_is_zero(a[i])) {                                     \
+                clear_words(r[i], 4);                                       \
+                continue;                                                   \
+            }                                                               \
+            if (i > 0) {                                                    \
+                name##_mul(t, acc, prefix[i-1]);                            \
+            } else {                                                        \
+                copy_words(t, acc, 4);                                      \
+            }                                                               \
+            name##_mul(acc, acc, a[i]);                                     \
+            copy_words(r[i], t, 4);                                         \
+        }                                                                   \
+    }
+
+#endif // __FIELD_H
@@ -0,0 +1,1278 @@
+// Generated by scripts/gen_chains.js from include/fields.h, do not edit.
+#ifndef __FIELD_CHAINS_H
+#define __FIELD_CHAINS_H
+
+/*
+    secp256k1_fp
+*/
+
+// a^(p-2): 255 squarings and 16 multiplications, square and multiply takes 503 in all
+static inline void secp256k1_fp_inv(u256 r, const u256 a) {
+    u256 x2, x4, x8, x16, x20, x22, x44, x88, x176, x220, x222, x223, t;
+    secp256k1_fp_sqr(x2, a);
+    secp256k1_fp_mul(x2, x2, a);
+    secp256k1_fp_sqr_n(x4, x2, 2);
+    secp256k1_fp_mul(x4, x4, x2);
+    secp256k1_fp_sqr_n(x8, x4, 4);
+    secp256k1_fp_mul(x8, x8, x4);
+    secp256k1_fp_sqr_n(x16, x8, 8);
+    secp256k1_fp_mul(x16, x16, x8);
+    secp256k1_fp_sqr_n(x20, x16, 4);
+    secp256k1_fp_mul(x20, x20, x4);
+    secp256k1_fp_sqr_n(x22, x20, 2);
+    secp256k1_fp_mul(x22, x22, x2);
+    secp256k1_fp_sqr_n(x44, x22, 22);
+    secp256k1_fp_mul(x44, x44, x22);
+    secp256k1_fp_sqr_n(x88, x44, 44);
+    secp256k1_fp_mul(x88, x88, x44);
+    secp256k1_fp_sqr_n(x176, x88, 88);
+    secp256k1_fp_mul(x176, x176, x88);
+    secp256k1_fp_sqr_n(x220, x176, 44);
+    secp256k1_fp_mul(x220, x220, x44);
+    secp256k1_fp_sqr_n(x222, x220, 2);
+    secp256k1_fp_mul(x222, x222, x2);
+    secp256k1_fp_sqr(x223, x222);
+    secp256k1_fp_mul(x223, x223, a);
+    secp256k1_fp_sqr_n(t, x223, 23);
+    secp256k1_fp_mul(t, t, x22);
+    secp256k1_fp_sqr_n(t, t, 5);
+    secp256k1_fp_mul(t, t, a);
+    secp256k1_fp_sqr_n(t, t, 3);
+    secp256k1_fp_mul(t, t, x2);
+    secp256k1_fp_sqr_n(t, t, 2);
+    secp256k1_fp_mul(t, t, a);
+    copy_words(r, t, 4);
+}
+
+// a^((p-1)/2): 254 squarings and 15 multiplications, square and multiply takes 502 in all
+static inline int secp256k1_fp_legendre(const u256 a) {
+    u256 x2, x3, x6, x12, x18, x21, x22, x44, x88, x176, x220, x223, t;
+    secp256k1_fp_sqr(x2, a);
+    secp256k1_fp_mul(x2, x2, a);
+    secp256k1_fp_sqr(x3, x2);
+    secp256k1_fp_mul(x3, x3, a);
+    secp256k1_fp_sqr_n(x6, x3, 3);
+    secp256k1_fp_mul(x6, x6, x3);
+    secp256k1_fp_sqr_n(x12, x6, 6);
+    secp256k1_fp_mul(x12, x12, x6);
+    secp256k1_fp_sqr_n(x18, x12, 6);
+    secp256k1_fp_mul(x18, x18, x6);
+    secp256k1_fp_sqr_n(x21, x18, 3);
+    secp256k1_fp_mul(x21, x21, x3);
+    secp256k1_fp_sqr(x22, x21);
+    secp256k1_fp_mul(x22, x22, a);
+    secp256k1_fp_sqr_n(x44, x22, 22);
+    secp256k1_fp_mul(x44, x44, x22);
+    secp256k1_fp_sqr_n(x88, x44, 44);
+    secp256k1_fp_mul(x88, x88, x44);
+    secp256k1_fp_sqr_n(x176, x88, 88);
+    secp256k1_fp_mul(x176, x176, x88);
+    secp256k1_fp_sqr_n(x220, x176, 44);
+    secp256k1_fp_mul(x220, x220, x44);
+    secp256k1_fp_sqr_n(x223, x220, 3);
+    secp256k1_fp_mul(x223, x223, x3);
+    secp256k1_fp_sqr_n(t, x223, 23);
+    secp256k1_fp_mul(t, t, x22);
+    secp256k1_fp_sqr_n(t, t, 5);
+    secp256k1_fp_mul(t, t, a);
+    secp256k1_fp_sqr_n(t, t, 4);
+    secp256k1_fp_mul(t, t, x3);
+    u256 one;
+    secp256k1_fp_one(one);
+    return secp256k1_fp_is_zero(t) ? 0 : secp256k1_fp_eq(t, one) ? 1 : -1;
+}
+
+// a^((p+1)/4): 253 squarings and 14 multiplications, square and multiply takes 499 in all
+static inline void secp256k1_fp_sqrt(u256 r, const u256 a) {
+    u256 x2, x4, x8, x16, x20, x22, x44, x88, x176, x220, x222, x223, t;
+    secp256k1_fp_sqr(x2, a);
+    secp256k1_fp_mul(x2, x2, a);
+    secp256k1_fp_sqr_n(x4, x2, 2);
+    secp256k1_fp_mul(x4, x4, x2);
+    secp256k1_fp_sqr_n(x8, x4, 4);
+    secp256k1_fp_mul(x8, x8, x4);
+    secp256k1_fp_sqr_n(x16, x8, 8);
+    secp256k1_fp_mul(x16, x16, x8);
+    secp256k1_fp_sqr_n(x20, x16, 4);
+    secp256k1_fp_mul(x20, x20, x4);
+    secp256k1_fp_sqr_n(x22, x20, 2);
+    secp256k1_fp_mul(x22, x22, x2);
+    secp256k1_fp_sqr_n(x44, x22, 22);
+    secp256k1_fp_mul(x44, x44, x22);
+    secp256k1_fp_sqr_n(x88, x44, 44);
+    secp256k1_fp_mul(x88, x88, x44);
+    secp256k1_fp_sqr_n(x176, x88, 88);
+    secp256k1_fp_mul(x176, x176, x88);
+    secp256k1_fp_sqr_n(x220, x176, 44);
+    secp256k1_fp_mul(x220, x220, x44);
+    secp256k1_fp_sqr_n(x222, x220, 2);
+    secp256k1_fp_mul(x222, x222, x2);
+    secp256k1_fp_sqr(x223, x222);
+    secp256k1_fp_mul(x223, x223, a);
+    secp256k1_fp_sqr_n(t, x223, 23);
+    secp256k1_fp_mul(t, t, x22);
+    secp256k1_fp_sqr_n(t, t, 6);
+    secp256k1_fp_mul(t, t, x2);
+    secp256k1_fp_sqr_n(t, t, 2);
+    copy_words(r, t, 4);
+}
+
+/*
+    secp256k1_fn
+*/
+
+// a^(p-2): 254 squarings and 40 multiplications, square and multiply takes 450 in all
+static inline void secp256k1_fn_inv(u256 r, const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x5, x8, x16, x32, x64, x96, x112, x120, x125, x127, t;
+    secp256k1_fn_sqr(a2, a);
+    secp256k1_fn_mul(x2, a, a2);
+    secp256k1_fn_mul(o5, x2, a2);
+    secp256k1_fn_mul(x3, o5, a2);
+    secp256k1_fn_mul(o9, x3, a2);
+    secp256k1_fn_mul(o11, o9, a2);
+    secp256k1_fn_mul(o13, o11, a2);
+    secp256k1_fn_sqr_n(x5, x3, 2);
+    secp256k1_fn_mul(x5, x5, x2);
+    secp256k1_fn_sqr_n(x8, x5, 3);
+    secp256k1_fn_mul(x8, x8, x3);
+    secp256k1_fn_sqr_n(x16, x8, 8);
+    secp256k1_fn_mul(x16, x16, x8);
+    secp256k1_fn_sqr_n(x32, x16, 16);
+    secp256k1_fn_mul(x32, x32, x16);
+    secp256k1_fn_sqr_n(x64, x32, 32);
+    secp256k1_fn_mul(x64, x64, x32);
+    secp256k1_fn_sqr_n(x96, x64, 32);
+    secp256k1_fn_mul(x96, x96, x32);
+    secp256k1_fn_sqr_n(x112, x96, 16);
+    secp256k1_fn_mul(x112, x112, x16);
+    secp256k1_fn_sqr_n(x120, x112, 8);
+    secp256k1_fn_mul(x120, x120, x8);
+    secp256k1_fn_sqr_n(x125, x120, 5);
+    secp256k1_fn_mul(x125, x125, x5);
+    secp256k1_fn_sqr_n(x127, x125, 2);
+    secp256k1_fn_mul(x127, x127, x2);
+    secp256k1_fn_sqr_n(t, x127, 5);
+    secp256k1_fn_mul(t, t, o11);
+    secp256k1_fn_sqr_n(t, t, 3);
+    secp256k1_fn_mul(t, t, o5);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, o5);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, x3);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 2);
+    secp256k1_fn_mul(t, t, x2);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, x3);
+    secp256k1_fn_sqr_n(t, t, 6);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, o11);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 3);
+    secp256k1_fn_mul(t, t, a);
+    secp256k1_fn_sqr_n(t, t, 6);
+    secp256k1_fn_mul(t, t, o5);
+    secp256k1_fn_sqr_n(t, t, 10);
+    secp256k1_fn_mul(t, t, x3);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, x3);
+    secp256k1_fn_sqr_n(t, t, 9);
+    secp256k1_fn_mul(t, t, x8);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, o9);
+    secp256k1_fn_sqr_n(t, t, 6);
+    secp256k1_fn_mul(t, t, o11);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, x2);
+    secp256k1_fn_sqr_n(t, t, 6);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 10);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, o9);
+    secp256k1_fn_sqr_n(t, t, 9);
+    secp256k1_fn_mul(t, t, o9);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, x5);
+    copy_words(r, t, 4);
+}
+
+// a^((p-1)/2): 253 squarings and 39 multiplications, square and multiply takes 444 in all
+static inline int secp256k1_fn_legendre(const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x6, x8, x16, x32, x64, x96, x112, x120, x126, x127, t;
+    secp256k1_fn_sqr(a2, a);
+    secp256k1_fn_mul(x2, a, a2);
+    secp256k1_fn_mul(o5, x2, a2);
+    secp256k1_fn_mul(x3, o5, a2);
+    secp256k1_fn_mul(o9, x3, a2);
+    secp256k1_fn_mul(o11, o9, a2);
+    secp256k1_fn_mul(o13, o11, a2);
+    secp256k1_fn_sqr_n(x6, x3, 3);
+    secp256k1_fn_mul(x6, x6, x3);
+    secp256k1_fn_sqr_n(x8, x6, 2);
+    secp256k1_fn_mul(x8, x8, x2);
+    secp256k1_fn_sqr_n(x16, x8, 8);
+    secp256k1_fn_mul(x16, x16, x8);
+    secp256k1_fn_sqr_n(x32, x16, 16);
+    secp256k1_fn_mul(x32, x32, x16);
+    secp256k1_fn_sqr_n(x64, x32, 32);
+    secp256k1_fn_mul(x64, x64, x32);
+    secp256k1_fn_sqr_n(x96, x64, 32);
+    secp256k1_fn_mul(x96, x96, x32);
+    secp256k1_fn_sqr_n(x112, x96, 16);
+    secp256k1_fn_mul(x112, x112, x16);
+    secp256k1_fn_sqr_n(x120, x112, 8);
+    secp256k1_fn_mul(x120, x120, x8);
+    secp256k1_fn_sqr_n(x126, x120, 6);
+    secp256k1_fn_mul(x126, x126, x6);
+    secp256k1_fn_sqr(x127, x126);
+    secp256k1_fn_mul(x127, x127, a);
+    secp256k1_fn_sqr_n(t, x127, 5);
+    secp256k1_fn_mul(t, t, o11);
+    secp256k1_fn_sqr_n(t, t, 3);
+    secp256k1_fn_mul(t, t, o5);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, o5);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, x3);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 2);
+    secp256k1_fn_mul(t, t, x2);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, x3);
+    secp256k1_fn_sqr_n(t, t, 6);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, o11);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 3);
+    secp256k1_fn_mul(t, t, a);
+    secp256k1_fn_sqr_n(t, t, 6);
+    secp256k1_fn_mul(t, t, o5);
+    secp256k1_fn_sqr_n(t, t, 10);
+    secp256k1_fn_mul(t, t, x3);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, x3);
+    secp256k1_fn_sqr_n(t, t, 9);
+    secp256k1_fn_mul(t, t, x8);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, o9);
+    secp256k1_fn_sqr_n(t, t, 6);
+    secp256k1_fn_mul(t, t, o11);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 5);
+    secp256k1_fn_mul(t, t, x2);
+    secp256k1_fn_sqr_n(t, t, 6);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 10);
+    secp256k1_fn_mul(t, t, o13);
+    secp256k1_fn_sqr_n(t, t, 4);
+    secp256k1_fn_mul(t, t, o9);
+    secp256k1_fn_sqr_n(t, t, 8);
+    secp256k1_fn_mul(t, t, o5);
+    secp256k1_fn_sqr_n(t, t, 5);
+    u256 one;
+    secp256k1_fn_one(one);
+    return secp256k1_fn_is_zero(t) ? 0 : secp256k1_fn_eq(t, one) ? 1 : -1;
+}
+
+/*
+    bn254_fp
+*/
+
+// a^(p-2): 253 squarings and 53 multiplications, square and multiply takes 362 in all
+static inline void bn254_fp_inv(u256 r, const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x4, o17, o19, o21, o23, o25, o27, o29, x5, t;
+    bn254_fp_sqr(a2, a);
+    bn254_fp_mul(x2, a, a2);
+    bn254_fp_mul(o5, x2, a2);
+    bn254_fp_mul(x3, o5, a2);
+    bn254_fp_mul(o9, x3, a2);
+    bn254_fp_mul(o11, o9, a2);
+    bn254_fp_mul(o13, o11, a2);
+    bn254_fp_mul(x4, o13, a2);
+    bn254_fp_mul(o17, x4, a2);
+    bn254_fp_mul(o19, o17, a2);
+    bn254_fp_mul(o21, o19, a2);
+    bn254_fp_mul(o23, o21, a2);
+    bn254_fp_mul(o25, o23, a2);
+    bn254_fp_mul(o27, o25, a2);
+    bn254_fp_mul(o29, o27, a2);
+    bn254_fp_mul(x5, o29, a2);
+    bn254_fp_sqr_n(t, x2, 10);
+    bn254_fp_mul(t, t, o25);
+    bn254_fp_sqr_n(t, t, 8);
+    bn254_fp_mul(t, t, o19);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o19);
+    bn254_fp_sqr_n(t, t, 4);
+    bn254_fp_mul(t, t, o9);
+    bn254_fp_sqr_n(t, t, 4);
+    bn254_fp_mul(t, t, x3);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, o19);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o5);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o27);
+    bn254_fp_sqr(t, t);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o5);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o17);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o27);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 8);
+    bn254_fp_mul(t, t, x2);
+    bn254_fp_sqr_n(t, t, 11);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr(t, t);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, o23);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o25);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, x4);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o11);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o17);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, x3);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, x3);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, x4);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o17);
+    bn254_fp_sqr(t, t);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, o11);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o27);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, x5);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, x5);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o5);
+    copy_words(r, t, 4);
+}
+
+// a^((p-1)/2): 252 squarings and 53 multiplications, square and multiply takes 361 in all
+static inline int bn254_fp_legendre(const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x4, o17, o19, o21, o23, o25, o27, o29, x5, t;
+    bn254_fp_sqr(a2, a);
+    bn254_fp_mul(x2, a, a2);
+    bn254_fp_mul(o5, x2, a2);
+    bn254_fp_mul(x3, o5, a2);
+    bn254_fp_mul(o9, x3, a2);
+    bn254_fp_mul(o11, o9, a2);
+    bn254_fp_mul(o13, o11, a2);
+    bn254_fp_mul(x4, o13, a2);
+    bn254_fp_mul(o17, x4, a2);
+    bn254_fp_mul(o19, o17, a2);
+    bn254_fp_mul(o21, o19, a2);
+    bn254_fp_mul(o23, o21, a2);
+    bn254_fp_mul(o25, o23, a2);
+    bn254_fp_mul(o27, o25, a2);
+    bn254_fp_mul(o29, o27, a2);
+    bn254_fp_mul(x5, o29, a2);
+    bn254_fp_sqr_n(t, x2, 10);
+    bn254_fp_mul(t, t, o25);
+    bn254_fp_sqr_n(t, t, 8);
+    bn254_fp_mul(t, t, o19);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o19);
+    bn254_fp_sqr_n(t, t, 4);
+    bn254_fp_mul(t, t, o9);
+    bn254_fp_sqr_n(t, t, 4);
+    bn254_fp_mul(t, t, x3);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, o19);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o5);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o27);
+    bn254_fp_sqr(t, t);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o5);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o17);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o27);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 8);
+    bn254_fp_mul(t, t, x2);
+    bn254_fp_sqr_n(t, t, 11);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr(t, t);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, o23);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o25);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, x4);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o11);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o17);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, x3);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, x3);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, x4);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o17);
+    bn254_fp_sqr(t, t);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, o11);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o27);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, x5);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, x5);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, x2);
+    u256 one;
+    bn254_fp_one(one);
+    return bn254_fp_is_zero(t) ? 0 : bn254_fp_eq(t, one) ? 1 : -1;
+}
+
+// a^((p+1)/4): 251 squarings and 53 multiplications, square and multiply takes 359 in all
+static inline void bn254_fp_sqrt(u256 r, const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x4, o17, o19, o21, o23, o25, o27, o29, x5, t;
+    bn254_fp_sqr(a2, a);
+    bn254_fp_mul(x2, a, a2);
+    bn254_fp_mul(o5, x2, a2);
+    bn254_fp_mul(x3, o5, a2);
+    bn254_fp_mul(o9, x3, a2);
+    bn254_fp_mul(o11, o9, a2);
+    bn254_fp_mul(o13, o11, a2);
+    bn254_fp_mul(x4, o13, a2);
+    bn254_fp_mul(o17, x4, a2);
+    bn254_fp_mul(o19, o17, a2);
+    bn254_fp_mul(o21, o19, a2);
+    bn254_fp_mul(o23, o21, a2);
+    bn254_fp_mul(o25, o23, a2);
+    bn254_fp_mul(o27, o25, a2);
+    bn254_fp_mul(o29, o27, a2);
+    bn254_fp_mul(x5, o29, a2);
+    bn254_fp_sqr_n(t, x2, 10);
+    bn254_fp_mul(t, t, o25);
+    bn254_fp_sqr_n(t, t, 8);
+    bn254_fp_mul(t, t, o19);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o19);
+    bn254_fp_sqr_n(t, t, 4);
+    bn254_fp_mul(t, t, o9);
+    bn254_fp_sqr_n(t, t, 4);
+    bn254_fp_mul(t, t, x3);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, o19);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o5);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o27);
+    bn254_fp_sqr(t, t);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o5);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o17);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o27);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 8);
+    bn254_fp_mul(t, t, x2);
+    bn254_fp_sqr_n(t, t, 11);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr(t, t);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, o23);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o25);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, x4);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o11);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o17);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, x3);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, x3);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, o13);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, x4);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 10);
+    bn254_fp_mul(t, t, o17);
+    bn254_fp_sqr(t, t);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, o11);
+    bn254_fp_sqr_n(t, t, 6);
+    bn254_fp_mul(t, t, o27);
+    bn254_fp_sqr_n(t, t, 9);
+    bn254_fp_mul(t, t, x5);
+    bn254_fp_sqr_n(t, t, 7);
+    bn254_fp_mul(t, t, x5);
+    bn254_fp_sqr_n(t, t, 5);
+    bn254_fp_mul(t, t, o21);
+    bn254_fp_sqr_n(t, t, 3);
+    bn254_fp_mul(t, t, a);
+    bn254_fp_sqr(t, t);
+    copy_words(r, t, 4);
+}
+
+/*
+    bn254_fr
+*/
+
+// a^(p-2): 253 squarings and 56 multiplications, square and multiply takes 379 in all
+static inline void bn254_fr_inv(u256 r, const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x4, t;
+    bn254_fr_sqr(a2, a);
+    bn254_fr_mul(x2, a, a2);
+    bn254_fr_mul(o5, x2, a2);
+    bn254_fr_mul(x3, o5, a2);
+    bn254_fr_mul(o9, x3, a2);
+    bn254_fr_mul(o11, o9, a2);
+    bn254_fr_mul(o13, o11, a2);
+    bn254_fr_mul(x4, o13, a2);
+    bn254_fr_sqr_n(t, x2, 7);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr_n(t, t, 2);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 5);
+    bn254_fr_mul(t, t, x3);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o11);
+    bn254_fr_sqr(t, t);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr(t, t);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, o13);
+    bn254_fr_sqr_n(t, t, 10);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o13);
+    bn254_fr_sqr_n(t, t, 2);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, o11);
+    bn254_fr_sqr_n(t, t, 5);
+    bn254_fr_mul(t, t, o13);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 9);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, o11);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 5);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o13);
+    bn254_fr_sqr_n(t, t, 2);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o11);
+    bn254_fr_sqr(t, t);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr(t, t);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr_n(t, t, 4);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 5);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 4);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 4);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 4);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 4);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 4);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 4);
+    bn254_fr_mul(t, t, x4);
+    copy_words(r, t, 4);
+}
+
+// a^((p-1)/2): 253 squarings and 48 multiplications, square and multiply takes 351 in all
+static inline int bn254_fr_legendre(const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x4, x5, t;
+    bn254_fr_sqr(a2, a);
+    bn254_fr_mul(x2, a, a2);
+    bn254_fr_mul(o5, x2, a2);
+    bn254_fr_mul(x3, o5, a2);
+    bn254_fr_mul(o9, x3, a2);
+    bn254_fr_mul(o11, o9, a2);
+    bn254_fr_mul(o13, o11, a2);
+    bn254_fr_mul(x4, o13, a2);
+    bn254_fr_sqr(x5, x4);
+    bn254_fr_mul(x5, x5, a);
+    bn254_fr_sqr_n(t, x2, 7);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr_n(t, t, 2);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 5);
+    bn254_fr_mul(t, t, x3);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o11);
+    bn254_fr_sqr(t, t);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr(t, t);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, o13);
+    bn254_fr_sqr_n(t, t, 10);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o13);
+    bn254_fr_sqr_n(t, t, 2);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, o11);
+    bn254_fr_sqr_n(t, t, 5);
+    bn254_fr_mul(t, t, o13);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 9);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, o11);
+    bn254_fr_sqr_n(t, t, 3);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 5);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 7);
+    bn254_fr_mul(t, t, x5);
+    bn254_fr_sqr_n(t, t, 2);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, x4);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o13);
+    bn254_fr_sqr_n(t, t, 2);
+    bn254_fr_mul(t, t, x2);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o11);
+    bn254_fr_sqr(t, t);
+    bn254_fr_mul(t, t, a);
+    bn254_fr_sqr_n(t, t, 8);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o5);
+    bn254_fr_sqr_n(t, t, 9);
+    bn254_fr_mul(t, t, x5);
+    bn254_fr_sqr_n(t, t, 9);
+    bn254_fr_mul(t, t, x5);
+    bn254_fr_sqr_n(t, t, 5);
+    bn254_fr_mul(t, t, o11);
+    bn254_fr_sqr_n(t, t, 6);
+    bn254_fr_mul(t, t, o9);
+    bn254_fr_sqr_n(t, t, 5);
+    bn254_fr_mul(t, t, x5);
+    bn254_fr_sqr_n(t, t, 27);
+    u256 one;
+    bn254_fr_one(one);
+    return bn254_fr_is_zero(t) ? 0 : bn254_fr_eq(t, one) ? 1 : -1;
+}
+
+/*
+    f25519
+*/
+
+// a^(p-2): 254 squarings and 14 multiplications, square and multiply takes 506 in all
+static inline void f25519_inv(u256 r, const u256 a) {
+    u256 x2, x4, x8, x16, x32, x64, x128, x192, x224, x240, x248, x250, t;
+    f25519_sqr(x2, a);
+    f25519_mul(x2, x2, a);
+    f25519_sqr_n(x4, x2, 2);
+    f25519_mul(x4, x4, x2);
+    f25519_sqr_n(x8, x4, 4);
+    f25519_mul(x8, x8, x4);
+    f25519_sqr_n(x16, x8, 8);
+    f25519_mul(x16, x16, x8);
+    f25519_sqr_n(x32, x16, 16);
+    f25519_mul(x32, x32, x16);
+    f25519_sqr_n(x64, x32, 32);
+    f25519_mul(x64, x64, x32);
+    f25519_sqr_n(x128, x64, 64);
+    f25519_mul(x128, x128, x64);
+    f25519_sqr_n(x192, x128, 64);
+    f25519_mul(x192, x192, x64);
+    f25519_sqr_n(x224, x192, 32);
+    f25519_mul(x224, x224, x32);
+    f25519_sqr_n(x240, x224, 16);
+    f25519_mul(x240, x240, x16);
+    f25519_sqr_n(x248, x240, 8);
+    f25519_mul(x248, x248, x8);
+    f25519_sqr_n(x250, x248, 2);
+    f25519_mul(x250, x250, x2);
+    f25519_sqr_n(t, x250, 2);
+    f25519_mul(t, t, a);
+    f25519_sqr_n(t, t, 3);
+    f25519_mul(t, t, x2);
+    copy_words(r, t, 4);
+}
+
+// a^((p-1)/2): 253 squarings and 13 multiplications, square and multiply takes 504 in all
+static inline int f25519_legendre(const u256 a) {
+    u256 x2, x4, x8, x16, x32, x64, x128, x192, x224, x240, x248, x250, t;
+    f25519_sqr(x2, a);
+    f25519_mul(x2, x2, a);
+    f25519_sqr_n(x4, x2, 2);
+    f25519_mul(x4, x4, x2);
+    f25519_sqr_n(x8, x4, 4);
+    f25519_mul(x8, x8, x4);
+    f25519_sqr_n(x16, x8, 8);
+    f25519_mul(x16, x16, x8);
+    f25519_sqr_n(x32, x16, 16);
+    f25519_mul(x32, x32, x16);
+    f25519_sqr_n(x64, x32, 32);
+    f25519_mul(x64, x64, x32);
+    f25519_sqr_n(x128, x64, 64);
+    f25519_mul(x128, x128, x64);
+    f25519_sqr_n(x192, x128, 64);
+    f25519_mul(x192, x192, x64);
+    f25519_sqr_n(x224, x192, 32);
+    f25519_mul(x224, x224, x32);
+    f25519_sqr_n(x240, x224, 16);
+    f25519_mul(x240, x240, x16);
+    f25519_sqr_n(x248, x240, 8);
+    f25519_mul(x248, x248, x8);
+    f25519_sqr_n(x250, x248, 2);
+    f25519_mul(x250, x250, x2);
+    f25519_sqr_n(t, x250, 3);
+    f25519_mul(t, t, x2);
+    f25519_sqr(t, t);
+    u256 one;
+    f25519_one(one);
+    return f25519_is_zero(t) ? 0 : f25519_eq(t, one) ? 1 : -1;
+}
+
+/*
+    p256_fp
+*/
+
+// a^(p-2): 253 squarings and 39 multiplications, square and multiply takes 382 in all
+static inline void p256_fp_inv(u256 r, const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x4, t;
+    p256_fp_sqr(a2, a);
+    p256_fp_mul(x2, a, a2);
+    p256_fp_mul(o5, x2, a2);
+    p256_fp_mul(x3, o5, a2);
+    p256_fp_mul(o9, x3, a2);
+    p256_fp_mul(o11, o9, a2);
+    p256_fp_mul(o13, o11, a2);
+    p256_fp_mul(x4, o13, a2);
+    p256_fp_sqr_n(t, x4, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 32);
+    p256_fp_mul(t, t, a);
+    p256_fp_sqr_n(t, t, 100);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, o13);
+    copy_words(r, t, 4);
+}
+
+// a^((p-1)/2): 252 squarings and 39 multiplications, square and multiply takes 381 in all
+static inline int p256_fp_legendre(const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x4, t;
+    p256_fp_sqr(a2, a);
+    p256_fp_mul(x2, a, a2);
+    p256_fp_mul(o5, x2, a2);
+    p256_fp_mul(x3, o5, a2);
+    p256_fp_mul(o9, x3, a2);
+    p256_fp_mul(o11, o9, a2);
+    p256_fp_mul(o13, o11, a2);
+    p256_fp_mul(x4, o13, a2);
+    p256_fp_sqr_n(t, x4, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 32);
+    p256_fp_mul(t, t, a);
+    p256_fp_sqr_n(t, t, 100);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 4);
+    p256_fp_mul(t, t, x4);
+    p256_fp_sqr_n(t, t, 3);
+    p256_fp_mul(t, t, x3);
+    u256 one;
+    p256_fp_one(one);
+    return p256_fp_is_zero(t) ? 0 : p256_fp_eq(t, one) ? 1 : -1;
+}
+
+// a^((p+1)/4): 253 squarings and 7 multiplications, square and multiply takes 286 in all
+static inline void p256_fp_sqrt(u256 r, const u256 a) {
+    u256 x2, x4, x8, x16, x32, t;
+    p256_fp_sqr(x2, a);
+    p256_fp_mul(x2, x2, a);
+    p256_fp_sqr_n(x4, x2, 2);
+    p256_fp_mul(x4, x4, x2);
+    p256_fp_sqr_n(x8, x4, 4);
+    p256_fp_mul(x8, x8, x4);
+    p256_fp_sqr_n(x16, x8, 8);
+    p256_fp_mul(x16, x16, x8);
+    p256_fp_sqr_n(x32, x16, 16);
+    p256_fp_mul(x32, x32, x16);
+    p256_fp_sqr_n(t, x32, 32);
+    p256_fp_mul(t, t, a);
+    p256_fp_sqr_n(t, t, 96);
+    p256_fp_mul(t, t, a);
+    p256_fp_sqr_n(t, t, 94);
+    copy_words(r, t, 4);
+}
+
+/*
+    p256_fn
+*/
+
+// a^(p-2): 252 squarings and 57 multiplications, square and multiply takes 423 in all
+static inline void p256_fn_inv(u256 r, const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x4, o17, o19, o21, o23, o25, o27, o29, x5, t;
+    p256_fn_sqr(a2, a);
+    p256_fn_mul(x2, a, a2);
+    p256_fn_mul(o5, x2, a2);
+    p256_fn_mul(x3, o5, a2);
+    p256_fn_mul(o9, x3, a2);
+    p256_fn_mul(o11, o9, a2);
+    p256_fn_mul(o13, o11, a2);
+    p256_fn_mul(x4, o13, a2);
+    p256_fn_mul(o17, x4, a2);
+    p256_fn_mul(o19, o17, a2);
+    p256_fn_mul(o21, o19, a2);
+    p256_fn_mul(o23, o21, a2);
+    p256_fn_mul(o25, o23, a2);
+    p256_fn_mul(o27, o25, a2);
+    p256_fn_mul(o29, o27, a2);
+    p256_fn_mul(x5, o29, a2);
+    p256_fn_sqr_n(t, x5, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 2);
+    p256_fn_mul(t, t, x2);
+    p256_fn_sqr_n(t, t, 37);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x4);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x3);
+    p256_fn_sqr_n(t, t, 7);
+    p256_fn_mul(t, t, o27);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o29);
+    p256_fn_sqr_n(t, t, 6);
+    p256_fn_mul(t, t, o21);
+    p256_fn_sqr_n(t, t, 4);
+    p256_fn_mul(t, t, o11);
+    p256_fn_sqr_n(t, t, 6);
+    p256_fn_mul(t, t, o19);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o17);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x4);
+    p256_fn_sqr_n(t, t, 6);
+    p256_fn_mul(t, t, x4);
+    p256_fn_sqr_n(t, t, 2);
+    p256_fn_mul(t, t, a);
+    p256_fn_sqr_n(t, t, 9);
+    p256_fn_mul(t, t, o19);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o25);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o27);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o19);
+    p256_fn_sqr_n(t, t, 4);
+    p256_fn_mul(t, t, o9);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o11);
+    p256_fn_sqr_n(t, t, 9);
+    p256_fn_mul(t, t, o23);
+    p256_fn_sqr_n(t, t, 3);
+    p256_fn_mul(t, t, x3);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x2);
+    p256_fn_sqr_n(t, t, 8);
+    p256_fn_mul(t, t, o25);
+    p256_fn_sqr_n(t, t, 7);
+    p256_fn_mul(t, t, o21);
+    p256_fn_sqr_n(t, t, 6);
+    p256_fn_mul(t, t, x4);
+    copy_words(r, t, 4);
+}
+
+// a^((p-1)/2): 251 squarings and 57 multiplications, square and multiply takes 419 in all
+static inline int p256_fn_legendre(const u256 a) {
+    u256 a2, x2, o5, x3, o9, o11, o13, x4, o17, o19, o21, o23, o25, o27, o29, x5, t;
+    p256_fn_sqr(a2, a);
+    p256_fn_mul(x2, a, a2);
+    p256_fn_mul(o5, x2, a2);
+    p256_fn_mul(x3, o5, a2);
+    p256_fn_mul(o9, x3, a2);
+    p256_fn_mul(o11, o9, a2);
+    p256_fn_mul(o13, o11, a2);
+    p256_fn_mul(x4, o13, a2);
+    p256_fn_mul(o17, x4, a2);
+    p256_fn_mul(o19, o17, a2);
+    p256_fn_mul(o21, o19, a2);
+    p256_fn_mul(o23, o21, a2);
+    p256_fn_mul(o25, o23, a2);
+    p256_fn_mul(o27, o25, a2);
+    p256_fn_mul(o29, o27, a2);
+    p256_fn_mul(x5, o29, a2);
+    p256_fn_sqr_n(t, x5, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 2);
+    p256_fn_mul(t, t, x2);
+    p256_fn_sqr_n(t, t, 37);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x5);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x4);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x3);
+    p256_fn_sqr_n(t, t, 7);
+    p256_fn_mul(t, t, o27);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o29);
+    p256_fn_sqr_n(t, t, 6);
+    p256_fn_mul(t, t, o21);
+    p256_fn_sqr_n(t, t, 4);
+    p256_fn_mul(t, t, o11);
+    p256_fn_sqr_n(t, t, 6);
+    p256_fn_mul(t, t, o19);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o17);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x4);
+    p256_fn_sqr_n(t, t, 6);
+    p256_fn_mul(t, t, x4);
+    p256_fn_sqr_n(t, t, 2);
+    p256_fn_mul(t, t, a);
+    p256_fn_sqr_n(t, t, 9);
+    p256_fn_mul(t, t, o19);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o25);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o27);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o19);
+    p256_fn_sqr_n(t, t, 4);
+    p256_fn_mul(t, t, o9);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, o11);
+    p256_fn_sqr_n(t, t, 9);
+    p256_fn_mul(t, t, o23);
+    p256_fn_sqr_n(t, t, 3);
+    p256_fn_mul(t, t, x3);
+    p256_fn_sqr_n(t, t, 5);
+    p256_fn_mul(t, t, x2);
+    p256_fn_sqr_n(t, t, 8);
+    p256_fn_mul(t, t, o25);
+    p256_fn_sqr_n(t, t, 7);
+    p256_fn_mul(t, t, o21);
+    p256_fn_sqr_n(t, t, 2);
+    p256_fn_mul(t, t, a);
+    p256_fn_sqr_n(t, t, 3);
+    u256 one;
+    p256_fn_one(one);
+    return p256_fn_is_zero(t) ? 0 : p256_fn_eq(t, one) ? 1 : -1;
+}
+
+#endif // __FIELD_CHAINS_H
@@ -0,0 +1,64 @@
+#ifndef __FIELDS_H
+#define __FIELDS_H
+
+#include <field.h>
+
+/*
+    The prime fields of the curves we use, see field.h.
+*/
+
+// secp256k1 coordinates, p = 2^256 - 2^32 - 977
+FIELD_PSEUDO_MERSENNE(secp256k1_fp,
+    0xfffffffefffffc2fULL, 0xffffffffffffffffULL,
+    0xffffffffffffffffULL, 0xffffffffffffffffULL,
+    0x1000003d1ULL)
+
+// secp256k1 scalars, the group order n
+FIELD_MONTGOMERY(secp256k1_fn,
+    0xbfd25e8cd0364141ULL, 0xbaaedce6af48a03bULL,
+    0xfffffffffffffffeULL, 0xffffffffffffffffULL,
+    0x896cf21467d7d140ULL, 0x741496c20e7cf878ULL,
+    0xe697f5e45bcd07c6ULL, 0x9d671cd581c69bc5ULL)
+
+// alt_bn128 coordinates
+FIELD_MONTGOMERY(bn254_fp,
+    0x3c208c16d87cfd47ULL, 0x97816a916871ca8dULL,
+    0xb85045b68181585dULL, 0x30644e72e131a029ULL,
+    0xf32cfc5b538afa89ULL, 0xb5e71911d44501fbULL,
+    0x47ab1eff0a417ff6ULL, 0x06d89f71cab8351fULL)
+
+// alt_bn128 scalars, the group order r
+FIELD_MONTGOMERY(bn254_fr,
+    0x43e1f593f0000001ULL, 0x2833e84879b97091ULL,
+    0xb85045b68181585dULL, 0x30644e72e131a029ULL,
+    0x1bb8e645ae216da7ULL, 0x53fe3ab1e35c59e3ULL,
+    0x8c49833d53bb8085ULL, 0x0216d0b17f4e44a5ULL)
+
+// curve25519 coordinates, p = 2^255 - 19, so 2^256 = 38 mod p
+FIELD_PSEUDO_MERSENNE(f25519,
+    0xffffffffffffffedULL, 0xffffffffffffffffULL,
+    0xffffffffffffffffULL, 0x7fffffffffffffffULL,
+    38)
+
+// P-256 coordinates
+FIELD_SOLINAS_P256(p256_fp)
+
+// P-256 scalars, the group order n
+FIELD_MONTGOMERY(p256_fn,
+    0xf3b9cac2fc632551ULL, 0xbce6faada7179e84ULL,
+    0xffffffffffffffffULL, 0xffffffff00000000ULL,
+    0x83244c95be79eea2ULL, 0x4699799c49bd6fa6ULL,
+    0x2845b2392b6bec59ULL, 0x66e12d94f3d95620ULL)
+
+// name_inv, name_legendre and name_sqrt
+#include <field_chains.h>
+
+FIELD_INV_BATCH(secp256k1_fp)
+FIELD_INV_BATCH(secp256k1_fn)
+FIELD_INV_BATCH(bn254_fp)
+FIELD_INV_BATCH(bn254_fr)
+FIELD_INV_BATCH(f25519)
+FIELD_INV_BATCH(p256_fp)
+FIELD_INV_BATCH(p256_fn)
+
+#endif // __FIELDS_H
@@ -264,7 +264,7 @@ VM_HOOK(pay_for_memory_grow) void pay_for_memory_grow(const uint16_t pages);
  * [`DELEGATE_CALL`]: https://www.evm.codes/#f4
  * [`Retryable Ticket Address Aliasing`]: https://developer.arbitrum.io/arbos/l1-to-l2-messaging#address-aliasing
  */
-VM_HOOK(msg_sender) void msg_sender(const uint8_t * sender);
+VM_HOOK(msg_sender) void msg_sender(uint8_t * sender);
 
 /**
  * Get the ETH value in wei sent to the program. The semantics are equivalent to that of the
@@ -272,7 +272,7 @@ VM_HOOK(msg_sender) void msg_sender(const uint8_t * sender);
  *
  * [`CALLVALUE`]: https://www.evm.codes/#34
  */
-VM_HOOK(msg_value) void msg_value(const uint8_t * value);
+VM_HOOK(msg_value) void msg_value(uint8_t * value);
 
 /**
  * Efficiently computes the [`keccak256`] hash of the given preimage.
@@ -0,0 +1,31 @@
+#ifndef __INTERP_H
+#define __INTERP_H
+
+#include <uint256.h>
+#include <opcodes.h>
+
+/*
+    A stack machine for EVM arithmetic, comparison and bitwise bytecode.
+
+    Supported opcodes are STOP, 0x01-0x1d, POP, PUSH0-PUSH32, DUP1-DUP16 and
+    SWAP1-SWAP16 with the same semantics as the EVM. Execution ends at STOP
+    or at the end of the code.
+
+    The code is decoded once up front, so that PUSH immediates are already
+    little endian words when they are executed, and then run with computed
+    goto dispatch. The decoded code is scratch space in the arena.
+*/
+
+#define INTERP_STACK_SIZE 1024
+
+/*
+    Runs code over stack, which must have room for INTERP_STACK_SIZE words and
+    holds height words on entry, bottom first.
+
+    Returns the height of the stack after execution, or -1 if the code
+    contains an unsupported opcode or a truncated PUSH, or under/overflows
+    the stack.
+*/
+int interp_run(const uint8_t *code, size_t len, u256 *stack, int height);
+
+#endif // __INTERP_H
@@ -0,0 +1,60 @@
+#ifndef __NTT_H
+#define __NTT_H
+
+#include <uint256.h>
+
+/*
+    Number theoretic transforms over the BN254 scalar field bn254_fr, whose
+    multiplicative group has a subgroup of order 2^28, so vectors of up to
+    2^NTT_MAX_LOG elements can be transformed.
+
+    The forward transform evaluates the polynomial a[0] + a[1] x + ... at
+    the powers 1, w, w^2, ... of a primitive n-th root of unity w, and the
+    inverse interpolates back. Elements and twiddles are in the Montgomery
+    form of bn254_fr (see fields.h), and vectors are transformed in place,
+    in natural order.
+
+    The input is put in bit-reversed order in tiles of NTT_TILE x NTT_TILE
+    elements, which keeps the swaps within cache lines, and then goes
+    through radix-4 Cooley-Tukey passes, two stages per pass over memory,
+    with one radix-2 pass first if log n is odd.
+*/
+
+#define NTT_MAX_LOG 28
+
+// log2 of the tile side of the bit reversal
+#define NTT_TILE_LOG 4
+#define NTT_TILE (1 << NTT_TILE_LOG)
+
+// smaller transforms aren't worth threads
+#define NTT_THREAD_LOG 16
+
+typedef struct ntt_domain {
+    int log_n;
+    size_t n;
+    const u256 *w;     // w^i for i < n/2
+    const u256 *w_inv; // w^-i for i < n/2
+    u256 n_inv;        // 1/n
+} ntt_domain;
+
+/*
+    The twiddles of the transforms of size 2^log_n, into twiddles, which
+    has room for 2^log_n elements. They are too big for the arena, so the
+    caller owns them. False unless 1 <= log_n <= NTT_MAX_LOG.
+*/
+bool ntt_domain_init(ntt_domain *d, int log_n, u256 *twiddles);
+
+// a[i] <-> a[reverse(i)], with reverse over log_n bits
+void ntt_bit_reverse(u256 *a, int log_n);
+
+// a <- NTT(a) and a <- NTT^-1(a), for d->n elements
+void ntt_forward(const ntt_domain *d, u256 *a);
+void ntt_inverse(const ntt_domain *d, u256 *a);
+
+#ifndef __wasm__
+// the same, with the passes shared out over a power of two of the threads
+void ntt_forward_threads(const ntt_domain *d, u256 *a, int threads);
+void ntt_inverse_threads(const ntt_domain *d, u256 *a, int threads);
+#endif
+
+#endif // __NTT_H
@@ -0,0 +1,56 @@
+#ifndef __OPCODES_H
+#define __OPCODES_H
+
+/*
+    EVM opcode numbers for the 256 bit integer operations, shared by the batch
+    programs and the bytecode interpreter.
+
+    See: https://www.evm.codes/
+*/
+enum opcode {
+    OP_STOP       = 0x00,
+
+    // arithmetic
+    OP_ADD        = 0x01,
+    OP_MUL        = 0x02,
+    OP_SUB        = 0x03,
+    OP_DIV        = 0x04,
+    OP_SDIV       = 0x05,
+    OP_MOD        = 0x06,
+    OP_SMOD       = 0x07,
+    OP_ADDMOD     = 0x08,
+    OP_MULMOD     = 0x09,
+    OP_EXP        = 0x0a,
+    OP_SIGNEXTEND = 0x0b,
+
+    // comparison
+    OP_LT         = 0x10,
+    OP_GT         = 0x11,
+    OP_SLT        = 0x12,
+    OP_SGT        = 0x13,
+    OP_EQ         = 0x14,
+    OP_ISZERO     = 0x15,
+
+    // bitwise
+    OP_AND        = 0x16,
+    OP_OR         = 0x17,
+    OP_XOR        = 0x18,
+    OP_NOT        = 0x19,
+    OP_BYTE       = 0x1a,
+    OP_SHL        = 0x1b,
+    OP_SHR        = 0x1c,
+    OP_SAR        = 0x1d,
+    OP_CLZ        = 0x1e, // EIP-7939
+
+    // stack
+    OP_POP        = 0x50,
+    OP_PUSH0      = 0x5f,
+    OP_PUSH1      = 0x60,
+    OP_PUSH32     = 0x7f,
+    OP_DUP1       = 0x80,
+    OP_DUP16      = 0x8f,
+    OP_SWAP1      = 0x90,
+    OP_SWAP16     = 0x9f,
+};
+
+#endif // __OPCODES_H
@@ -0,0 +1,60 @@
+#ifndef __P256_H
+#define __P256_H
+
+#include <uint256.h>
+
+/*
+    NIST P-256 (secp256r1) ECDSA verification, as in the RIP-7212
+    precompile.
+
+    Coordinates are elements of the p256_fp field, which reduces with the
+    Solinas structure of p, and scalars use the p256_fn Montgomery field,
+    see fields.h. u1 G + u2 Q is computed in Jacobian coordinates with one
+    shared chain of doublings: G's wNAF digits are up to P256_G_WINDOW bits
+    wide and come from a static table made by scripts/gen_p256_table.js,
+    and Q's are 5 bits wide, from odd multiples made affine with one
+    inversion.
+*/
+
+typedef struct p256_affine {
+    u256 x;
+    u256 y;
+    bool infinity;
+} p256_affine;
+
+// the point at infinity has z = 0
+typedef struct p256_jacobian {
+    u256 x;
+    u256 y;
+    u256 z;
+} p256_jacobian;
+
+// p256_g_odd[i] = (2i + 1) G, in src/p256_table.c
+#define P256_G_WINDOW 8
+
+extern const p256_affine p256_g_odd[1 << (P256_G_WINDOW - 2)];
+
+void p256_double(p256_jacobian *r, const p256_jacobian *a);
+
+// r = a + b, r may be a
+void p256_add_affine(p256_jacobian *r, const p256_jacobian *a,
+                     const p256_affine *b);
+
+void p256_to_affine(p256_affine *r, const p256_jacobian *a);
+
+// with coordinates below p
+bool p256_on_curve(const p256_affine *a);
+
+// r = u1 G + u2 q, for u1 and u2 below n
+void p256_mul2(p256_jacobian *r, const u256 u1, const p256_affine *q,
+               const u256 u2);
+
+/*
+    Whether (r, s) is a signature of hash by pubkey. Like RIP-7212, r and s
+    must be in [1, n-1] and pubkey on the curve, and hash is used whole,
+    reduced mod n.
+*/
+bool p256_verify(const u256 hash, const u256 r, const u256 s,
+                 const p256_affine *pubkey);
+
+#endif // __P256_H
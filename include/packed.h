@@ -0,0 +1,52 @@
+#ifndef __PACKED_H
+#define __PACKED_H
+
+#include <uint256.h>
+
+/*
+    A compact encoding for u256 operands, to cut calldata size.
+
+    A literal is a length byte n <= 32 followed by the value as n big endian
+    bytes with no leading zeros, so 0 is the single byte 0x00 and 1000 is
+    0x02 0x03 0xe8.
+
+    A packed input is a dictionary followed by the operands:
+
+      n_dict                  one byte, at most PACKED_MAX_DICT
+      n_dict literals         the dictionary
+      operands                each a literal, or the byte
+                              PACKED_DICT_REF + i for dictionary entry i
+
+    so a value used many times is only sent once. scripts/packed.js encodes
+    values in this format.
+*/
+
+#define PACKED_MAX_DICT 64
+#define PACKED_DICT_REF 0x40
+
+typedef struct packed_reader {
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    int n_dict;
+    u32 dict[PACKED_MAX_DICT]; // offsets of the dictionary literals
+} packed_reader;
+
+/*
+    Decodes the literal at the start of data into x.
+
+    Returns the number of bytes read, or -1 if the literal is truncated or
+    longer than 32 bytes.
+*/
+int packed_literal(u256 x, const uint8_t *data, size_t len);
+
+// reads the dictionary, returns -1 if it's malformed
+int packed_init(packed_reader *r, const uint8_t *data, size_t len);
+
+// decodes the next operand into x, returns -1 at the end or if it's malformed
+int packed_next(packed_reader *r, u256 x);
+
+// whether every operand has been read
+bool packed_done(const packed_reader *r);
+
+#endif // __PACKED_H
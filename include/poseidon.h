@@ -0,0 +1,40 @@
+#ifndef __POSEIDON_H
+#define __POSEIDON_H
+
+#include <uint256.h>
+
+/*
+    The Poseidon hash of circomlib, over the BN254 scalar field bn254_fr:
+    poseidon(x1, ..., xn) permutes the state (0, x1, ..., xn) of width
+    t = n + 1 and returns its first element.
+
+    The round constants and MDS matrices are generated by
+    scripts/gen_poseidon.js into src/poseidon_table.c, in Montgomery form and
+    rewritten so that a partial round adds one constant and multiplies by a
+    sparse matrix: 2t - 1 multiplications instead of t^2.
+*/
+#define POSEIDON_MAX_INPUTS 16
+
+typedef struct poseidon_params {
+    int t;
+    int partial_rounds;
+    const u256 *full;    // t per full round, 8 rounds
+    const u256 *partial; // one per partial round
+    const u256 *sparse;  // 2t - 1 per partial round: n00, row 0, column 0
+    const u256 *mds;     // t * t, row by row
+    const u256 *pre;     // the last full round before the partial rounds'
+} poseidon_params;
+
+// poseidon_widths[n - 1] for n inputs, up to poseidon_max_inputs, which is
+// POSEIDON_MAX_INPUTS unless the table was generated for fewer
+extern const int poseidon_max_inputs;
+extern const poseidon_params poseidon_widths[];
+
+// the permutation of a state of p->t elements, in Montgomery form
+void poseidon_permute(const poseidon_params *p, u256 *state);
+
+// out = poseidon(inputs[0], ..., inputs[n-1]), with inputs reduced mod r.
+// False unless 1 <= n <= poseidon_max_inputs.
+bool poseidon_hash(u256 out, const u256 *inputs, size_t n);
+
+#endif // __POSEIDON_H
@@ -0,0 +1,81 @@
+#ifndef __PROFILE_H
+#define __PROFILE_H
+
+/*
+    Ink profiling for the Stylus contract.
+
+    Building with -DINK_PROFILE (see `make profile`) samples evm_ink_left()
+    around every opcode and around the heavy kernels, and appends the totals
+    to the return data of each call. Without INK_PROFILE all of the macros
+    below compile to nothing, so the production build is unchanged.
+
+    The trailer is PROF_SITES big endian words followed by a word holding
+    PROF_SITES. Word i holds (count << 128) | ink for site i. Sites below 0x20
+    are the EVM opcode numbers from opcodes.h. The ink of each sample includes
+    the cost of the evm_ink_left() calls themselves.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum profile_site {
+    // 0x01 - 0x1e: opcodes
+    PROF_UDIVREM    = 0x20,
+    PROF_RECIPROCAL = 0x21,
+    PROF_REDUCE4    = 0x22,
+    PROF_EXP_LOOP   = 0x23,
+    PROF_CTZ        = 0x24,
+    PROF_POPCOUNT   = 0x25,
+    // the array entry points, a whole call's kernel each
+    PROF_ADD_ARRAY    = 0x26,
+    PROF_MUL_ARRAY    = 0x27,
+    PROF_MULMOD_ARRAY = 0x28,
+    PROF_SUM_ARRAY    = 0x29,
+    PROF_DOT_MOD      = 0x2a,
+    PROF_LT_MASK      = 0x2b,
+    PROF_INVMOD_ARRAY = 0x2c,
+    PROF_ADD_PACKED   = 0x2d,
+    // the curve and hash entry points
+    PROF_EC_RECOVER      = 0x2e,
+    PROF_EC_VERIFY_BATCH = 0x2f,
+    PROF_P256_VERIFY     = 0x30,
+    PROF_EC_ADD          = 0x31,
+    PROF_EC_MUL          = 0x32,
+    PROF_EC_MSM          = 0x33,
+    PROF_EC_PAIRING      = 0x34,
+    PROF_POSEIDON        = 0x35,
+    PROF_SITES           = 0x36,
+};
+
+#ifdef INK_PROFILE
+
+#include <hostio.h>
+
+void profile_record(int site, uint64_t ink_before);
+
+/*
+    Copies data into a buffer in the arena, appends the trailer and returns
+    the buffer. *len is updated to include the trailer.
+*/
+const uint8_t *profile_output(const uint8_t *data, size_t *len);
+
+// run stmt, charging its ink to site
+#define PROFILE(site, ...) do {                                             \
+        uint64_t __profile_ink = evm_ink_left();                            \
+        __VA_ARGS__;                                                        \
+        profile_record((site), __profile_ink);                              \
+    } while (0)
+
+// charge everything between BEGIN(name) and END(name, site) to site
+#define PROFILE_BEGIN(name) uint64_t name##_profile_ink = evm_ink_left()
+#define PROFILE_END(name, site) profile_record((site), name##_profile_ink)
+
+#else
+
+#define PROFILE(site, ...) __VA_ARGS__
+#define PROFILE_BEGIN(name)
+#define PROFILE_END(name, site)
+
+#endif // INK_PROFILE
+
+#endif // __PROFILE_H
@@ -0,0 +1,130 @@
+#ifndef __SECP256K1_H
+#define __SECP256K1_H
+
+#include <uint256.h>
+
+/*
+    secp256k1 points, scalar multiplication and ECDSA signatures.
+
+    Coordinates are elements of the secp256k1_fp field and scalars are
+    plain u256s below the group order n, see fields.h. Points are kept in
+    Jacobian coordinates, x = X/Z^2 and y = Y/Z^3, while they are added up,
+    so a whole scalar multiplication needs one inversion at the end.
+
+    Scalar multiplication uses:
+      - the GLV endomorphism: lambda * (x, y) = (beta * x, y), which splits
+        a 256 bit scalar into two of 128 bits and halves the doublings
+      - Strauss-Shamir: the wNAF digits of every scalar of a sum are added
+        in one shared chain of doublings, so k1 * G + k2 * Q costs little
+        more than a single multiplication
+      - for the generator alone, a comb of precomputed multiples of G,
+        generated by scripts/gen_secp256k1_table.js
+*/
+
+typedef struct secp256k1_affine {
+    u256 x;
+    u256 y;
+    bool infinity;
+} secp256k1_affine;
+
+// the point at infinity has z = 0
+typedef struct secp256k1_jacobian {
+    u256 x;
+    u256 y;
+    u256 z;
+} secp256k1_jacobian;
+
+/*
+    generator tables, in src/secp256k1_table.c
+
+    secp256k1_g_odd[i] = (2i + 1) G, for wNAF digits of G's scalar of up to
+    SECP256K1_G_WINDOW bits. Entry b of secp256k1_g_comb[k] is the sum of
+    2^(64j + 32k) G over the bits j set in b.
+*/
+#define SECP256K1_G_WINDOW 6
+#define SECP256K1_COMB_TEETH 4
+#define SECP256K1_COMB_BLOCKS 2
+
+extern const secp256k1_affine secp256k1_g_odd[1 << (SECP256K1_G_WINDOW - 2)];
+extern const secp256k1_affine
+    secp256k1_g_comb[SECP256K1_COMB_BLOCKS][1 << SECP256K1_COMB_TEETH];
+
+/*
+    points
+*/
+void secp256k1_double(secp256k1_jacobian *r, const secp256k1_jacobian *a);
+
+// r = a + b, r may be a
+void secp256k1_add(secp256k1_jacobian *r, const secp256k1_jacobian *a,
+                   const secp256k1_jacobian *b);
+void secp256k1_add_affine(secp256k1_jacobian *r, const secp256k1_jacobian *a,
+                          const secp256k1_affine *b);
+
+void secp256k1_to_affine(secp256k1_affine *r, const secp256k1_jacobian *a);
+
+// converts n points with a single inversion
+void secp256k1_to_affine_batch(secp256k1_affine *r,
+                               const secp256k1_jacobian *a, size_t n);
+
+bool secp256k1_on_curve(const secp256k1_affine *a);
+
+// the point with coordinate x and a y of the given parity, false if x isn't
+// the coordinate of a point
+bool secp256k1_decompress(secp256k1_affine *r, const u256 x, bool odd);
+
+/*
+    scalars
+*/
+// k = k1 + k2 * lambda mod n, with k1 and k2 negated when neg1 and neg2 are
+// set. Both are below 2^128.
+void secp256k1_split_lambda(u256 k1, bool *neg1, u256 k2, bool *neg2,
+                            const u256 k);
+
+// r = k * G, with the comb
+void secp256k1_mul_gen(secp256k1_jacobian *r, const u256 k);
+
+// r = g * G + scalars[0] * points[0] + ... + scalars[n-1] * points[n-1]
+// g may be NULL. Scalars below 2^128 skip the GLV split. Uses about 2 kB of
+// arena scratch per point.
+void secp256k1_msm(secp256k1_jacobian *r, const u256 g,
+                   const secp256k1_affine *points, const u256 *scalars,
+                   size_t n);
+
+/*
+    ECDSA
+
+    hash is the message hash as a number, r and s the signature and v the
+    parity of the y coordinate of the nonce point R (0 or 1, what Ethereum
+    encodes as 27 or 28). Signatures with r or s outside [1, n-1] fail.
+*/
+bool secp256k1_verify(const u256 hash, const u256 r, const u256 s,
+                      const secp256k1_affine *pubkey);
+
+// the public key that signed hash, like the ecrecover precompile
+bool secp256k1_recover(secp256k1_affine *pubkey, const u256 hash, int v,
+                       const u256 r, const u256 s);
+
+typedef struct secp256k1_signature {
+    u256 hash;
+    u256 r;
+    u256 s;
+    int v;
+    secp256k1_affine pubkey;
+} secp256k1_signature;
+
+/*
+    Verifies n signatures at once: with R_i rebuilt from r_i and v_i, and
+    random 128 bit a_i derived with keccak256 from all of the signatures,
+    checks that
+
+        sum a_i (u1_i G + u2_i Q_i - R_i) = 0
+
+    with one multi-scalar multiplication. It is true if every signature is
+    valid, and false, except with probability 2^-128, if any isn't.
+
+    Unlike secp256k1_verify it needs v, and rejects the signatures whose
+    nonce point has x = r + n, which have probability about 2^-128.
+*/
+bool secp256k1_verify_batch(const secp256k1_signature *sigs, size_t n);
+
+#endif // __SECP256K1_H
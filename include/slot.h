@@ -0,0 +1,45 @@
+#ifndef __SLOT_H
+#define __SLOT_H
+
+#include <uint256.h>
+#include <bebi.h>
+
+/*
+    A write-back cache of storage slots for the duration of a call.
+
+    Slots are loaded with storage_load_bytes32 the first time they are used
+    and kept as little endian u256s in an open addressed table, so repeated
+    reads and updates of the same slot cost no hostio calls and no byte
+    swaps. Dirty slots are written back once, by slot_flush, which ENTRYPOINT
+    calls when the call succeeds. A reverted call discards its writes anyway.
+
+    Call slot_flush before calling another contract that might read the
+    same storage.
+*/
+
+#define SLOT_CACHE_SIZE 64 // a power of two
+
+// forgets every slot without writing back
+void slot_reset(void);
+
+// writes every dirty slot back to storage
+void slot_flush(void);
+
+void slot_get(u256 res, const bebi32 key);
+void slot_set(const bebi32 key, u256 value);
+
+// slot += x, wrapping like ADD
+void slot_add(const bebi32 key, u256 x);
+
+// slot -= x, or returns -1 and leaves the slot unchanged if x > slot
+int slot_sub_checked(const bebi32 key, u256 x);
+
+/*
+    slot = slot * num / den with a 512 bit intermediate product.
+
+    Returns -1 and leaves the slot unchanged if den is zero or the quotient
+    doesn't fit in 256 bits.
+*/
+int slot_mul_div(const bebi32 key, u256 num, u256 den);
+
+#endif // __SLOT_H
@@ -8,8 +8,8 @@
  * This defines the entrypoint to a smart contract.
  * Only one file per wasm is expected to have an entrypoint
  *
- * requires: stylus_types.h
- * c-file: -
+ * requires: stylus_types.h, arena.h, slot.h, env.h
+ * c-file: arena.c, slot.c, env.c
  */
 
 #include <stddef.h>
@@ -17,6 +17,9 @@
 
 #include "hostio.h"
 #include "stylus_types.h"
+#include "arena.h"
+#include "slot.h"
+#include "env.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,9 +35,15 @@ extern "C" {
                                                                         \
     __attribute__((export_name("user_entrypoint")))                     \
     int user_entrypoint(size_t args_len) {                              \
-        uint8_t args[args_len];                                         \
+        arena_reset();                                                  \
+        slot_reset();                                                   \
+        env_reset();                                                    \
+        uint8_t *args = arena_alloc(args_len);                          \
         read_args(args);                                                \
         const ArbResult result = user_main(args, args_len);             \
+        if (result.status == Success) {                                 \
+            slot_flush();                                               \
+        }                                                               \
         write_result(result.output, result.output_len);                 \
         return result.status;                                           \
     }
@@ -1,3 +1,6 @@
+#ifndef __UINT256_H
+#define __UINT256_H
+
 #include <uint256_core.h>
 
 /*
@@ -36,3 +39,19 @@ void u256_byte(u256 res, u256 x, u256 i);
 void u256_shl(u256 res, u256 x, u256 shift);
 void u256_shr(u256 res, u256 x, u256 shift);
 void u256_sar(u256 res, u256 x, u256 shift);
+
+// bit counting: CLZ from EIP-7939, and the counts and permutations that go
+// with it. The counts of zero are 256.
+void u256_clz(u256 res, u256 x);
+void u256_ctz(u256 res, u256 x);
+void u256_popcount(u256 res, u256 x);
+void u256_bit_reverse(u256 res, u256 x);
+void u256_bswap(u256 res, u256 x);
+
+// the width-w NAF of x, for scalar multiplication: odd digits below 2^(w-1)
+// in absolute value with at least w - 1 zeros after each, least significant
+// first, for 2 <= w <= 8. Returns the number of digits, at most
+// bit_len(x) + 1. x + 2^(w-1) must fit in 256 bits.
+int u256_wnaf(int8_t *digits, const u256 x, int w);
+
+#endif // __UINT256_H
@@ -1,3 +1,6 @@
+#ifndef __UINT256_CORE_H
+#define __UINT256_CORE_H
+
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
@@ -54,9 +57,19 @@ void squared(u256 x);
 // void lsh128(u256 res, u256 x);
 // void lsh64(u256 res, u256 x);
 
+/*
+    Building with -DU256_BRANCH_FREE (make BRANCH_FREE=1) replaces lsh, rsh,
+    srsh, the final correction of reduce4, u256_slt and u256_sgt with
+    versions that select results with masks instead of branching, so the
+    instructions they run don't depend on the operands. u256_add_mod then
+    reduces x + y with reduce4 when m >= 2^192, with the reciprocal of the
+    last modulus kept, so its cost depends on m alone.
+*/
 void lsh(u256 res, u256 x, u64 n);
 void rsh(u256 res, u256 x, u64 n);
 void srsh(u256 res, u256 x, u64 n);
 
 void reciprocal(u320 mu, u256 m);
-void reduce4(u256 res, u512 x, u256 m, u64 *mu);
\ No newline at end of file
+void reduce4(u256 res, u512 x, u256 m, u64 *mu);
+
+#endif // __UINT256_CORE_H
@@ -0,0 +1,37 @@
+#ifndef __UINT256BE_H
+#define __UINT256BE_H
+
+#include <uint256_core.h>
+#include <bebi.h>
+
+/*
+    Opcodes that work directly on big endian words, such as the calldata
+    words in the args buffer of a contract call.
+
+    These are the opcodes where the byte order doesn't matter or is easy to
+    remap, so the words don't need to be converted to little endian u256s and
+    back. Results are written in place into the first operand.
+*/
+
+// comparison
+bool u256be_lt(const bebi32 x, const bebi32 y);
+bool u256be_gt(const bebi32 x, const bebi32 y);
+bool u256be_slt(const bebi32 x, const bebi32 y);
+bool u256be_sgt(const bebi32 x, const bebi32 y);
+bool u256be_eq(const bebi32 x, const bebi32 y);
+bool u256be_is_zero(const bebi32 x);
+void u256be_set_bool(bebi32 x, bool b);
+
+// bitwise
+void u256be_and(bebi32 x, const bebi32 y);
+void u256be_or(bebi32 x, const bebi32 y);
+void u256be_xor(bebi32 x, const bebi32 y);
+void u256be_not(bebi32 x);
+void u256be_byte(bebi32 x, const bebi32 i);
+
+// shifts by a whole number of bytes, n <= 32
+void u256be_shl_bytes(bebi32 x, int n);
+void u256be_shr_bytes(bebi32 x, int n);
+void u256be_sar_bytes(bebi32 x, int n);
+
+#endif // __UINT256BE_H
@@ -0,0 +1,58 @@
+#ifndef __UINT256V_H
+#define __UINT256V_H
+
+#include <uint256.h>
+
+/*
+    Element-wise opcodes over arrays of u256, stored as a struct of arrays.
+
+    Limb j of element i is limb[j][i], so each kernel streams through four
+    contiguous u64 arrays instead of hopping over 32 byte elements, and
+    anything that depends only on a shared operand, like the reciprocal of
+    the modulus, is computed once per array instead of once per element.
+
+    res may be the same array as any of the operands.
+*/
+
+typedef struct u256v {
+    u64 *limb[4];
+    size_t n;
+} u256v;
+
+// allocates an array of n elements in the arena
+void u256v_alloc(u256v *v, size_t n);
+
+void u256v_get(u256 x, const u256v *v, size_t i);
+void u256v_set(u256v *v, size_t i, u256 x);
+
+// res[i] = x[i] + y[i]
+void u256v_add(u256v *res, const u256v *x, const u256v *y);
+
+// res[i] = x[i] * y[i]
+void u256v_mul(u256v *res, const u256v *x, const u256v *y);
+
+// res[i] = x[i] * y[i] % m
+void u256v_mul_mod(u256v *res, const u256v *x, const u256v *y, u256 m);
+
+// res = x[0] + x[1] + ...
+void u256v_sum(u256 res, const u256v *x);
+
+// res = (x[0] * y[0] + x[1] * y[1] + ...) % m
+void u256v_dot_mod(u256 res, const u256v *x, const u256v *y, u256 m);
+
+/*
+    res[i] = x[i]^-1 % m for a prime m, by Montgomery's trick: one inversion
+    of the product of all of x, by Fermat's little theorem, and three
+    multiplications per element. Elements that are 0 mod m are left out of
+    the product and give 0, like the field inversions of fields.h, and so
+    does everything for m < 2.
+
+    The prefix products are kept in res, so when res is x they need a
+    scratch array from the arena instead.
+*/
+void u256v_inv_mod(u256v *res, const u256v *x, u256 m);
+
+// bit i of mask (little endian u64 words) is set if x[i] < y[i]
+void u256v_lt_mask(u64 *mask, const u256v *x, const u256v *y);
+
+#endif // __UINT256V_H
@@ -0,0 +1,223 @@
+// Generates include/field_chains.h, the fixed exponents of the fields of
+// include/fields.h as straight-line addition chains.
+// Usage:
+//   node scripts/gen_chains.js > include/field_chains.h
+//
+// Every field gets
+//   name_inv(r, a)      a^(p-2), 0 for 0
+//   name_legendre(a)    a^((p-1)/2) as 1, -1 or 0
+// and the fields with p = 3 mod 4 also
+//   name_sqrt(r, a)     a^((p+1)/4), a square root of a if there is one
+//
+// A chain is the exponent's bits from the top, cut into tokens: runs of ones
+// taken whole, a^(2^k - 1), and odd windows of up to w bits from a table of
+// a, a^3, ..., a^(2^w - 1). The runs are built from each other, 2^(j+k) - 1
+// = (2^j - 1) 2^k + 2^k - 1, so the long leading run of p - 2 for p close
+// to 2^256 costs little more than its squarings. The window w and the
+// shortest run taken whole are the cheapest of all those tried, counting
+// squarings and multiplications alike as they are the same Montgomery or
+// reduction kernel. Each chain is checked by recomputing its exponent.
+const fs = require('fs');
+const path = require('path');
+
+const fieldsH = fs.readFileSync(path.join(__dirname, '../include/fields.h'), 'utf8');
+
+// the fields and their moduli, from the macros that declare them
+function fields() {
+    const out = [];
+    const re = /FIELD_(PSEUDO_MERSENNE|MONTGOMERY|SOLINAS_P256)\(\s*(\w+)([^)]*)\)/g;
+    for (let m; (m = re.exec(fieldsH));) {
+        const name = m[2];
+        let p;
+        if (m[1] === 'SOLINAS_P256') {
+            p = 0xffffffff00000001000000000000000000000000ffffffffffffffffffffffffn;
+        } else {
+            const limbs = m[3].match(/0x[0-9a-fA-F]+/g).slice(0, 4).map((x) => BigInt(x));
+            p = limbs.reduce((acc, x, i) => acc | (x << BigInt(64 * i)), 0n);
+        }
+        out.push({ name, p });
+    }
+    return out;
+}
+
+const bitLen = (x) => x.toString(2).length;
+
+/*
+    A chain is a list of steps on named values, with the exponent of each:
+      { op: 'sqr', dst, src, n }   dst = src^(2^n)
+      { op: 'mul', dst, a, b }     dst = a b
+    'a' is the input, 't' the accumulator and the rest are named after their
+    exponent: xk for 2^k - 1 and oN for the other odd N.
+*/
+const nameOf = (e) => (e === 1n ? 'a' : (e & (e + 1n)) === 0n ? `x${bitLen(e)}` : `o${e}`);
+
+function build(e, w, minRun) {
+    const steps = [];
+    const have = new Map([[1n, 'a']]);
+    let sqrs = 0, muls = 0;
+    const sqr = (dst, src, n) => {
+        steps.push({ op: 'sqr', dst, src, n });
+        sqrs += n;
+    };
+    const mul = (dst, a, b) => {
+        steps.push({ op: 'mul', dst, a, b });
+        muls++;
+    };
+
+    // the tokens, from the top bit
+    const bits = e.toString(2);
+    const tokens = [];
+    for (let i = 0; i < bits.length;) {
+        if (bits[i] === '0') {
+            tokens.push({ shift: 1, value: 0n });
+            i++;
+            continue;
+        }
+        let run = 0;
+        while (i + run < bits.length && bits[i + run] === '1') run++;
+        if (run >= minRun) {
+            tokens.push({ shift: run, value: (1n << BigInt(run)) - 1n });
+            i += run;
+            continue;
+        }
+        let len = Math.min(w, bits.length - i);
+        while (bits[i + len - 1] === '0') len--;
+        tokens.push({ shift: len, value: BigInt('0b' + bits.slice(i, i + len)) });
+        i += len;
+    }
+
+    // the odd table up to the largest window
+    let maxOdd = 1n;
+    for (const t of tokens) {
+        if (t.value > maxOdd && bitLen(t.value) <= w && t.shift < minRun) maxOdd = t.value;
+    }
+    if (maxOdd > 1n) {
+        sqr('a2', 'a', 1);
+        for (let v = 3n; v <= maxOdd; v += 2n) {
+            mul(nameOf(v), nameOf(v - 2n), 'a2');
+            have.set(v, nameOf(v));
+        }
+    }
+
+    // the runs of ones, 2^(c+d) - 1 from 2^c - 1 shifted by d bits and
+    // 2^d - 1, with c the longest built run and d the longest that fits: c
+    // only grows, so building the longest run takes one squaring per bit
+    const runs = () => [...have.keys()].filter((v) => (v & (v + 1n)) === 0n).map(bitLen);
+    const ones = (k) => {
+        let c = Math.max(...runs().filter((j) => j <= k));
+        while (c < k) {
+            const d = Math.max(...runs().filter((j) => c + j <= k));
+            const v = (1n << BigInt(c + d)) - 1n;
+            sqr(nameOf(v), nameOf((1n << BigInt(c)) - 1n), d);
+            mul(nameOf(v), nameOf(v), nameOf((1n << BigInt(d)) - 1n));
+            have.set(v, nameOf(v));
+            c += d;
+        }
+    };
+    const lengths = [...new Set(tokens.filter((t) => t.shift >= minRun && t.value > 0n).map((t) => t.shift))];
+    lengths.sort((x, y) => x - y).forEach(ones);
+
+    // the accumulator starts as the first token, and the rest shift it
+    let acc = nameOf(tokens[0].value);
+    let pending = 0;
+    for (const t of tokens.slice(1)) {
+        pending += t.shift;
+        if (t.value === 0n) continue;
+        sqr('t', acc, pending);
+        mul('t', 't', nameOf(t.value));
+        acc = 't';
+        pending = 0;
+    }
+    if (pending > 0) {
+        sqr('t', acc, pending);
+        acc = 't';
+    }
+    return { steps, result: acc, sqrs, muls };
+}
+
+// the exponent a chain computes
+function exponent(chain) {
+    const v = new Map([['a', 1n]]);
+    for (const s of chain.steps) {
+        if (s.op === 'sqr') v.set(s.dst, v.get(s.src) << BigInt(s.n));
+        else v.set(s.dst, v.get(s.a) + v.get(s.b));
+    }
+    return v.get(chain.result);
+}
+
+function best(e) {
+    let best = null;
+    for (let w = 1; w <= 7; w++) {
+        for (const minRun of [w + 1, w + 2, 8, 12, 16, 24, 32, 64, 256]) {
+            if (minRun <= w) continue;
+            const c = build(e, w, minRun);
+            if (exponent(c) !== e) {
+                throw new Error(`the chain for ${e.toString(16)} is wrong`);
+            }
+            if (!best || c.sqrs + c.muls < best.sqrs + best.muls) best = c;
+        }
+    }
+    return best;
+}
+
+// square and multiply: a squaring per bit and a multiplication per one
+const binaryCost = (e) => bitLen(e) - 1 + e.toString(2).split('1').length - 2;
+
+/*
+    C
+*/
+function emit(out, f, fn, e, chain, signature, what) {
+    out.push('');
+    out.push(`// ${what}: ${chain.sqrs} squarings and ${chain.muls} multiplications, ` +
+             `square and multiply takes ${binaryCost(e)} in all`);
+    out.push(signature);
+    const vars = [...new Set(chain.steps.map((s) => s.dst))];
+    out.push(`    u256 ${vars.join(', ')};`);
+    for (const s of chain.steps) {
+        if (s.op === 'sqr') {
+            if (s.n === 1) out.push(`    ${f}_sqr(${s.dst}, ${s.src});`);
+            else out.push(`    ${f}_sqr_n(${s.dst}, ${s.src}, ${s.n});`);
+        } else {
+            out.push(`    ${f}_mul(${s.dst}, ${s.a}, ${s.b});`);
+        }
+    }
+    return chain.result;
+}
+
+const out = [];
+out.push('// Generated by scripts/gen_chains.js from include/fields.h, do not edit.');
+out.push('#ifndef __FIELD_CHAINS_H');
+out.push('#define __FIELD_CHAINS_H');
+const summary = [];
+for (const { name, p } of fields()) {
+    out.push('');
+    out.push(`/*\n    ${name}\n*/`);
+
+    let e = p - 2n, c = best(e);
+    let r = emit(out, name, 'inv', e, c, `static inline void ${name}_inv(u256 r, const u256 a) {`, 'a^(p-2)');
+    out.push(`    copy_words(r, ${r}, 4);`);
+    out.push('}');
+    summary.push(`${name}_inv ${c.sqrs + c.muls} / ${binaryCost(e)}`);
+
+    e = (p - 1n) / 2n;
+    c = best(e);
+    r = emit(out, name, 'legendre', e, c, `static inline int ${name}_legendre(const u256 a) {`, 'a^((p-1)/2)');
+    out.push(`    u256 one;`);
+    out.push(`    ${name}_one(one);`);
+    out.push(`    return ${name}_is_zero(${r}) ? 0 : ${name}_eq(${r}, one) ? 1 : -1;`);
+    out.push('}');
+    summary.push(`${name}_legendre ${c.sqrs + c.muls} / ${binaryCost(e)}`);
+
+    if (p % 4n === 3n) {
+        e = (p + 1n) / 4n;
+        c = best(e);
+        r = emit(out, name, 'sqrt', e, c, `static inline void ${name}_sqrt(u256 r, const u256 a) {`, 'a^((p+1)/4)');
+        out.push(`    copy_words(r, ${r}, 4);`);
+        out.push('}');
+        summary.push(`${name}_sqrt ${c.sqrs + c.muls} / ${binaryCost(e)}`);
+    }
+}
+out.push('');
+out.push('#endif // __FIELD_CHAINS_H');
+console.log(out.join('\n'));
+console.error('operations, chain / square and multiply:\n  ' + summary.join('\n  '));
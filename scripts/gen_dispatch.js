@@ -0,0 +1,161 @@
+const fs = require('fs');
+
+
+// Generates the contract's entrypoint from the ABI in build/interface.json.
+// Usage:
+//   node scripts/gen_dispatch.js build/interface.json > Uint256_dispatch.c
+//
+// The selectors are hashed into a table with a multiplicative perfect hash,
+// (selector * K) >> SHIFT, so dispatch is one multiply, one table load, a
+// selector compare and a calldata length check however many entry points
+// the contract has.
+const [path, source = 'uint256', name = 'Uint256'] = process.argv.slice(2);
+
+const iface = JSON.parse(fs.readFileSync(path || 'build/interface.json'));
+const contract = iface.contracts[source][name];
+
+// ABI encoding: the size of a parameter's head and whether it has a tail
+function is_dynamic(param) {
+    if (param.type === 'bytes' || param.type === 'string' || param.type.endsWith('[]')) {
+        return true;
+    }
+    const fixed = param.type.match(/^(.*)\[(\d+)\]$/);
+    if (fixed) {
+        return is_dynamic({ ...param, type: fixed[1] });
+    }
+    if (param.type === 'tuple') {
+        return param.components.some(is_dynamic);
+    }
+    return false;
+}
+
+function head_size(param) {
+    if (is_dynamic(param)) {
+        return 32;
+    }
+    const fixed = param.type.match(/^(.*)\[(\d+)\]$/);
+    if (fixed) {
+        return Number(fixed[2]) * head_size({ ...param, type: fixed[1] });
+    }
+    if (param.type === 'tuple') {
+        return param.components.reduce((n, p) => n + head_size(p), 0);
+    }
+    return 32;
+}
+
+const entries = contract.abi
+    .filter((item) => item.type === 'function')
+    .map((fn) => {
+        const signature = `${fn.name}(${fn.inputs.map(canonical).join(',')})`;
+        const id = contract.evm.methodIdentifiers[signature];
+        if (id === undefined) {
+            throw new Error(`no selector for ${signature}`);
+        }
+        // *Packed functions take the raw calldata after the selector, see
+        // include/packed.h
+        const raw = fn.name.endsWith('Packed');
+        return {
+            name: fn.name,
+            signature,
+            selector: parseInt(id, 16) >>> 0,
+            len: raw ? 0 : fn.inputs.reduce((n, p) => n + head_size(p), 0),
+            dynamic: raw || fn.inputs.some(is_dynamic),
+        };
+    });
+
+function canonical(param) {
+    if (param.type.startsWith('tuple')) {
+        return `(${param.components.map(canonical).join(',')})` + param.type.slice(5);
+    }
+    return param.type;
+}
+
+// find the smallest table, and a multiplier for it, without collisions
+function find_hash() {
+    let bits = Math.max(1, Math.ceil(Math.log2(entries.length)));
+    let seed = 0x9e3779b9;
+    for (;; bits++) {
+        for (let tries = 0; tries < 1 << 20; tries++) {
+            // xorshift32, forced odd
+            seed ^= seed << 13; seed ^= seed >>> 17; seed ^= seed << 5;
+            const k = (seed | 1) >>> 0;
+            const shift = 32 - bits;
+            const slots = new Set();
+            const ok = entries.every((e) => {
+                const slot = Number((BigInt(e.selector) * BigInt(k)) & 0xffffffffn) >>> shift;
+                if (slots.has(slot)) {
+                    return false;
+                }
+                slots.add(slot);
+                e.slot = slot;
+                return true;
+            });
+            if (ok) {
+                return { bits, k, shift };
+            }
+        }
+    }
+}
+
+const { bits, k, shift } = find_hash();
+const hex = (x) => '0x' + x.toString(16).padStart(8, '0');
+
+const table = new Array(1 << bits).fill(null);
+entries.forEach((e) => { table[e.slot] = e; });
+
+const out = [];
+out.push(`// Generated by scripts/gen_dispatch.js from ${path || 'build/interface.json'}, do not edit.`);
+out.push('#include <stylus_entry.h>');
+out.push('#include <stylus_types.h>');
+out.push('#include <hostio.h>');
+out.push('');
+// the handlers of the modules left out of a build (see the Makefile) are
+// weak and null, so their selectors fall through to default_func
+for (const e of entries) {
+    out.push(`__attribute__((weak)) ArbResult ${e.name}(uint8_t *input, size_t len);`);
+}
+out.push('ArbResult default_func(void *storage, uint8_t *input, size_t len, uint8_t *value);');
+out.push('');
+out.push('typedef struct dispatch_entry {');
+out.push('    uint32_t selector;');
+out.push('    // length of the arguments, or of their heads if dynamic is set');
+out.push('    uint32_t len;');
+out.push('    uint32_t dynamic;');
+out.push('    ArbResult (*handler)(uint8_t *input, size_t len);');
+out.push('} dispatch_entry;');
+out.push('');
+out.push(`#define DISPATCH_K ${hex(k)}u`);
+out.push(`#define DISPATCH_SHIFT ${shift}`);
+out.push('');
+out.push(`static const dispatch_entry dispatch_table[${1 << bits}] = {`);
+table.forEach((e, i) => {
+    if (e) {
+        out.push(`    [${i}] = {${hex(e.selector)}, ${e.len}, ${e.dynamic ? 1 : 0}, ${e.name}}, // ${e.signature}`);
+    }
+});
+out.push('};');
+out.push('');
+out.push(`ArbResult ${source}_dispatch(uint8_t *input, size_t len) {`);
+out.push('    if (len >= 4) {');
+out.push('        uint32_t selector = ((uint32_t)input[0] << 24) | ((uint32_t)input[1] << 16)');
+out.push('                          | ((uint32_t)input[2] << 8) | (uint32_t)input[3];');
+out.push('        const dispatch_entry *e = &dispatch_table[(selector * DISPATCH_K) >> DISPATCH_SHIFT];');
+out.push('        size_t n = len - 4;');
+out.push('        if (e->handler != NULL && e->selector == selector) {');
+out.push('            if (n == e->len || (e->dynamic && n > e->len)) {');
+out.push('                return e->handler(input+4, n);');
+out.push('            }');
+out.push('            ArbResult res = {Failure, NULL, 0};');
+out.push('            return res;');
+out.push('        }');
+out.push('    }');
+out.push('');
+out.push('    // no match: fallback');
+out.push('    uint8_t value[32];');
+out.push('    msg_value(value);');
+out.push('    return default_func(NULL, input, len, value);');
+out.push('}');
+out.push('');
+out.push(`ENTRYPOINT(${source}_dispatch)`);
+
+console.log(out.join('\n'));
@@ -0,0 +1,59 @@
+// Generates the P-256 generator table in src/p256_table.c.
+// Usage:
+//   node scripts/gen_p256_table.js > src/p256_table.c
+//
+// See include/p256.h for how the table is used.
+const P = 2n ** 256n - 2n ** 224n + 2n ** 192n + 2n ** 96n - 1n;
+const A = P - 3n;
+const G = [
+    0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296n,
+    0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5n,
+];
+
+// the table's size, which must match include/p256.h
+const G_WINDOW = 8;
+
+const mod = (a) => ((a % P) + P) % P;
+
+function inv(a) {
+    // a^(p-2)
+    let r = 1n, b = mod(a), e = P - 2n;
+    for (; e > 0n; e >>= 1n) {
+        if (e & 1n) r = r * b % P;
+        b = b * b % P;
+    }
+    return r;
+}
+
+// affine points, the table never reaches the point at infinity
+function add(a, b) {
+    let l;
+    if (a[0] === b[0]) {
+        l = mod((3n * a[0] * a[0] + A) * inv(2n * a[1]));
+    } else {
+        l = mod((b[1] - a[1]) * inv(b[0] - a[0]));
+    }
+    const x = mod(l * l - a[0] - b[0]);
+    return [x, mod(l * (a[0] - x) - a[1])];
+}
+
+const limbs = (x) => [0n, 1n, 2n, 3n]
+    .map((i) => '0x' + ((x >> (64n * i)) & 0xffffffffffffffffn).toString(16).padStart(16, '0') + 'ULL')
+    .join(', ');
+
+const out = [];
+out.push('// Generated by scripts/gen_p256_table.js, do not edit.');
+out.push('#include <p256.h>');
+out.push('');
+
+// G, 3G, 5G, ... for the wNAF digits of the generator's scalar
+const odd = [];
+const g2 = add(G, G);
+for (let i = 0, p = G; i < 1 << (G_WINDOW - 2); i++, p = add(p, g2)) {
+    odd.push(p);
+}
+out.push(`const p256_affine p256_g_odd[${odd.length}] = {`);
+odd.forEach((p) => out.push(`    {{${limbs(p[0])}},\n     {${limbs(p[1])}}, false},`));
+out.push('};');
+
+console.log(out.join('\n'));
@@ -0,0 +1,234 @@
+// Generates the Poseidon constants in src/poseidon_table.c.
+// Usage:
+//   node scripts/gen_poseidon.js [max inputs] > src/poseidon_table.c
+//
+// Hashes of up to max inputs, 16 by default, get tables: all 16 take about
+// 770 kB, a contract that only hashes pairs can be built with 2.
+//
+// The constants are circomlib's: x^5 S-boxes over the BN254 scalar field,
+// 8 full rounds, the partial rounds of N_ROUNDS_P, and round constants and a
+// Cauchy MDS matrix drawn from the Grain LFSR of the Poseidon reference
+// implementation. They are rewritten for the faster partial rounds of the
+// Poseidon paper, appendix B, and checked against the plain permutation.
+// See include/poseidon.h for how the tables are used.
+const R = 21888242871839275222246405745257275088548364400416034343698204186575808495617n;
+
+// partial rounds for t = 2, 3, ..., 17
+const N_ROUNDS_F = 8;
+const N_ROUNDS_P = [56, 57, 56, 60, 60, 63, 64, 63, 60, 66, 60, 65, 70, 60, 64, 68];
+
+const mod = (a) => ((a % R) + R) % R;
+
+function pow(b, e) {
+    let r = 1n;
+    b = mod(b);
+    for (; e > 0n; e >>= 1n) {
+        if (e & 1n) r = r * b % R;
+        b = b * b % R;
+    }
+    return r;
+}
+
+const inv = (a) => pow(a, R - 2n);
+
+// the bits of the Grain LFSR, seeded with the parameters
+function grain(t, rf, rp) {
+    const bits = (v, n) => v.toString(2).padStart(n, '0').split('').map(Number);
+    const s = [
+        ...bits(1, 2),    // a prime field
+        ...bits(0, 4),    // x^alpha S-boxes
+        ...bits(254, 12), // field bits
+        ...bits(t, 12),
+        ...bits(rf, 10),
+        ...bits(rp, 10),
+        ...Array(30).fill(1),
+    ];
+    const next = () => {
+        const b = s[62] ^ s[51] ^ s[38] ^ s[23] ^ s[13] ^ s[0];
+        s.shift();
+        s.push(b);
+        return b;
+    };
+    for (let i = 0; i < 160; i++) next();
+    // self-shrinking: of every pair of bits, the second if the first is 1
+    const bit = () => {
+        while (next() === 0) next();
+        return next();
+    };
+    return () => {
+        let v = 0n;
+        for (let i = 0; i < 254; i++) v = (v << 1n) | BigInt(bit());
+        return v;
+    };
+}
+
+function params(t) {
+    const rp = N_ROUNDS_P[t - 2];
+    const field = grain(t, N_ROUNDS_F, rp);
+    const c = [];
+    for (let i = 0; i < (N_ROUNDS_F + rp) * t; i++) {
+        let v = field();
+        while (v >= R) v = field();
+        c.push(v);
+    }
+    const xy = [];
+    for (let i = 0; i < 2 * t; i++) xy.push(mod(field()));
+    const m = [];
+    for (let i = 0; i < t; i++) {
+        m.push([]);
+        for (let j = 0; j < t; j++) m[i].push(inv(xy[i] + xy[t + j]));
+    }
+    return { t, rp, c, m };
+}
+
+const mulv = (m, s) => m.map((row) => row.reduce((acc, a, j) => mod(acc + a * s[j]), 0n));
+const mulm = (a, b) => a.map((row) => b[0].map((_, j) => row.reduce((acc, x, k) => mod(acc + x * b[k][j]), 0n)));
+
+function invm(a) {
+    const n = a.length;
+    const m = a.map((row, i) => [...row, ...row.map((_, j) => (i === j ? 1n : 0n))]);
+    for (let i = 0; i < n; i++) {
+        let p = i;
+        while (m[p][i] === 0n) p++;
+        [m[i], m[p]] = [m[p], m[i]];
+        const d = inv(m[i][i]);
+        m[i] = m[i].map((x) => x * d % R);
+        for (let k = 0; k < n; k++) {
+            if (k === i || m[k][i] === 0n) continue;
+            const f = m[k][i];
+            m[k] = m[k].map((x, j) => mod(x - f * m[i][j]));
+        }
+    }
+    return m.map((row) => row.slice(n));
+}
+
+// the plain permutation
+function permute(p, s) {
+    const { t, rp, c, m } = p;
+    for (let r = 0; r < N_ROUNDS_F + rp; r++) {
+        s = s.map((a, i) => mod(a + c[r * t + i]));
+        if (r < N_ROUNDS_F / 2 || r >= N_ROUNDS_F / 2 + rp) {
+            s = s.map((a) => pow(a, 5n));
+        } else {
+            s[0] = pow(s[0], 5n);
+        }
+        s = mulv(m, s);
+    }
+    return s;
+}
+
+/*
+    The faster partial rounds:
+      - the constants a partial round adds to s[1..t-1] pass its S-box
+        unchanged, so they are moved through its MDS into the next round's,
+        and a partial round adds a single constant to s[0]
+      - with N = [[n00, v], [w, N']], N = S D for the sparse
+        S = [[n00, v N'^-1], [w, I]] and D = diag(1, N'). D commutes with the
+        partial round's S-box, so it joins the MDS of the round before, from
+        the last partial round back: the partial rounds multiply by sparse
+        matrices only, and the last full round of the first half by a dense
+        "pre" matrix.
+*/
+function optimize(p) {
+    const { t, rp, c, m } = p;
+    const first = N_ROUNDS_F / 2;
+    const rounds = [];
+    for (let r = 0; r < N_ROUNDS_F + rp; r++) rounds.push(c.slice(r * t, (r + 1) * t));
+    const partial = [];
+    for (let r = first; r < first + rp; r++) {
+        partial.push(rounds[r][0]);
+        const rest = mulv(m, [0n, ...rounds[r].slice(1)]);
+        rounds[r + 1] = rounds[r + 1].map((a, i) => mod(a + rest[i]));
+    }
+    const full = [...rounds.slice(0, first), ...rounds.slice(first + rp)].flat();
+
+    const sparse = [];
+    let n = m;
+    for (let r = rp - 1; r >= 0; r--) {
+        const nh = n.slice(1).map((row) => row.slice(1));
+        const v = n[0].slice(1);
+        const w = n.slice(1).map((row) => row[0]);
+        const nhi = invm(nh);
+        const u = nhi[0].map((_, j) => v.reduce((acc, x, k) => mod(acc + x * nhi[k][j]), 0n));
+        sparse[r] = [n[0][0], ...u, ...w];
+        const d = m.map((row, i) => row.map((_, j) => (i === 0 || j === 0 ? (i === j ? 1n : 0n) : nh[i - 1][j - 1])));
+        n = mulm(d, m);
+    }
+    return { t, rp, full, partial, sparse, mds: m, pre: n };
+}
+
+// the optimized permutation, as src/poseidon.c computes it
+function permuteFast(o, s) {
+    const { t, rp, full, partial, sparse, mds, pre } = o;
+    const half = N_ROUNDS_F / 2;
+    for (let r = 0; r < N_ROUNDS_F; r++) {
+        if (r === half) {
+            for (let i = 0; i < rp; i++) {
+                s[0] = pow(mod(s[0] + partial[i]), 5n);
+                const sp = sparse[i];
+                const s0 = s.reduce((acc, a, j) => mod(acc + sp[j] * a), 0n);
+                s = [s0, ...s.slice(1).map((a, j) => mod(a + sp[t + j] * s[0]))];
+            }
+        }
+        s = s.map((a, i) => pow(a + full[r * t + i], 5n));
+        s = mulv(r === half - 1 ? pre : mds, s);
+    }
+    return s;
+}
+
+const maxInputs = process.argv.length > 2 ? Number(process.argv[2]) : N_ROUNDS_P.length;
+if (!(maxInputs >= 1 && maxInputs <= N_ROUNDS_P.length)) {
+    throw new Error(`max inputs must be 1 to ${N_ROUNDS_P.length}`);
+}
+
+const all = [];
+for (let t = 2; t <= maxInputs + 1; t++) {
+    const p = params(t);
+    const o = optimize(p);
+    for (let k = 0; k < 3; k++) {
+        const s = Array.from({ length: t }, (_, i) => mod(BigInt(i + 1) * 0x9e3779b97f4a7c15n ** BigInt(k + 1)));
+        const a = permute(p, s), b = permuteFast(o, [...s]);
+        if (a.some((x, i) => x !== b[i])) throw new Error(`t = ${t}: the optimized rounds differ`);
+    }
+    all.push(o);
+}
+// circomlib's poseidon([1, 2])
+if (permute(params(3), [0n, 1n, 2n])[0] !== 0x115cc0f5e7d690413df64c6b9662e9cf2a3617f2743245519e19607a4417189an) {
+    throw new Error('poseidon([1, 2]) differs from circomlib');
+}
+
+// the tables hold Montgomery forms, x 2^256 mod r
+const limbs = (x) => {
+    const m = (x << 256n) % R;
+    return [0n, 1n, 2n, 3n]
+        .map((i) => '0x' + ((m >> (64n * i)) & 0xffffffffffffffffn).toString(16).padStart(16, '0') + 'ULL')
+        .join(', ');
+};
+
+const out = [];
+out.push('// Generated by scripts/gen_poseidon.js, do not edit.');
+out.push('#include <poseidon.h>');
+const table = (name, xs) => {
+    out.push('');
+    out.push(`static const u256 ${name}[${xs.length}] = {`);
+    xs.forEach((x) => out.push(`    {${limbs(x)}},`));
+    out.push('};');
+};
+for (const o of all) {
+    table(`full_${o.t}`, o.full);
+    table(`partial_${o.t}`, o.partial);
+    table(`sparse_${o.t}`, o.sparse.flat());
+    table(`mds_${o.t}`, o.mds.flat());
+    table(`pre_${o.t}`, o.pre.flat());
+}
+out.push('');
+out.push(`const int poseidon_max_inputs = ${maxInputs};`);
+out.push('');
+out.push(`const poseidon_params poseidon_widths[${maxInputs}] = {`);
+for (const o of all) {
+    const t = o.t;
+    out.push(`    {${t}, ${o.rp}, full_${t}, partial_${t}, sparse_${t}, mds_${t}, pre_${t}},`);
+}
+out.push('};');
+
+console.log(out.join('\n'));
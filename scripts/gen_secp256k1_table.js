@@ -0,0 +1,98 @@
+// Generates the secp256k1 generator tables in src/secp256k1_table.c.
+// Usage:
+//   node scripts/gen_secp256k1_table.js > src/secp256k1_table.c
+//
+// See include/secp256k1.h for how the tables are used.
+const P = 2n ** 256n - 2n ** 32n - 977n;
+const G = [
+    0x79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798n,
+    0x483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8n,
+];
+
+// the tables' sizes, which must match include/secp256k1.h
+const G_WINDOW = 6;
+const COMB_TEETH = 4;
+const COMB_BLOCKS = 2;
+
+const mod = (a) => ((a % P) + P) % P;
+
+function inv(a) {
+    // a^(p-2)
+    let r = 1n, b = mod(a), e = P - 2n;
+    for (; e > 0n; e >>= 1n) {
+        if (e & 1n) r = r * b % P;
+        b = b * b % P;
+    }
+    return r;
+}
+
+// affine points, null is the point at infinity
+function add(a, b) {
+    if (a === null) return b;
+    if (b === null) return a;
+    let l;
+    if (a[0] === b[0]) {
+        if (mod(a[1] + b[1]) === 0n) return null;
+        l = mod(3n * a[0] * a[0] * inv(2n * a[1]));
+    } else {
+        l = mod((b[1] - a[1]) * inv(b[0] - a[0]));
+    }
+    const x = mod(l * l - a[0] - b[0]);
+    return [x, mod(l * (a[0] - x) - a[1])];
+}
+
+function mul(k, a) {
+    let r = null;
+    for (; k > 0n; k >>= 1n) {
+        if (k & 1n) r = add(r, a);
+        a = add(a, a);
+    }
+    return r;
+}
+
+const limbs = (x) => [0n, 1n, 2n, 3n]
+    .map((i) => '0x' + ((x >> (64n * i)) & 0xffffffffffffffffn).toString(16).padStart(16, '0') + 'ULL')
+    .join(', ');
+
+function point(p) {
+    if (p === null) {
+        return '    {{0, 0, 0, 0}, {0, 0, 0, 0}, true},';
+    }
+    return `    {{${limbs(p[0])}},\n     {${limbs(p[1])}}, false},`;
+}
+
+const out = [];
+out.push('// Generated by scripts/gen_secp256k1_table.js, do not edit.');
+out.push('#include <secp256k1.h>');
+out.push('');
+
+// G, 3G, 5G, ... for the wNAF digits of the generator's scalar
+const odd = [];
+const g2 = add(G, G);
+for (let i = 0, p = G; i < 1 << (G_WINDOW - 2); i++, p = add(p, g2)) {
+    odd.push(p);
+}
+out.push(`const secp256k1_affine secp256k1_g_odd[${odd.length}] = {`);
+odd.forEach((p) => out.push(point(p)));
+out.push('};');
+out.push('');
+
+// comb: entry b of block k is the sum of 2^(spacing*j + k*spacing/blocks) G
+// over the bits j set in b
+const spacing = 256n / BigInt(COMB_TEETH);
+const block = spacing / BigInt(COMB_BLOCKS);
+out.push(`const secp256k1_affine secp256k1_g_comb[${COMB_BLOCKS}][${1 << COMB_TEETH}] = {`);
+for (let k = 0n; k < BigInt(COMB_BLOCKS); k++) {
+    out.push('  {');
+    for (let b = 0; b < 1 << COMB_TEETH; b++) {
+        let e = 0n;
+        for (let j = 0n; j < BigInt(COMB_TEETH); j++) {
+            if ((b >> Number(j)) & 1) e += 1n << (spacing * j + k * block);
+        }
+        out.push(point(e === 0n ? null : mul(e, G)));
+    }
+    out.push('  },');
+}
+out.push('};');
+
+console.log(out.join('\n'));
@@ -0,0 +1,65 @@
+// Encodes u256 operands in the packed format of include/packed.h.
+//
+// As a library:
+//   const { encode, literal } = require('./scripts/packed.js');
+//   const data = encode([1000n, 2n**255n]);   // Uint8Array
+//   const calldata = selector + hex(data);    // for AddPacked, BatchPacked
+//
+// From the command line, prints the packed operands as hex:
+//   node scripts/packed.js 1000 0x8000000000000000000000000000000000000000000000000000000000000000
+const PACKED_MAX_DICT = 64;
+const PACKED_DICT_REF = 0x40;
+
+// a length byte followed by the minimal big endian bytes of x
+function literal(x) {
+    x = BigInt(x);
+    if (x < 0n || x >= 1n << 256n) {
+        throw new RangeError(`${x} is not a uint256`);
+    }
+    const bytes = [];
+    for (; x > 0n; x >>= 8n) {
+        bytes.unshift(Number(x & 0xffn));
+    }
+    return [bytes.length, ...bytes];
+}
+
+// values used more than once go in the dictionary when that is shorter
+function encode(values) {
+    values = values.map(BigInt);
+
+    const uses = new Map();
+    for (const x of values) {
+        uses.set(x, (uses.get(x) || 0) + 1);
+    }
+    // a literal of n bytes costs n + 1 per use, a dictionary entry costs
+    // n + 1 once and 1 per use
+    const saving = (x) => {
+        const n = literal(x).length - 1;
+        return uses.get(x) * n - (n + 1);
+    };
+    const dict = [...uses.keys()]
+        .filter((x) => saving(x) > 0)
+        .sort((a, b) => saving(b) - saving(a))
+        .slice(0, PACKED_MAX_DICT);
+    const index = new Map(dict.map((x, i) => [x, i]));
+
+    const out = [dict.length];
+    for (const x of dict) {
+        out.push(...literal(x));
+    }
+    for (const x of values) {
+        if (index.has(x)) {
+            out.push(PACKED_DICT_REF + index.get(x));
+        } else {
+            out.push(...literal(x));
+        }
+    }
+    return Uint8Array.from(out);
+}
+
+module.exports = { encode, literal, PACKED_MAX_DICT, PACKED_DICT_REF };
+
+if (require.main === module) {
+    const data = encode(process.argv.slice(2));
+    console.log('0x' + Buffer.from(data).toString('hex'));
+}
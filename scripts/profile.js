@@ -0,0 +1,56 @@
+const fs = require('fs');
+const ethers = require('ethers');
+
+
+// Calls a function on a contract built with `make profile` and prints the ink
+// profile trailer. Usage:
+//   ADDRESS=0x... node scripts/profile.js Exp 3 255
+const endpoint = process.env.ENDPOINT;
+const address = process.env.ADDRESS;
+
+// see include/profile.h
+const sites = {
+    0x01: 'ADD', 0x02: 'MUL', 0x03: 'SUB', 0x04: 'DIV', 0x05: 'SDIV',
+    0x06: 'MOD', 0x07: 'SMOD', 0x08: 'ADDMOD', 0x09: 'MULMOD', 0x0a: 'EXP',
+    0x0b: 'SIGNEXTEND', 0x10: 'LT', 0x11: 'GT', 0x12: 'SLT', 0x13: 'SGT',
+    0x14: 'EQ', 0x15: 'ISZERO', 0x16: 'AND', 0x17: 'OR', 0x18: 'XOR',
+    0x19: 'NOT', 0x1a: 'BYTE', 0x1b: 'SHL', 0x1c: 'SHR', 0x1d: 'SAR',
+    0x1e: 'CLZ', 0x20: 'udivrem', 0x21: 'reciprocal', 0x22: 'reduce4',
+    0x23: 'exp loop', 0x24: 'ctz', 0x25: 'popcount', 0x26: 'AddArray',
+    0x27: 'MulArray', 0x28: 'MulModArray', 0x29: 'SumArray', 0x2a: 'DotMod',
+    0x2b: 'LtMask', 0x2c: 'InvModArray', 0x2d: 'AddPacked',
+    0x2e: 'EcRecover', 0x2f: 'EcVerifyBatch', 0x30: 'P256Verify',
+    0x31: 'EcAdd', 0x32: 'EcMul', 0x33: 'EcMsm', 0x34: 'EcPairing',
+    0x35: 'Poseidon',
+};
+
+async function main() {
+    const [method, ...args] = process.argv.slice(2);
+
+    const iface = JSON.parse(fs.readFileSync('build/interface.json'));
+    const abi = iface.contracts.uint256.Uint256.abi;
+    const contract = new ethers.Contract(address, abi);
+    const provider = new ethers.JsonRpcProvider(endpoint);
+
+    const calldata = contract.interface.encodeFunctionData(method, args);
+    const ret = ethers.getBytes(await provider.call({ to: address, data: calldata }));
+
+    // the last word is the number of sites, preceded by one word per site
+    const word = (i) => BigInt(ethers.hexlify(ret.slice(i*32, (i+1)*32)));
+    const n_words = ret.length / 32;
+    const n_sites = Number(word(n_words - 1));
+    const start = n_words - 1 - n_sites;
+
+    const result = ethers.hexlify(ret.slice(0, start*32));
+    console.log('result:', contract.interface.decodeFunctionResult(method, result).toArray());
+    for (let i = 0; i < n_sites; i++) {
+        const w = word(start + i);
+        const count = w >> 128n;
+        const ink = w & ((1n << 128n) - 1n);
+        if (count > 0n) {
+            console.log(`${sites[i] || i}\tcount: ${count}\tink: ${ink}`);
+        }
+    }
+}
+
+main()
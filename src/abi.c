@@ -0,0 +1,77 @@
+/*
+* Incremental ABI argument decoding
+* */
+#include <abi.h>
+
+static void read_word(u256 x, const uint8_t *word) {
+    // big endian -> little endian
+    for (int i = 0; i < 4; i++) {
+        __builtin_memcpy(&x[i], word+(24-(i*8)), 8);
+        x[i] = __builtin_bswap64(x[i]);
+    }
+}
+
+static bool read_u32(const uint8_t *word, size_t *n) {
+    // offsets and lengths are uint256s that have to fit in 32 bits
+    for (int i = 0; i < 28; i++) {
+        if (word[i] != 0) {
+            return false;
+        }
+    }
+    *n = ((size_t)word[28] << 24) | ((size_t)word[29] << 16)
+       | ((size_t)word[30] << 8) | (size_t)word[31];
+    return true;
+}
+
+void abi_init(abi_reader *r, const uint8_t *data, size_t len) {
+    r->data = data;
+    r->len = len;
+    r->head = 0;
+}
+
+bool abi_u256(abi_reader *r, u256 x) {
+    if (r->len - r->head < 32) {
+        return false;
+    }
+    read_word(x, r->data + r->head);
+    r->head += 32;
+    return true;
+}
+
+static bool read_tail(abi_reader *r, size_t size, const uint8_t **data,
+                      size_t *n) {
+    // the head of a dynamic argument is the offset of its length word, which
+    // is followed by the elements (size bytes each) of the bytes or array
+    size_t offset, count;
+    if (r->len - r->head < 32 || !read_u32(r->data + r->head, &offset)) {
+        return false;
+    }
+    if (offset > r->len - 32 || !read_u32(r->data + offset, &count)) {
+        return false;
+    }
+    if (count > (r->len - offset - 32) / size) {
+        return false;
+    }
+    r->head += 32;
+    *data = r->data + offset + 32;
+    *n = count;
+    return true;
+}
+
+bool abi_bytes(abi_reader *r, const uint8_t **data, size_t *n) {
+    return read_tail(r, 1, data, n);
+}
+
+bool abi_array(abi_reader *r, abi_words *w) {
+    return read_tail(r, 32, &w->next, &w->left);
+}
+
+bool abi_words_next(abi_words *w, u256 x) {
+    if (w->left == 0) {
+        return false;
+    }
+    read_word(x, w->next);
+    w->next += 32;
+    w->left--;
+    return true;
+}
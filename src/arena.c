@@ -0,0 +1,99 @@
+/*
+* Bump allocator over linear memory
+* */
+#include <arena.h>
+
+#define PAGE_SIZE 65536
+
+#ifdef __wasm__
+
+// provided by wasm-ld, the end of the data segment and the stack
+extern uint8_t __heap_base;
+
+static uintptr_t arena_top;
+static uintptr_t arena_end;
+
+void arena_reset(void) {
+    arena_top = (uintptr_t)&__heap_base;
+    arena_end = __builtin_wasm_memory_size(0) * PAGE_SIZE;
+}
+
+static void arena_grow(size_t size) {
+    size_t pages = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+    if (__builtin_wasm_memory_grow(0, pages) == (size_t)-1) {
+        __builtin_trap();
+    }
+    arena_end += pages * PAGE_SIZE;
+}
+
+#else
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+/*
+    Natively the arena is a reservation of address space, mapped without
+    access, that grows like linear memory by making the pages after
+    arena_end readable and writable. It never moves, so pointers and marks
+    stay valid as it grows.
+*/
+static uintptr_t arena_base;
+static uintptr_t arena_top;
+static uintptr_t arena_end;
+static size_t arena_reserved;
+
+static void arena_fail(const char *what) {
+    fprintf(stderr, "arena: %s\n", what);
+    abort();
+}
+
+// the largest reservation the system allows, from ARENA_NATIVE_RESERVE down
+__attribute__((constructor))
+static void arena_init(void) {
+    for (size_t size = ARENA_NATIVE_RESERVE; size >= ARENA_NATIVE_STEP; size /= 2) {
+        void *p = mmap(NULL, size, PROT_NONE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (p != MAP_FAILED) {
+            arena_base = arena_top = arena_end = (uintptr_t)p;
+            arena_reserved = size;
+            return;
+        }
+    }
+    arena_fail("can't reserve address space");
+}
+
+void arena_reset(void) {
+    arena_top = arena_base;
+}
+
+static void arena_grow(size_t size) {
+    size_t step = (size + ARENA_NATIVE_STEP - 1) & ~(size_t)(ARENA_NATIVE_STEP - 1);
+    if (step < size || step > arena_base + arena_reserved - arena_end) {
+        arena_fail("out of memory");
+    }
+    if (mprotect((void*)arena_end, step, PROT_READ | PROT_WRITE) != 0) {
+        arena_fail("can't commit memory");
+    }
+    arena_end += step;
+}
+
+#endif // __wasm__
+
+void *arena_alloc(size_t size) {
+    uintptr_t p = (arena_top + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1);
+    // arena_end is always aligned, so p <= arena_end
+    if (size > arena_end - p) {
+        arena_grow(size - (arena_end - p));
+    }
+    arena_top = p + size;
+    return (void*)p;
+}
+
+size_t arena_mark(void) {
+    return arena_top;
+}
+
+void arena_release(size_t mark) {
+    arena_top = mark;
+}
@@ -0,0 +1,126 @@
+/*
+* Batch programs over a small register file
+* */
+#include <batch.h>
+#include <packed.h>
+#include <profile.h>
+
+// number of register operands read by each opcode, 0 if it isn't supported
+static const u8 batch_arity[] = {
+    [OP_ADD] = 2, [OP_MUL] = 2, [OP_SUB] = 2, [OP_DIV] = 2, [OP_SDIV] = 2,
+    [OP_MOD] = 2, [OP_SMOD] = 2, [OP_ADDMOD] = 3, [OP_MULMOD] = 3,
+    [OP_EXP] = 2, [OP_SIGNEXTEND] = 2,
+
+    [OP_LT] = 2, [OP_GT] = 2, [OP_SLT] = 2, [OP_SGT] = 2, [OP_EQ] = 2,
+    [OP_ISZERO] = 1,
+
+    [OP_AND] = 2, [OP_OR] = 2, [OP_XOR] = 2, [OP_NOT] = 1, [OP_BYTE] = 2,
+    [OP_SHL] = 2, [OP_SHR] = 2, [OP_SAR] = 2, [OP_CLZ] = 1,
+};
+
+static void store_be(uint8_t *out, u256 x) {
+    // x is little endian, convert it to big endian
+    for (int i = 0; i < 4; i++) {
+        u64 word = __builtin_bswap64(x[3-i]);
+        __builtin_memcpy(out+(i*sizeof(u64)), &word, sizeof(u64));
+    }
+}
+
+static void set_bool(u256 res, bool b) {
+    clear_words(&res[0], 4);
+    res[0] = b;
+}
+
+int batch_run(const uint8_t *program, size_t len, uint8_t *out, int max_out) {
+    u256 regs[BATCH_REGISTERS];
+    clear_words(&regs[0][0], 4*BATCH_REGISTERS);
+
+    int n_out = 0;
+    size_t pc = 0;
+    while (pc < len) {
+        u8 op = program[pc++];
+
+        if (op == BATCH_LOAD) {
+            if (pc >= len || program[pc] >= BATCH_REGISTERS) {
+                return -1;
+            }
+            u8 dst = program[pc++];
+            int n = packed_literal(regs[dst], program+pc, len-pc);
+            if (n < 0) {
+                return -1;
+            }
+            pc += n;
+            continue;
+        }
+
+        if (op == BATCH_OUT) {
+            if (pc >= len || program[pc] >= BATCH_REGISTERS
+                || n_out >= max_out) {
+                return -1;
+            }
+            store_be(out+(n_out*32), regs[program[pc]]);
+            n_out++;
+            pc++;
+            continue;
+        }
+
+        u8 arity = op < sizeof(batch_arity) ? batch_arity[op] : 0;
+        if (arity == 0 || len - pc < (size_t)(arity+1)) {
+            return -1;
+        }
+        for (int i = 0; i <= arity; i++) {
+            if (program[pc+i] >= BATCH_REGISTERS) {
+                return -1;
+            }
+        }
+
+        // operands are copied so that dst may alias any of them
+        u256 x, y, z;
+        u64 *res = regs[program[pc]];
+        copy_words(&x[0], regs[program[pc+1]], 4);
+        if (arity > 1) {
+            copy_words(&y[0], regs[program[pc+2]], 4);
+        }
+        if (arity > 2) {
+            copy_words(&z[0], regs[program[pc+3]], 4);
+        }
+        pc += arity + 1;
+
+        PROFILE_BEGIN(op);
+        switch (op) {
+            // arithmetic
+            case OP_ADD:        u256_add(res, x, y); break;
+            case OP_MUL:        u256_mul(res, x, y); break;
+            case OP_SUB:        u256_sub(res, x, y); break;
+            case OP_DIV:        u256_div(res, x, y); break;
+            case OP_SDIV:       u256_sdiv(res, x, y); break;
+            case OP_MOD:        u256_mod(res, x, y); break;
+            case OP_SMOD:       u256_smod(res, x, y); break;
+            case OP_ADDMOD:     u256_add_mod(res, x, y, z); break;
+            case OP_MULMOD:     u256_mul_mod(res, x, y, z); break;
+            case OP_EXP:        u256_exp(res, x, y); break;
+            case OP_SIGNEXTEND: u256_sign_extend(res, x, y); break;
+
+            // comparison
+            case OP_LT:         set_bool(res, u256_lt(x, y)); break;
+            case OP_GT:         set_bool(res, u256_gt(x, y)); break;
+            case OP_SLT:        set_bool(res, u256_slt(x, y)); break;
+            case OP_SGT:        set_bool(res, u256_sgt(x, y)); break;
+            case OP_EQ:         set_bool(res, u256_eq(x, y)); break;
+            case OP_ISZERO:     set_bool(res, u256_is_zero(x)); break;
+
+            // bitwise
+            case OP_AND:        u256_and(res, x, y); break;
+            case OP_OR:         u256_or(res, x, y); break;
+            case OP_XOR:        u256_xor(res, x, y); break;
+            case OP_NOT:        u256_not(res, x); break;
+            case OP_BYTE:       u256_byte(res, x, y); break;
+            case OP_SHL:        u256_shl(res, x, y); break;
+            case OP_SHR:        u256_shr(res, x, y); break;
+            case OP_SAR:        u256_sar(res, x, y); break;
+            case OP_CLZ:        u256_clz(res, x); break;
+        }
+        PROFILE_END(op, op);
+    }
+    return n_out;
+}
@@ -0,0 +1,174 @@
+/*
+* Bitmaps with next set bit search
+* */
+#include <bitmap.h>
+#include <slot.h>
+
+int u256_next_set_bit_le(u256 x, int pos) {
+    // clear the bits above pos and take the highest of the rest
+    u256 m;
+    for (int i = 0; i < 4; i++) {
+        int n = pos + 1 - 64*i;
+        m[i] = n <= 0 ? 0 : n >= 64 ? x[i] : x[i] & ((1ULL << n) - 1);
+    }
+    return bit_len(m) - 1;
+}
+
+int u256_next_set_bit_ge(u256 x, int pos) {
+    for (int i = pos / 64; i < 4; i++) {
+        u64 limb = x[i];
+        if (i == pos / 64) {
+            limb &= MAX_U64 << (pos % 64);
+        }
+        if (limb != 0) {
+            return 64*i + __builtin_ctzll(limb);
+        }
+    }
+    return -1;
+}
+
+void u256_flip_bit(u256 x, int pos) {
+    x[pos / 64] ^= 1ULL << (pos % 64);
+}
+
+static bool test_bit(u256 x, int pos) {
+    return (x[pos / 64] >> (pos % 64)) & 1;
+}
+
+/*
+    The searches, given the summary and a way to load a word, so they are
+    shared by the memory and storage bitmaps. A word is only loaded when the
+    summary says it has a bit set.
+*/
+typedef void (*load_word)(const void *ctx, int w, u256 res);
+
+static int next_le(const void *ctx, load_word load, u256 summary, int index) {
+    int w = index / 256;
+    u256 word;
+    if (test_bit(summary, w)) {
+        load(ctx, w, word);
+        int r = u256_next_set_bit_le(word, index % 256);
+        if (r >= 0) {
+            return 256*w + r;
+        }
+    }
+    if (w == 0) {
+        return -1;
+    }
+    w = u256_next_set_bit_le(summary, w - 1);
+    if (w < 0) {
+        return -1;
+    }
+    load(ctx, w, word);
+    return 256*w + bit_len(word) - 1;
+}
+
+static int next_ge(const void *ctx, load_word load, u256 summary, int index) {
+    int w = index / 256;
+    u256 word;
+    if (test_bit(summary, w)) {
+        load(ctx, w, word);
+        int r = u256_next_set_bit_ge(word, index % 256);
+        if (r >= 0) {
+            return 256*w + r;
+        }
+    }
+    if (w == BITMAP_WORDS - 1) {
+        return -1;
+    }
+    w = u256_next_set_bit_ge(summary, w + 1);
+    if (w < 0) {
+        return -1;
+    }
+    load(ctx, w, word);
+    return 256*w + u256_next_set_bit_ge(word, 0);
+}
+
+/*
+    in memory
+*/
+void bitmap_init(bitmap *b) {
+    __builtin_memset(b, 0, sizeof(bitmap));
+}
+
+void bitmap_flip(bitmap *b, int index) {
+    int w = index / 256;
+    u256_flip_bit(b->words[w], index % 256);
+    if (is_zero(b->words[w]) == test_bit(b->summary, w)) {
+        u256_flip_bit(b->summary, w);
+    }
+}
+
+bool bitmap_get(bitmap *b, int index) {
+    return test_bit(b->words[index / 256], index % 256);
+}
+
+static void memory_word(const void *ctx, int w, u256 res) {
+    const u64 *word = ((const bitmap *)ctx)->words[w];
+    for (int i = 0; i < 4; i++) {
+        res[i] = word[i];
+    }
+}
+
+int bitmap_next_le(bitmap *b, int index) {
+    return next_le(b, memory_word, b->summary, index);
+}
+
+int bitmap_next_ge(bitmap *b, int index) {
+    return next_ge(b, memory_word, b->summary, index);
+}
+
+/*
+    in storage
+*/
+static void word_key(bebi32 key, const bebi32 base, int w) {
+    // key = base + 1 + w, big endian
+    u64 carry = (u64)w + 1;
+    for (int i = 31; i >= 0; i--) {
+        carry += base[i];
+        key[i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+}
+
+static void storage_word(const void *ctx, int w, u256 res) {
+    uint8_t key[32];
+    word_key(key, ctx, w);
+    slot_get(res, key);
+}
+
+void sbitmap_flip(const bebi32 base, int index) {
+    int w = index / 256;
+    uint8_t key[32];
+    u256 word;
+    word_key(key, base, w);
+    slot_get(word, key);
+    u256_flip_bit(word, index % 256);
+    slot_set(key, word);
+
+    // the summary changes when the word becomes empty or nonempty
+    u256 summary;
+    slot_get(summary, base);
+    if (is_zero(word) == test_bit(summary, w)) {
+        u256_flip_bit(summary, w);
+        slot_set(base, summary);
+    }
+}
+
+bool sbitmap_get(const bebi32 base, int index) {
+    u256 word;
+    storage_word(base, index / 256, word);
+    return test_bit(word, index % 256);
+}
+
+int sbitmap_next_le(const bebi32 base, int index) {
+    u256 summary;
+    slot_get(summary, base);
+    return next_le(base, storage_word, summary, index);
+}
+
+int sbitmap_next_ge(const bebi32 base, int index) {
+    u256 summary;
+    slot_get(summary, base);
+    return next_ge(base, storage_word, summary, index);
+}
@@ -0,0 +1,371 @@
+/*
+* BN254 G1, for the ecAdd and ecMul precompiles
+* */
+#include <bn254.h>
+#include <fields.h>
+
+#define fe_add bn254_fp_add
+#define fe_sub bn254_fp_sub
+#define fe_mul bn254_fp_mul
+#define fe_sqr bn254_fp_sqr
+#define fe_neg bn254_fp_neg
+#define fe_inv bn254_fp_inv
+#define fe_eq bn254_fp_eq
+#define fe_is_zero bn254_fp_is_zero
+
+// 3 and 1 in Montgomery form
+static const u256 curve_b = {0x7a17caa950ad28d7ULL, 0x1f6ac17ae15521b9ULL,
+                             0x334bea4e696bd284ULL, 0x2a1f6744ce179d8eULL};
+static const u256 mont_one = {0xd35d438dc58f0d9dULL, 0x0a78eb28f5c70b3dULL,
+                              0x666ea36f7879462cULL, 0x0e0a77c19a07df2fULL};
+
+static void set_infinity(bn254_g1 *r) {
+    clear_words(r->x, 4);
+    clear_words(r->y, 4);
+    r->infinity = true;
+}
+
+/*
+    affine
+*/
+// r = a + b given the slope l of the line through them
+static void add_with_slope(bn254_g1 *r, const bn254_g1 *a, const bn254_g1 *b,
+                           const u256 l) {
+    u256 x, t;
+    fe_sqr(x, l);
+    fe_sub(x, x, a->x);
+    fe_sub(x, x, b->x);
+    fe_sub(t, a->x, x);
+    fe_mul(t, l, t);
+    fe_sub(r->y, t, a->y);
+    copy_words(r->x, x, 4);
+    r->infinity = false;
+}
+
+void bn254_g1_double(bn254_g1 *r, const bn254_g1 *a) {
+    // no point has y = 0, since x^3 = -3 has no root mod p
+    if (a->infinity) {
+        set_infinity(r);
+        return;
+    }
+    // l = 3 x^2 / 2 y
+    u256 l, t;
+    fe_add(t, a->y, a->y);
+    fe_inv(t, t);
+    fe_sqr(l, a->x);
+    fe_mul(l, l, t);
+    fe_add(t, l, l);
+    fe_add(l, t, l);
+    bn254_g1 p = *a;
+    add_with_slope(r, &p, &p, l);
+}
+
+void bn254_g1_add(bn254_g1 *r, const bn254_g1 *a, const bn254_g1 *b) {
+    if (a->infinity) {
+        *r = *b;
+        return;
+    }
+    if (b->infinity) {
+        *r = *a;
+        return;
+    }
+    u256 dx, dy;
+    fe_sub(dx, b->x, a->x);
+    fe_sub(dy, b->y, a->y);
+    if (fe_is_zero(dx)) {
+        if (fe_is_zero(dy)) {
+            bn254_g1_double(r, a);
+        } else {
+            set_infinity(r);
+        }
+        return;
+    }
+    // l = (y2 - y1) / (x2 - x1)
+    fe_inv(dx, dx);
+    fe_mul(dy, dy, dx);
+    bn254_g1 pa = *a, pb = *b;
+    add_with_slope(r, &pa, &pb, dy);
+}
+
+bool bn254_g1_valid(const bn254_g1 *a) {
+    if (a->infinity) {
+        return true;
+    }
+    u256 lhs, rhs;
+    fe_sqr(lhs, a->y);
+    fe_sqr(rhs, a->x);
+    fe_mul(rhs, rhs, a->x);
+    fe_add(rhs, rhs, curve_b);
+    return fe_eq(lhs, rhs);
+}
+
+/*
+    Jacobian
+*/
+static bool is_infinity(const bn254_g1j *a) {
+    return fe_is_zero(a->z);
+}
+
+void bn254_g1j_from(bn254_g1j *r, const bn254_g1 *a) {
+    copy_words(r->x, (u64 *)a->x, 4);
+    copy_words(r->y, (u64 *)a->y, 4);
+    if (a->infinity) {
+        clear_words(r->z, 4);
+    } else {
+        copy_words(r->z, (u64 *)mont_one, 4);
+    }
+}
+
+void bn254_g1j_to(bn254_g1 *r, const bn254_g1j *a) {
+    if (is_infinity(a)) {
+        set_infinity(r);
+        return;
+    }
+    u256 zi, zi2;
+    fe_inv(zi, a->z);
+    fe_sqr(zi2, zi);
+    fe_mul(r->x, a->x, zi2);
+    fe_mul(zi2, zi2, zi);
+    fe_mul(r->y, a->y, zi2);
+    r->infinity = false;
+}
+
+void bn254_g1j_double(bn254_g1j *r, const bn254_g1j *a) {
+    // dbl-2009-l, for curves with a = 0
+    u256 A, B, C, D, E, F, t, z3;
+    fe_sqr(A, a->x);
+    fe_sqr(B, a->y);
+    fe_sqr(C, B);
+    fe_add(t, a->x, B);
+    fe_sqr(t, t);
+    fe_sub(t, t, A);
+    fe_sub(t, t, C);
+    fe_add(D, t, t);
+    fe_add(E, A, A);
+    fe_add(E, E, A);
+    fe_sqr(F, E);
+    fe_mul(z3, a->y, a->z);
+    fe_add(z3, z3, z3);
+
+    fe_add(t, D, D);
+    fe_sub(r->x, F, t);
+    fe_sub(t, D, r->x);
+    fe_mul(t, E, t);
+    fe_add(C, C, C);
+    fe_add(C, C, C);
+    fe_add(C, C, C);
+    fe_sub(r->y, t, C);
+    copy_words(r->z, z3, 4);
+}
+
+void bn254_g1j_add(bn254_g1j *r, const bn254_g1j *a, const bn254_g1j *b) {
+    // add-2007-bl
+    if (is_infinity(a)) {
+        *r = *b;
+        return;
+    }
+    if (is_infinity(b)) {
+        *r = *a;
+        return;
+    }
+    u256 z1z1, z2z2, u1, u2, s1, s2, h, rr, t;
+    fe_sqr(z1z1, a->z);
+    fe_sqr(z2z2, b->z);
+    fe_mul(u1, a->x, z2z2);
+    fe_mul(u2, b->x, z1z1);
+    fe_mul(s1, a->y, b->z);
+    fe_mul(s1, s1, z2z2);
+    fe_mul(s2, b->y, a->z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, u1);
+    fe_sub(rr, s2, s1);
+    if (fe_is_zero(h)) {
+        if (fe_is_zero(rr)) {
+            bn254_g1j_double(r, a);
+        } else {
+            clear_words(r->z, 4);
+        }
+        return;
+    }
+
+    u256 i, j, v, z3;
+    fe_add(i, h, h);
+    fe_sqr(i, i);
+    fe_mul(j, h, i);
+    fe_add(rr, rr, rr);
+    fe_mul(v, u1, i);
+    fe_add(z3, a->z, b->z);
+    fe_sqr(z3, z3);
+    fe_sub(z3, z3, z1z1);
+    fe_sub(z3, z3, z2z2);
+    fe_mul(r->z, z3, h);
+
+    fe_sqr(t, rr);
+    fe_sub(t, t, j);
+    fe_sub(t, t, v);
+    fe_sub(r->x, t, v);
+    fe_sub(t, v, r->x);
+    fe_mul(t, rr, t);
+    fe_mul(s1, s1, j);
+    fe_add(s1, s1, s1);
+    fe_sub(r->y, t, s1);
+}
+
+void bn254_g1j_add_affine(bn254_g1j *r, const bn254_g1j *a,
+                          const bn254_g1 *b) {
+    // madd-2007-bl, b has z = 1
+    if (b->infinity) {
+        *r = *a;
+        return;
+    }
+    if (is_infinity(a)) {
+        bn254_g1j_from(r, b);
+        return;
+    }
+    u256 z1z1, u2, s2, h, rr, t;
+    fe_sqr(z1z1, a->z);
+    fe_mul(u2, b->x, z1z1);
+    fe_mul(s2, b->y, a->z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, a->x);
+    fe_sub(rr, s2, a->y);
+    if (fe_is_zero(h)) {
+        if (fe_is_zero(rr)) {
+            bn254_g1j_double(r, a);
+        } else {
+            clear_words(r->z, 4);
+        }
+        return;
+    }
+
+    u256 hh, i, j, v, y1j;
+    fe_sqr(hh, h);
+    fe_add(i, hh, hh);
+    fe_add(i, i, i);
+    fe_mul(j, h, i);
+    fe_add(rr, rr, rr);
+    fe_mul(v, a->x, i);
+    fe_mul(y1j, a->y, j);
+    fe_add(y1j, y1j, y1j);
+    fe_add(r->z, a->z, h);
+    fe_sqr(r->z, r->z);
+    fe_sub(r->z, r->z, z1z1);
+    fe_sub(r->z, r->z, hh);
+
+    fe_sqr(t, rr);
+    fe_sub(t, t, j);
+    fe_sub(t, t, v);
+    fe_sub(r->x, t, v);
+    fe_sub(t, v, r->x);
+    fe_mul(t, rr, t);
+    fe_sub(r->y, t, y1j);
+}
+
+/*
+    scalar multiplication
+*/
+#define WINDOW 5
+#define TABLE (1 << (WINDOW - 2))
+
+// the digits of a scalar below r < 2^254
+#define WNAF_LEN 256
+
+void bn254_g1_mul(bn254_g1 *r, const bn254_g1 *a, const u256 k) {
+    // k mod r, every point has order r
+    u256 kk;
+    u256_mod(kk, (u64 *)k, (u64 *)bn254_fr_P);
+    if (a->infinity || is_zero(kk)) {
+        set_infinity(r);
+        return;
+    }
+
+    // the odd multiples stay Jacobian: an inversion to make them affine
+    // costs more than the general additions it would save
+    bn254_g1j odd[TABLE], a2, acc;
+    bn254_g1j_from(&odd[0], a);
+    bn254_g1j_double(&a2, &odd[0]);
+    for (int i = 1; i < TABLE; i++) {
+        bn254_g1j_add(&odd[i], &odd[i-1], &a2);
+    }
+
+    int8_t digits[WNAF_LEN] = {0};
+    int len = u256_wnaf(digits, kk, WINDOW);
+    clear_words(acc.z, 4);
+    for (int i = len - 1; i >= 0; i--) {
+        bn254_g1j_double(&acc, &acc);
+        int d = digits[i];
+        if (d != 0) {
+            bn254_g1j e = odd[(d < 0 ? -d : d) >> 1];
+            if (d < 0) {
+                fe_neg(e.y, e.y);
+            }
+            bn254_g1j_add(&acc, &acc, &e);
+        }
+    }
+    bn254_g1j_to(r, &acc);
+}
+
+/*
+    bytes
+*/
+static void load_be(u256 x, const uint8_t *in) {
+    for (int i = 0; i < 4; i++) {
+        u64 limb;
+        __builtin_memcpy(&limb, in + 24 - 8*i, 8);
+        x[i] = __builtin_bswap64(limb);
+    }
+}
+
+static void store_be(uint8_t *out, const u256 x) {
+    for (int i = 0; i < 4; i++) {
+        u64 limb = __builtin_bswap64(x[3-i]);
+        __builtin_memcpy(out + 8*i, &limb, 8);
+    }
+}
+
+bool bn254_g1_from_bytes(bn254_g1 *r, const uint8_t in[64]) {
+    u256 x, y;
+    load_be(x, in);
+    load_be(y, in + 32);
+    if (!less_than(x, (u64 *)bn254_fp_P) || !less_than(y, (u64 *)bn254_fp_P)) {
+        return false;
+    }
+    r->infinity = is_zero(x) && is_zero(y);
+    bn254_fp_from(r->x, x);
+    bn254_fp_from(r->y, y);
+    return bn254_g1_valid(r);
+}
+
+void bn254_g1_to_bytes(uint8_t out[64], const bn254_g1 *a) {
+    u256 x, y;
+    bn254_fp_to(x, a->x);
+    bn254_fp_to(y, a->y);
+    store_be(out, x);
+    store_be(out + 32, y);
+}
+
+bool bn254_ec_add(uint8_t out[64], const uint8_t *in, size_t len) {
+    uint8_t buf[128] = {0};
+    __builtin_memcpy(buf, in, len < 128 ? len : 128);
+    bn254_g1 a, b;
+    if (!bn254_g1_from_bytes(&a, buf) || !bn254_g1_from_bytes(&b, buf + 64)) {
+        return false;
+    }
+    bn254_g1_add(&a, &a, &b);
+    bn254_g1_to_bytes(out, &a);
+    return true;
+}
+
+bool bn254_ec_mul(uint8_t out[64], const uint8_t *in, size_t len) {
+    uint8_t buf[96] = {0};
+    __builtin_memcpy(buf, in, len < 96 ? len : 96);
+    bn254_g1 a;
+    u256 k;
+    if (!bn254_g1_from_bytes(&a, buf)) {
+        return false;
+    }
+    load_be(k, buf + 64);
+    bn254_g1_mul(&a, &a, k);
+    bn254_g1_to_bytes(out, &a);
+    return true;
+}
@@ -0,0 +1,324 @@
+/*
+* BN254 G1 multi-scalar multiplication, with Pippenger's buckets
+* */
+#include <bn254.h>
+#include <fields.h>
+#include <arena.h>
+
+#ifndef __wasm__
+#include <pthread.h>
+#endif
+
+#define fe_add bn254_fp_add
+#define fe_sub bn254_fp_sub
+#define fe_mul bn254_fp_mul
+#define fe_sqr bn254_fp_sqr
+#define fe_neg bn254_fp_neg
+#define fe_inv bn254_fp_inv
+#define fe_eq bn254_fp_eq
+
+// the scalars are reduced below r < 2^254
+#define SCALAR_BITS 254
+
+// additions that share one inversion
+#define BATCH 128
+
+// c = ln n + 2, with ln n as the bit length of n times ln 2. Batched affine
+// additions make the buckets cheaper than in plain Pippenger, so the window
+// is 2 bits wider than the usual ln n.
+int bn254_msm_window(size_t n) {
+    int bits = 0;
+    while ((n >> bits) > 1) {
+        bits++;
+    }
+    int c = (bits * 69 + 50) / 100 + 2;
+    return c < BN254_MSM_MIN_WINDOW ? BN254_MSM_MIN_WINDOW
+         : c > BN254_MSM_MAX_WINDOW ? BN254_MSM_MAX_WINDOW : c;
+}
+
+typedef struct msm_ctx {
+    const bn254_g1 *points;
+    const int16_t *digits; // n per window
+    size_t n;
+    int c;
+    int windows;
+    bn254_g1j *sums; // one per window
+} msm_ctx;
+
+typedef struct msm_scratch {
+    bn254_g1 *buckets;
+    uint8_t *busy;
+    uint32_t *todo;
+    uint32_t *later;
+    uint32_t bucket[BATCH];
+    bn254_g1 add[BATCH];
+    u256 den[BATCH];
+    u256 prefix[BATCH];
+    int len;
+} msm_scratch;
+
+static size_t scratch_size(const msm_ctx *ctx) {
+    size_t nb = (size_t)1 << (ctx->c - 1);
+    return sizeof(msm_scratch) + nb * (sizeof(bn254_g1) + 1)
+         + 2 * ctx->n * sizeof(uint32_t);
+}
+
+static void scratch_init(msm_scratch *s, const msm_ctx *ctx, uint8_t *mem) {
+    size_t nb = (size_t)1 << (ctx->c - 1);
+    s->buckets = (bn254_g1 *)mem;
+    mem += nb * sizeof(bn254_g1);
+    s->todo = (uint32_t *)mem;
+    mem += ctx->n * sizeof(uint32_t);
+    s->later = (uint32_t *)mem;
+    mem += ctx->n * sizeof(uint32_t);
+    s->busy = mem;
+}
+
+/*
+    Signed digits of width c: d = v - 2^c with a carry into the next window
+    when v >= 2^(c-1), which halves the buckets to |d| <= 2^(c-1).
+*/
+static void scalar_digits(int16_t *digits, size_t stride, const u256 k,
+                          int c, int windows) {
+    u256 kk;
+    u256_mod(kk, (u64 *)k, (u64 *)bn254_fr_P);
+    int carry = 0;
+    for (int w = 0; w < windows; w++) {
+        int bit = w * c;
+        u64 v = 0;
+        if (bit < 256) {
+            v = kk[bit/64] >> (bit%64);
+            if (bit%64 + c > 64 && bit/64 < 3) {
+                v |= kk[bit/64 + 1] << (64 - bit%64);
+            }
+        }
+        int d = (int)(v & (((u64)1 << c) - 1)) + carry;
+        carry = d >= (1 << (c - 1));
+        if (carry) {
+            d -= 1 << c;
+        }
+        digits[w * stride] = (int16_t)d;
+    }
+}
+
+/*
+    The batch: bucket[i] += add[i], for distinct buckets, with the
+    denominators x2 - x1 of the slopes inverted together by Montgomery's
+    trick.
+*/
+static void batch_flush(msm_scratch *s) {
+    if (s->len == 0) {
+        return;
+    }
+    for (int i = 0; i < s->len; i++) {
+        fe_sub(s->den[i], s->add[i].x, s->buckets[s->bucket[i]].x);
+    }
+    bn254_fp_inv_batch(s->den, s->den, s->len, s->prefix);
+    for (int i = 0; i < s->len; i++) {
+        bn254_g1 *b = &s->buckets[s->bucket[i]];
+        const bn254_g1 *a = &s->add[i];
+
+        // l = (y2 - y1) / (x2 - x1), x3 = l^2 - x1 - x2, y3 = l (x1 - x3) - y1
+        u256 l, x3, t;
+        fe_sub(l, a->y, b->y);
+        fe_mul(l, l, s->den[i]);
+        fe_sqr(x3, l);
+        fe_sub(x3, x3, b->x);
+        fe_sub(x3, x3, a->x);
+        fe_sub(t, b->x, x3);
+        fe_mul(t, l, t);
+        fe_sub(b->y, t, b->y);
+        copy_words(b->x, x3, 4);
+        s->busy[s->bucket[i]] = 0;
+    }
+    s->len = 0;
+}
+
+// the buckets of window w, and their sum weighted by bucket
+static void msm_window(const msm_ctx *ctx, int w, msm_scratch *s) {
+    size_t nb = (size_t)1 << (ctx->c - 1);
+    const int16_t *digits = ctx->digits + w * ctx->n;
+    for (size_t b = 0; b < nb; b++) {
+        s->buckets[b].infinity = true;
+        s->busy[b] = 0;
+    }
+    size_t todo = 0;
+    for (size_t i = 0; i < ctx->n; i++) {
+        if (digits[i] != 0) {
+            s->todo[todo++] = i;
+        }
+    }
+
+    // a point whose bucket is already in the batch waits for the next pass
+    s->len = 0;
+    while (todo > 0) {
+        size_t later = 0;
+        for (size_t j = 0; j < todo; j++) {
+            uint32_t i = s->todo[j];
+            int d = digits[i];
+            uint32_t b = (d < 0 ? -d : d) - 1;
+            if (s->busy[b]) {
+                s->later[later++] = i;
+                continue;
+            }
+            bn254_g1 p = ctx->points[i];
+            if (d < 0) {
+                fe_neg(p.y, p.y);
+            }
+            bn254_g1 *bucket = &s->buckets[b];
+            if (bucket->infinity) {
+                *bucket = p;
+            } else if (fe_eq(bucket->x, p.x)) {
+                // a double or infinity, too rare to batch
+                bn254_g1_add(bucket, bucket, &p);
+            } else {
+                s->bucket[s->len] = b;
+                s->add[s->len++] = p;
+                s->busy[b] = 1;
+                if (s->len == BATCH) {
+                    batch_flush(s);
+                }
+            }
+        }
+        batch_flush(s);
+        uint32_t *t = s->todo;
+        s->todo = s->later;
+        s->later = t;
+        todo = later;
+    }
+
+    // sum (b + 1) buckets[b] as a running sum from the top bucket down
+    bn254_g1j running, sum;
+    clear_words(running.z, 4);
+    clear_words(sum.z, 4);
+    for (size_t b = nb; b-- > 0;) {
+        bn254_g1j_add_affine(&running, &running, &s->buckets[b]);
+        bn254_g1j_add(&sum, &sum, &running);
+    }
+    ctx->sums[w] = sum;
+}
+
+static void msm_combine(bn254_g1 *r, const msm_ctx *ctx) {
+    bn254_g1j acc;
+    clear_words(acc.z, 4);
+    for (int w = ctx->windows - 1; w >= 0; w--) {
+        for (int i = 0; i < ctx->c; i++) {
+            bn254_g1j_double(&acc, &acc);
+        }
+        bn254_g1j_add(&acc, &acc, &ctx->sums[w]);
+    }
+    bn254_g1j_to(r, &acc);
+}
+
+static void msm_init(msm_ctx *ctx, const bn254_g1 *points, const u256 *scalars,
+                     size_t n) {
+    ctx->points = points;
+    ctx->n = n;
+    ctx->c = bn254_msm_window(n);
+    ctx->windows = SCALAR_BITS / ctx->c + 1;
+    int16_t *digits = arena_alloc(ctx->windows * n * sizeof(int16_t));
+    for (size_t i = 0; i < n; i++) {
+        if (points[i].infinity) {
+            for (int w = 0; w < ctx->windows; w++) {
+                digits[w * n + i] = 0;
+            }
+        } else {
+            scalar_digits(&digits[i], n, scalars[i], ctx->c, ctx->windows);
+        }
+    }
+    ctx->digits = digits;
+    ctx->sums = arena_alloc(ctx->windows * sizeof(bn254_g1j));
+}
+
+// below BN254_MSM_MIN_POINTS, one multiplication per point
+static void msm_small(bn254_g1 *r, const bn254_g1 *points, const u256 *scalars,
+                      size_t n) {
+    bn254_g1j acc;
+    clear_words(acc.z, 4);
+    for (size_t i = 0; i < n; i++) {
+        bn254_g1 m;
+        bn254_g1_mul(&m, &points[i], scalars[i]);
+        bn254_g1j_add_affine(&acc, &acc, &m);
+    }
+    bn254_g1j_to(r, &acc);
+}
+
+void bn254_g1_msm(bn254_g1 *r, const bn254_g1 *points, const u256 *scalars,
+                  size_t n) {
+    if (n < BN254_MSM_MIN_POINTS) {
+        msm_small(r, points, scalars, n);
+        return;
+    }
+    size_t mark = arena_mark();
+    msm_ctx ctx;
+    msm_init(&ctx, points, scalars, n);
+    msm_scratch *s = arena_alloc(scratch_size(&ctx));
+    scratch_init(s, &ctx, (uint8_t *)(s + 1));
+    for (int w = 0; w < ctx.windows; w++) {
+        msm_window(&ctx, w, s);
+    }
+    msm_combine(r, &ctx);
+    arena_release(mark);
+}
+
+#ifndef __wasm__
+typedef struct msm_thread {
+    pthread_t id;
+    const msm_ctx *ctx;
+    msm_scratch *scratch;
+    int first;
+    int step;
+} msm_thread;
+
+static void *msm_run(void *arg) {
+    msm_thread *t = arg;
+    for (int w = t->first; w < t->ctx->windows; w += t->step) {
+        msm_window(t->ctx, w, t->scratch);
+    }
+    return NULL;
+}
+
+void bn254_g1_msm_threads(bn254_g1 *r, const bn254_g1 *points,
+                          const u256 *scalars, size_t n, int threads) {
+    if (n < BN254_MSM_MIN_POINTS) {
+        msm_small(r, points, scalars, n);
+        return;
+    }
+    size_t mark = arena_mark();
+    msm_ctx ctx;
+    msm_init(&ctx, points, scalars, n);
+    if (threads > ctx.windows) {
+        threads = ctx.windows;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    // the arena isn't thread safe, so every thread's scratch comes first
+    msm_thread *t = arena_alloc(threads * sizeof(msm_thread));
+    for (int i = 0; i < threads; i++) {
+        t[i].ctx = &ctx;
+        t[i].scratch = arena_alloc(scratch_size(&ctx));
+        scratch_init(t[i].scratch, &ctx, (uint8_t *)(t[i].scratch + 1));
+        t[i].first = i;
+        t[i].step = threads;
+    }
+    // this thread takes the first share, and the rest run in their own
+    int started = 1;
+    for (int i = 1; i < threads; i++, started++) {
+        if (pthread_create(&t[i].id, NULL, msm_run, &t[i]) != 0) {
+            break;
+        }
+    }
+    msm_run(&t[0]);
+    for (int i = 1; i < started; i++) {
+        pthread_join(t[i].id, NULL);
+    }
+    // windows of threads that couldn't start
+    for (int i = started; i < threads; i++) {
+        msm_run(&t[i]);
+    }
+    msm_combine(r, &ctx);
+    arena_release(mark);
+}
+#endif
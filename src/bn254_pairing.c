@@ -0,0 +1,891 @@
+/*
+* BN254 optimal ate pairing, for the ecPairing precompile
+* */
+#include <bn254.h>
+#include <fields.h>
+#include <arena.h>
+
+#define fe_add bn254_fp_add
+#define fe_sub bn254_fp_sub
+#define fe_mul bn254_fp_mul
+#define fe_neg bn254_fp_neg
+#define fe_inv bn254_fp_inv
+#define fe_eq bn254_fp_eq
+#define fe_is_zero bn254_fp_is_zero
+
+// the constants are in Montgomery form
+static const u256 mont_one = {0xd35d438dc58f0d9dULL, 0x0a78eb28f5c70b3dULL,
+                              0x666ea36f7879462cULL, 0x0e0a77c19a07df2fULL};
+static const u256 half = {0x87bee7d24f060572ULL, 0xd0fd2add2f1c6ae5ULL,
+                          0x8f5f7492fcfd4f44ULL, 0x1f37631a3d9cbfacULL};
+
+// b / xi and 3 b / xi, of the twist
+static const bn254_fp2 twist_b = {
+    {0x3bf938e377b802a8ULL, 0x020b1b273633535dULL,
+     0x26b7edf049755260ULL, 0x2514c6324384a86dULL},
+    {0x38e7ecccd1dcff67ULL, 0x65f0b37d93ce0d3eULL,
+     0xd749d0dd22ac00aaULL, 0x0141b9ce4a688d4dULL}};
+static const bn254_fp2 twist_b3 = {
+    {0x3baa927cb62e0d6aULL, 0xd71e7c52d1b664fdULL,
+     0x03873e63d95d4664ULL, 0x0e75b5b1082ab8f4ULL},
+    {0xaab7c6667596fe35ULL, 0x31d21a78bb6a27baULL,
+     0x85dd7297680401ffULL, 0x03c52d6adf39a7e9ULL}};
+
+// frob1[i-1] = xi^(i (p - 1) / 6) = w^(i (p - 1)), since w^6 = xi
+static const bn254_fp2 frob1[5] = {
+    {{0xaf9ba69633144907ULL, 0xca6b1d7387afb78aULL,
+      0x11bded5ef08a2087ULL, 0x02f34d751a1f3a7cULL},
+     {0xa222ae234c492d72ULL, 0xd00f02a4565de15bULL,
+      0xdc2ff3a253dfc926ULL, 0x10a75716b3899551ULL}},
+    {{0xb5773b104563ab30ULL, 0x347f91c8a9aa6454ULL,
+      0x7a007127242e0991ULL, 0x1956bcd8118214ecULL},
+     {0x6e849f1ea0aa4757ULL, 0xaa1c7b6d89f89141ULL,
+      0xb6e713cdfae0ca3aULL, 0x26694fbb4e82ebc3ULL}},
+    {{0xe4bbdd0c2936b629ULL, 0xbb30f162e133bacbULL,
+      0x31a9d1b6f9645366ULL, 0x253570bea500f8ddULL},
+     {0xa1d77ce45ffe77c7ULL, 0x07affd117826d1dbULL,
+      0x6d16bd27bb7edc6bULL, 0x2c87200285defeccULL}},
+    {{0x7361d77f843abe92ULL, 0xa5bb2bd3273411fbULL,
+      0x9c941f314b3e2399ULL, 0x15df9cddbb9fd3ecULL},
+     {0x5dddfd154bd8c949ULL, 0x62cb29a5a4445b60ULL,
+      0x37bc870a0c7dd2b9ULL, 0x24830a9d3171f0fdULL}},
+    {{0xc970692f41690fe7ULL, 0xe240342127694b0bULL,
+      0x32bee66b83c459e8ULL, 0x12aabced0ab08841ULL},
+     {0x0d485d2340aebfa9ULL, 0x05193418ab2fcc57ULL,
+      0xd3b0a40b8a4910f5ULL, 0x2f21ebb535d2925aULL}},
+};
+
+// frob2[i-1] = xi^(i (p^2 - 1) / 6), which are in Fp
+static const u256 frob2[5] = {
+    {0xca8d800500fa1bf2ULL, 0xf0c5d61468b39769ULL,
+     0x0e201271ad0d4418ULL, 0x04290f65bad856e6ULL},
+    {0x3350c88e13e80b9cULL, 0x7dce557cdb5e56b9ULL,
+     0x6001b4b8b615564aULL, 0x2682e617020217e0ULL},
+    {0x68c3488912edefaaULL, 0x8d087f6872aabf4fULL,
+     0x51e1a24709081231ULL, 0x2259d6b14729c0faULL},
+    {0x71930c11d782e155ULL, 0xa6bb947cffbe3323ULL,
+     0xaa303344d4741444ULL, 0x2c3b3f0d26594943ULL},
+    {0x08cfc388c494f1abULL, 0x19b315148d1373d4ULL,
+     0x584e90fdcb6c0213ULL, 0x09e1685bdf2f8849ULL},
+};
+
+// the NAF digits of 6x + 2, most significant first, for the BN parameter x
+#define ATE_LEN 66
+static const int8_t ate_naf[ATE_LEN] = {
+    1, 0, -1, 0, 1, 0, 0, 0, -1, 0, -1, 0, 0, 0, -1, 0, 1, 0, -1, 0, 0, -1,
+    0, 0, 0, 0, 0, 1, 0, 0, -1, 0, 1, 0, 0, -1, 0, 0, 0, 0, -1, 0, 1, 0, 0,
+    0, -1, 0, -1, 0, 0, 1, 0, 0, 0, -1, 0, 0, -1, 0, 1, 0, 1, 0, 0, 0,
+};
+
+static const u64 bn_x = 0x44e992b44a6909f1ULL;
+
+/*
+    Fp2
+*/
+static void fp2_add(bn254_fp2 *r, const bn254_fp2 *a, const bn254_fp2 *b) {
+    fe_add(r->c0, a->c0, b->c0);
+    fe_add(r->c1, a->c1, b->c1);
+}
+
+static void fp2_sub(bn254_fp2 *r, const bn254_fp2 *a, const bn254_fp2 *b) {
+    fe_sub(r->c0, a->c0, b->c0);
+    fe_sub(r->c1, a->c1, b->c1);
+}
+
+static void fp2_neg(bn254_fp2 *r, const bn254_fp2 *a) {
+    fe_neg(r->c0, a->c0);
+    fe_neg(r->c1, a->c1);
+}
+
+static void fp2_conj(bn254_fp2 *r, const bn254_fp2 *a) {
+    copy_words(r->c0, (u64 *)a->c0, 4);
+    fe_neg(r->c1, a->c1);
+}
+
+static void fp2_mul(bn254_fp2 *r, const bn254_fp2 *a, const bn254_fp2 *b) {
+    // Karatsuba, u^2 = -1
+    u256 t0, t1, s, t;
+    fe_mul(t0, a->c0, b->c0);
+    fe_mul(t1, a->c1, b->c1);
+    fe_add(s, a->c0, a->c1);
+    fe_add(t, b->c0, b->c1);
+    fe_mul(s, s, t);
+    fe_sub(r->c0, t0, t1);
+    fe_sub(s, s, t0);
+    fe_sub(r->c1, s, t1);
+}
+
+static void fp2_sqr(bn254_fp2 *r, const bn254_fp2 *a) {
+    // (a0 + a1)(a0 - a1) + 2 a0 a1 u
+    u256 s, d, m;
+    fe_add(s, a->c0, a->c1);
+    fe_sub(d, a->c0, a->c1);
+    fe_mul(m, a->c0, a->c1);
+    fe_mul(r->c0, s, d);
+    fe_add(r->c1, m, m);
+}
+
+static void fp2_mul_fp(bn254_fp2 *r, const bn254_fp2 *a, const u256 b) {
+    fe_mul(r->c0, a->c0, b);
+    fe_mul(r->c1, a->c1, b);
+}
+
+// r = a xi = (9 a0 - a1) + (a0 + 9 a1) u
+static void fp2_mul_xi(bn254_fp2 *r, const bn254_fp2 *a) {
+    u256 t0, t1;
+    fe_add(t0, a->c0, a->c0);
+    fe_add(t0, t0, t0);
+    fe_add(t0, t0, t0);
+    fe_add(t0, t0, a->c0);
+    fe_add(t1, a->c1, a->c1);
+    fe_add(t1, t1, t1);
+    fe_add(t1, t1, t1);
+    fe_add(t1, t1, a->c1);
+    fe_sub(t0, t0, a->c1);
+    fe_add(r->c1, t1, a->c0);
+    copy_words(r->c0, t0, 4);
+}
+
+static void fp2_inv(bn254_fp2 *r, const bn254_fp2 *a) {
+    // (a0 - a1 u) / (a0^2 + a1^2)
+    u256 n, t;
+    fe_mul(n, a->c0, a->c0);
+    fe_mul(t, a->c1, a->c1);
+    fe_add(n, n, t);
+    fe_inv(n, n);
+    fe_mul(r->c0, a->c0, n);
+    fe_mul(t, a->c1, n);
+    fe_neg(r->c1, t);
+}
+
+static bool fp2_is_zero(const bn254_fp2 *a) {
+    return fe_is_zero(a->c0) && fe_is_zero(a->c1);
+}
+
+static bool fp2_eq(const bn254_fp2 *a, const bn254_fp2 *b) {
+    return fe_eq(a->c0, b->c0) && fe_eq(a->c1, b->c1);
+}
+
+/*
+    Fp6
+*/
+static void fp6_add(bn254_fp6 *r, const bn254_fp6 *a, const bn254_fp6 *b) {
+    fp2_add(&r->c0, &a->c0, &b->c0);
+    fp2_add(&r->c1, &a->c1, &b->c1);
+    fp2_add(&r->c2, &a->c2, &b->c2);
+}
+
+static void fp6_sub(bn254_fp6 *r, const bn254_fp6 *a, const bn254_fp6 *b) {
+    fp2_sub(&r->c0, &a->c0, &b->c0);
+    fp2_sub(&r->c1, &a->c1, &b->c1);
+    fp2_sub(&r->c2, &a->c2, &b->c2);
+}
+
+static void fp6_neg(bn254_fp6 *r, const bn254_fp6 *a) {
+    fp2_neg(&r->c0, &a->c0);
+    fp2_neg(&r->c1, &a->c1);
+    fp2_neg(&r->c2, &a->c2);
+}
+
+// r = a v = a2 xi + a0 v + a1 v^2
+static void fp6_mul_v(bn254_fp6 *r, const bn254_fp6 *a) {
+    bn254_fp2 t;
+    fp2_mul_xi(&t, &a->c2);
+    r->c2 = a->c1;
+    r->c1 = a->c0;
+    r->c0 = t;
+}
+
+static void fp6_mul(bn254_fp6 *r, const bn254_fp6 *a, const bn254_fp6 *b) {
+    // Karatsuba, v^3 = xi
+    bn254_fp2 t0, t1, t2, s, t, c0, c1, c2;
+    fp2_mul(&t0, &a->c0, &b->c0);
+    fp2_mul(&t1, &a->c1, &b->c1);
+    fp2_mul(&t2, &a->c2, &b->c2);
+
+    // c0 = ((a1 + a2)(b1 + b2) - t1 - t2) xi + t0
+    fp2_add(&s, &a->c1, &a->c2);
+    fp2_add(&t, &b->c1, &b->c2);
+    fp2_mul(&s, &s, &t);
+    fp2_sub(&s, &s, &t1);
+    fp2_sub(&s, &s, &t2);
+    fp2_mul_xi(&s, &s);
+    fp2_add(&c0, &s, &t0);
+
+    // c1 = (a0 + a1)(b0 + b1) - t0 - t1 + t2 xi
+    fp2_add(&s, &a->c0, &a->c1);
+    fp2_add(&t, &b->c0, &b->c1);
+    fp2_mul(&s, &s, &t);
+    fp2_sub(&s, &s, &t0);
+    fp2_sub(&s, &s, &t1);
+    fp2_mul_xi(&t, &t2);
+    fp2_add(&c1, &s, &t);
+
+    // c2 = (a0 + a2)(b0 + b2) - t0 - t2 + t1
+    fp2_add(&s, &a->c0, &a->c2);
+    fp2_add(&t, &b->c0, &b->c2);
+    fp2_mul(&s, &s, &t);
+    fp2_sub(&s, &s, &t0);
+    fp2_sub(&s, &s, &t2);
+    fp2_add(&c2, &s, &t1);
+
+    r->c0 = c0;
+    r->c1 = c1;
+    r->c2 = c2;
+}
+
+static void fp6_mul_fp2(bn254_fp6 *r, const bn254_fp6 *a, const bn254_fp2 *b) {
+    fp2_mul(&r->c0, &a->c0, b);
+    fp2_mul(&r->c1, &a->c1, b);
+    fp2_mul(&r->c2, &a->c2, b);
+}
+
+// r = a (b0 + b1 v)
+static void fp6_mul_01(bn254_fp6 *r, const bn254_fp6 *a, const bn254_fp2 *b0,
+                       const bn254_fp2 *b1) {
+    bn254_fp2 t0, t1, s, t, c0, c1, c2;
+    fp2_mul(&t0, &a->c0, b0);
+    fp2_mul(&t1, &a->c1, b1);
+
+    // c0 = ((a1 + a2) b1 - t1) xi + t0
+    fp2_add(&s, &a->c1, &a->c2);
+    fp2_mul(&s, &s, b1);
+    fp2_sub(&s, &s, &t1);
+    fp2_mul_xi(&s, &s);
+    fp2_add(&c0, &s, &t0);
+
+    // c1 = (a0 + a1)(b0 + b1) - t0 - t1
+    fp2_add(&s, &a->c0, &a->c1);
+    fp2_add(&t, b0, b1);
+    fp2_mul(&s, &s, &t);
+    fp2_sub(&s, &s, &t0);
+    fp2_sub(&c1, &s, &t1);
+
+    // c2 = (a0 + a2) b0 - t0 + t1
+    fp2_add(&s, &a->c0, &a->c2);
+    fp2_mul(&s, &s, b0);
+    fp2_sub(&s, &s, &t0);
+    fp2_add(&c2, &s, &t1);
+
+    r->c0 = c0;
+    r->c1 = c1;
+    r->c2 = c2;
+}
+
+static void fp6_inv(bn254_fp6 *r, const bn254_fp6 *a) {
+    // t0 = a0^2 - xi a1 a2, t1 = xi a2^2 - a0 a1, t2 = a1^2 - a0 a2 and
+    // a^-1 = (t0 + t1 v + t2 v^2) / (a0 t0 + xi (a2 t1 + a1 t2))
+    bn254_fp2 t0, t1, t2, s, d;
+    fp2_sqr(&t0, &a->c0);
+    fp2_mul(&s, &a->c1, &a->c2);
+    fp2_mul_xi(&s, &s);
+    fp2_sub(&t0, &t0, &s);
+    fp2_sqr(&t1, &a->c2);
+    fp2_mul_xi(&t1, &t1);
+    fp2_mul(&s, &a->c0, &a->c1);
+    fp2_sub(&t1, &t1, &s);
+    fp2_sqr(&t2, &a->c1);
+    fp2_mul(&s, &a->c0, &a->c2);
+    fp2_sub(&t2, &t2, &s);
+
+    fp2_mul(&d, &a->c2, &t1);
+    fp2_mul(&s, &a->c1, &t2);
+    fp2_add(&d, &d, &s);
+    fp2_mul_xi(&d, &d);
+    fp2_mul(&s, &a->c0, &t0);
+    fp2_add(&d, &d, &s);
+    fp2_inv(&d, &d);
+
+    fp2_mul(&r->c0, &t0, &d);
+    fp2_mul(&r->c1, &t1, &d);
+    fp2_mul(&r->c2, &t2, &d);
+}
+
+/*
+    Fp12
+*/
+void bn254_fp12_one(bn254_fp12 *r) {
+    __builtin_memset(r, 0, sizeof(*r));
+    copy_words(r->c0.c0.c0, (u64 *)mont_one, 4);
+}
+
+void bn254_fp12_mul(bn254_fp12 *r, const bn254_fp12 *a, const bn254_fp12 *b) {
+    // t0 = a0 b0, t1 = a1 b1, r = t0 + t1 v + ((a0 + a1)(b0 + b1) - t0 - t1) w
+    bn254_fp6 t0, t1, s, t;
+    fp6_mul(&t0, &a->c0, &b->c0);
+    fp6_mul(&t1, &a->c1, &b->c1);
+    fp6_add(&s, &a->c0, &a->c1);
+    fp6_add(&t, &b->c0, &b->c1);
+    fp6_mul(&s, &s, &t);
+    fp6_sub(&s, &s, &t0);
+    fp6_sub(&r->c1, &s, &t1);
+    fp6_mul_v(&t1, &t1);
+    fp6_add(&r->c0, &t0, &t1);
+}
+
+static void fp12_sqr(bn254_fp12 *r, const bn254_fp12 *a) {
+    // a0^2 + a1^2 v = (a0 + a1)(a0 + a1 v) - t - t v, with t = a0 a1
+    bn254_fp6 t, s, u;
+    fp6_mul(&t, &a->c0, &a->c1);
+    fp6_add(&s, &a->c0, &a->c1);
+    fp6_mul_v(&u, &a->c1);
+    fp6_add(&u, &u, &a->c0);
+    fp6_mul(&s, &s, &u);
+    fp6_sub(&s, &s, &t);
+    fp6_mul_v(&u, &t);
+    fp6_sub(&r->c0, &s, &u);
+    fp6_add(&r->c1, &t, &t);
+}
+
+// the p^6 power, which is the inverse in the cyclotomic subgroup
+static void fp12_conj(bn254_fp12 *r, const bn254_fp12 *a) {
+    r->c0 = a->c0;
+    fp6_neg(&r->c1, &a->c1);
+}
+
+static void fp12_inv(bn254_fp12 *r, const bn254_fp12 *a) {
+    // (a0 - a1 w) / (a0^2 - a1^2 v)
+    bn254_fp6 t, s;
+    fp6_mul(&t, &a->c0, &a->c0);
+    fp6_mul(&s, &a->c1, &a->c1);
+    fp6_mul_v(&s, &s);
+    fp6_sub(&t, &t, &s);
+    fp6_inv(&t, &t);
+    fp6_mul(&r->c0, &a->c0, &t);
+    fp6_mul(&s, &a->c1, &t);
+    fp6_neg(&r->c1, &s);
+}
+
+bool bn254_fp12_eq(const bn254_fp12 *a, const bn254_fp12 *b) {
+    const bn254_fp2 *x = &a->c0.c0, *y = &b->c0.c0;
+    for (int i = 0; i < 6; i++) {
+        if (!fp2_eq(&x[i], &y[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool bn254_fp12_is_one(const bn254_fp12 *a) {
+    bn254_fp12 one;
+    bn254_fp12_one(&one);
+    return bn254_fp12_eq(a, &one);
+}
+
+/*
+    Frobenius: a = sum g_i w^i with g_i in Fp2 is stored as
+    c0 = g0 + g2 v + g4 v^2 and c1 = g1 + g3 v + g5 v^2, so
+
+        a^p   = sum conj(g_i) frob1[i-1] w^i
+        a^p^2 = sum g_i frob2[i-1] w^i
+*/
+static void fp12_frobenius(bn254_fp12 *r, const bn254_fp12 *a) {
+    fp2_conj(&r->c0.c0, &a->c0.c0);
+    fp2_conj(&r->c0.c1, &a->c0.c1);
+    fp2_conj(&r->c0.c2, &a->c0.c2);
+    fp2_conj(&r->c1.c0, &a->c1.c0);
+    fp2_conj(&r->c1.c1, &a->c1.c1);
+    fp2_conj(&r->c1.c2, &a->c1.c2);
+    fp2_mul(&r->c0.c1, &r->c0.c1, &frob1[1]);
+    fp2_mul(&r->c0.c2, &r->c0.c2, &frob1[3]);
+    fp2_mul(&r->c1.c0, &r->c1.c0, &frob1[0]);
+    fp2_mul(&r->c1.c1, &r->c1.c1, &frob1[2]);
+    fp2_mul(&r->c1.c2, &r->c1.c2, &frob1[4]);
+}
+
+static void fp12_frobenius2(bn254_fp12 *r, const bn254_fp12 *a) {
+    r->c0.c0 = a->c0.c0;
+    fp2_mul_fp(&r->c0.c1, &a->c0.c1, frob2[1]);
+    fp2_mul_fp(&r->c0.c2, &a->c0.c2, frob2[3]);
+    fp2_mul_fp(&r->c1.c0, &a->c1.c0, frob2[0]);
+    fp2_mul_fp(&r->c1.c1, &a->c1.c1, frob2[2]);
+    fp2_mul_fp(&r->c1.c2, &a->c1.c2, frob2[4]);
+}
+
+/*
+    Squaring in the cyclotomic subgroup, where the a^(p^6 + 1) = 1 lets
+    Granger and Scott square the three Fp4 pairs (g0, g3), (g1, g4) and
+    (g2, g5) of a instead of all of it: 6 Fp2 multiplications instead of 12.
+*/
+static void fp4_sqr(bn254_fp2 *r0, bn254_fp2 *r1, const bn254_fp2 *a0,
+                    const bn254_fp2 *a1) {
+    // (a0 + a1 y)^2 with y^2 = xi
+    bn254_fp2 t, s, u;
+    fp2_mul(&t, a0, a1);
+    fp2_add(&s, a0, a1);
+    fp2_mul_xi(&u, a1);
+    fp2_add(&u, &u, a0);
+    fp2_mul(&s, &s, &u);
+    fp2_sub(&s, &s, &t);
+    fp2_mul_xi(&u, &t);
+    fp2_sub(r0, &s, &u);
+    fp2_add(r1, &t, &t);
+}
+
+// r = 3 t - 2 a
+static void cyclo_minus(bn254_fp2 *r, const bn254_fp2 *t, const bn254_fp2 *a) {
+    bn254_fp2 s;
+    fp2_sub(&s, t, a);
+    fp2_add(&s, &s, &s);
+    fp2_add(r, &s, t);
+}
+
+// r = 3 t + 2 a
+static void cyclo_plus(bn254_fp2 *r, const bn254_fp2 *t, const bn254_fp2 *a) {
+    bn254_fp2 s;
+    fp2_add(&s, t, a);
+    fp2_add(&s, &s, &s);
+    fp2_add(r, &s, t);
+}
+
+static void fp12_cyclotomic_sqr(bn254_fp12 *r, const bn254_fp12 *a) {
+    bn254_fp2 t0, t1, t2, t3, t4, t5;
+    fp4_sqr(&t0, &t1, &a->c0.c0, &a->c1.c1);
+    fp4_sqr(&t2, &t3, &a->c1.c0, &a->c0.c2);
+    fp4_sqr(&t4, &t5, &a->c0.c1, &a->c1.c2);
+
+    cyclo_minus(&r->c0.c0, &t0, &a->c0.c0);
+    cyclo_plus(&r->c1.c1, &t1, &a->c1.c1);
+    fp2_mul_xi(&t5, &t5);
+    cyclo_plus(&r->c1.c0, &t5, &a->c1.c0);
+    cyclo_minus(&r->c0.c2, &t4, &a->c0.c2);
+    cyclo_minus(&r->c0.c1, &t2, &a->c0.c1);
+    cyclo_plus(&r->c1.c2, &t3, &a->c1.c2);
+}
+
+// r = a^x, for a in the cyclotomic subgroup. x has 63 bits, and acc starts
+// at the top one
+static void fp12_exp_x(bn254_fp12 *r, const bn254_fp12 *a) {
+    bn254_fp12 acc = *a;
+    for (int i = 61; i >= 0; i--) {
+        fp12_cyclotomic_sqr(&acc, &acc);
+        if ((bn_x >> i) & 1) {
+            bn254_fp12_mul(&acc, &acc, a);
+        }
+    }
+    *r = acc;
+}
+
+void bn254_final_exp(bn254_fp12 *r, const bn254_fp12 *f) {
+    // eight fp12 of 384 bytes, reused as the chain goes, keep the frame
+    // within the contract's stack
+    bn254_fp12 g, a, b, c, d, u1, u2, u3;
+
+    // the easy part, f^((p^6 - 1)(p^2 + 1)), lands in the cyclotomic subgroup
+    fp12_conj(&a, f);
+    fp12_inv(&b, f);
+    bn254_fp12_mul(&b, &a, &b);
+    fp12_frobenius2(&a, &b);
+    bn254_fp12_mul(&g, &b, &a);
+
+    // the hard part, g^((p^4 - p^2 + 1) / r), with the addition chain of
+    // Devegili, Scott and Dahab over g^x, g^x^2 and g^x^3:
+    //   y0 = g^p g^p^2 g^p^3     y1 = 1/g             y2 = (g^x^2)^p^2
+    //   y3 = 1/(g^x)^p           y4 = 1/(g^x (g^x^2)^p)
+    //   y5 = 1/g^x^2             y6 = 1/(g^x^3 (g^x^3)^p)
+    fp12_frobenius(&a, &g);
+    fp12_frobenius2(&b, &g);
+    bn254_fp12_mul(&a, &a, &b);
+    fp12_frobenius(&b, &b);
+    bn254_fp12_mul(&a, &a, &b);                // y0
+    fp12_exp_x(&u1, &g);
+    fp12_exp_x(&u2, &u1);
+    fp12_exp_x(&u3, &u2);
+    fp12_frobenius(&b, &u1);
+    fp12_conj(&b, &b);                         // y3
+    fp12_frobenius(&c, &u2);
+    bn254_fp12_mul(&c, &u1, &c);
+    fp12_conj(&c, &c);                         // y4
+    fp12_frobenius2(&u1, &u2);                 // y2
+    fp12_conj(&u2, &u2);                       // y5
+    fp12_frobenius(&d, &u3);
+    bn254_fp12_mul(&u3, &u3, &d);
+    fp12_conj(&u3, &u3);                       // y6
+
+    // t0 = y6^2 y4 y5, t1 = y3 y5 t0, t0 = t0 y2, t1 = (t1^2 t0)^2,
+    // r = (t1 y1)^2 t1 y0
+    fp12_cyclotomic_sqr(&d, &u3);
+    bn254_fp12_mul(&d, &d, &c);
+    bn254_fp12_mul(&d, &d, &u2);
+    bn254_fp12_mul(&u3, &b, &u2);
+    bn254_fp12_mul(&u3, &u3, &d);
+    bn254_fp12_mul(&d, &d, &u1);
+    fp12_cyclotomic_sqr(&u3, &u3);
+    bn254_fp12_mul(&u3, &u3, &d);
+    fp12_cyclotomic_sqr(&u3, &u3);
+    fp12_conj(&c, &g);
+    bn254_fp12_mul(&d, &u3, &c);
+    bn254_fp12_mul(&u3, &u3, &a);
+    fp12_cyclotomic_sqr(&d, &d);
+    bn254_fp12_mul(r, &d, &u3);
+}
+
+/*
+    G2, in Jacobian coordinates for the subgroup check and multiplication
+*/
+typedef struct g2_jacobian {
+    bn254_fp2 x;
+    bn254_fp2 y;
+    bn254_fp2 z;
+} g2_jacobian;
+
+static bool on_twist(const bn254_g2 *a) {
+    bn254_fp2 lhs, rhs;
+    fp2_sqr(&lhs, &a->y);
+    fp2_sqr(&rhs, &a->x);
+    fp2_mul(&rhs, &rhs, &a->x);
+    fp2_add(&rhs, &rhs, &twist_b);
+    return fp2_eq(&lhs, &rhs);
+}
+
+static void g2_double(g2_jacobian *r, const g2_jacobian *a) {
+    // dbl-2009-l, as for G1
+    bn254_fp2 A, B, C, D, E, F, t, z3;
+    fp2_sqr(&A, &a->x);
+    fp2_sqr(&B, &a->y);
+    fp2_sqr(&C, &B);
+    fp2_add(&t, &a->x, &B);
+    fp2_sqr(&t, &t);
+    fp2_sub(&t, &t, &A);
+    fp2_sub(&t, &t, &C);
+    fp2_add(&D, &t, &t);
+    fp2_add(&E, &A, &A);
+    fp2_add(&E, &E, &A);
+    fp2_sqr(&F, &E);
+    fp2_mul(&z3, &a->y, &a->z);
+    fp2_add(&z3, &z3, &z3);
+
+    fp2_add(&t, &D, &D);
+    fp2_sub(&r->x, &F, &t);
+    fp2_sub(&t, &D, &r->x);
+    fp2_mul(&t, &E, &t);
+    fp2_add(&C, &C, &C);
+    fp2_add(&C, &C, &C);
+    fp2_add(&C, &C, &C);
+    fp2_sub(&r->y, &t, &C);
+    r->z = z3;
+}
+
+static void g2_add_affine(g2_jacobian *r, const g2_jacobian *a,
+                          const bn254_g2 *b) {
+    // madd-2007-bl
+    if (fp2_is_zero(&a->z)) {
+        r->x = b->x;
+        r->y = b->y;
+        __builtin_memset(&r->z, 0, sizeof(r->z));
+        copy_words(r->z.c0, (u64 *)mont_one, 4);
+        return;
+    }
+    bn254_fp2 z1z1, u2, s2, h, rr, t;
+    fp2_sqr(&z1z1, &a->z);
+    fp2_mul(&u2, &b->x, &z1z1);
+    fp2_mul(&s2, &b->y, &a->z);
+    fp2_mul(&s2, &s2, &z1z1);
+    fp2_sub(&h, &u2, &a->x);
+    fp2_sub(&rr, &s2, &a->y);
+    if (fp2_is_zero(&h)) {
+        if (fp2_is_zero(&rr)) {
+            g2_double(r, a);
+        } else {
+            __builtin_memset(&r->z, 0, sizeof(r->z));
+        }
+        return;
+    }
+
+    bn254_fp2 hh, i, j, v, y1j;
+    fp2_sqr(&hh, &h);
+    fp2_add(&i, &hh, &hh);
+    fp2_add(&i, &i, &i);
+    fp2_mul(&j, &h, &i);
+    fp2_add(&rr, &rr, &rr);
+    fp2_mul(&v, &a->x, &i);
+    fp2_mul(&y1j, &a->y, &j);
+    fp2_add(&y1j, &y1j, &y1j);
+    fp2_add(&r->z, &a->z, &h);
+    fp2_sqr(&r->z, &r->z);
+    fp2_sub(&r->z, &r->z, &z1z1);
+    fp2_sub(&r->z, &r->z, &hh);
+
+    fp2_sqr(&t, &rr);
+    fp2_sub(&t, &t, &j);
+    fp2_sub(&t, &t, &v);
+    fp2_sub(&r->x, &t, &v);
+    fp2_sub(&t, &v, &r->x);
+    fp2_mul(&t, &rr, &t);
+    fp2_sub(&r->y, &t, &y1j);
+}
+
+// k a with double and add, for k below 2^256
+static void g2_mul(g2_jacobian *r, const bn254_g2 *a, const u256 k) {
+    __builtin_memset(r, 0, sizeof(*r));
+    if (a->infinity) {
+        return;
+    }
+    for (int i = bit_len((u64 *)k) - 1; i >= 0; i--) {
+        g2_double(r, r);
+        if ((k[i/64] >> (i%64)) & 1) {
+            g2_add_affine(r, r, a);
+        }
+    }
+}
+
+bool bn254_g2_valid(const bn254_g2 *a) {
+    if (a->infinity) {
+        return true;
+    }
+    // unlike G1, the twist has points of other orders: a cofactor of
+    // 2p - r, so r a = 0 has to be checked
+    if (!on_twist(a)) {
+        return false;
+    }
+    g2_jacobian t;
+    g2_mul(&t, a, bn254_fr_P);
+    return fp2_is_zero(&t.z);
+}
+
+void bn254_g2_mul(bn254_g2 *r, const bn254_g2 *a, const u256 k) {
+    g2_jacobian t;
+    g2_mul(&t, a, k);
+    if (fp2_is_zero(&t.z)) {
+        __builtin_memset(r, 0, sizeof(*r));
+        r->infinity = true;
+        return;
+    }
+    bn254_fp2 zi, zi2;
+    fp2_inv(&zi, &t.z);
+    fp2_sqr(&zi2, &zi);
+    fp2_mul(&r->x, &t.x, &zi2);
+    fp2_mul(&zi2, &zi2, &zi);
+    fp2_mul(&r->y, &t.y, &zi2);
+    r->infinity = false;
+}
+
+static bool load_fp(u256 r, const uint8_t *in) {
+    u256 x;
+    for (int i = 0; i < 4; i++) {
+        u64 limb;
+        __builtin_memcpy(&limb, in + 24 - 8*i, 8);
+        x[i] = __builtin_bswap64(limb);
+    }
+    if (!less_than(x, (u64 *)bn254_fp_P)) {
+        return false;
+    }
+    bn254_fp_from(r, x);
+    return true;
+}
+
+bool bn254_g2_from_bytes(bn254_g2 *r, const uint8_t in[128]) {
+    if (!load_fp(r->x.c1, in) || !load_fp(r->x.c0, in + 32)
+        || !load_fp(r->y.c1, in + 64) || !load_fp(r->y.c0, in + 96)) {
+        return false;
+    }
+    r->infinity = fp2_is_zero(&r->x) && fp2_is_zero(&r->y);
+    return bn254_g2_valid(r);
+}
+
+/*
+    The Miller loop keeps T in homogeneous projective coordinates on the
+    twist, x = X/Z and y = Y/Z, and every step gives a line through T,
+    evaluated at P, of the sparse form
+
+        l0 + l1 w + l3 w^3 = l0 + (l1 + l3 v) w
+
+    with the formulas of Costello, Lange and Naehrig, which leave out
+    factors in Fp2 that the final exponentiation removes anyway.
+*/
+typedef struct line {
+    bn254_fp2 l0;
+    bn254_fp2 l1;
+    bn254_fp2 l3;
+} line;
+
+typedef struct miller_pair {
+    u256 px;
+    u256 py;
+    bn254_g2 q;
+    bn254_fp2 x;
+    bn254_fp2 y;
+    bn254_fp2 z;
+} miller_pair;
+
+// f = f l, with 13 Fp2 multiplications instead of the 18 of a full product
+static void mul_line(bn254_fp12 *f, const line *l) {
+    bn254_fp6 a, b, e;
+    bn254_fp2 s;
+    fp6_mul_fp2(&a, &f->c0, &l->l0);
+    fp6_mul_01(&b, &f->c1, &l->l1, &l->l3);
+    fp2_add(&s, &l->l0, &l->l1);
+    fp6_add(&e, &f->c0, &f->c1);
+    fp6_mul_01(&e, &e, &s, &l->l3);
+    fp6_sub(&e, &e, &a);
+    fp6_sub(&f->c1, &e, &b);
+    fp6_mul_v(&b, &b);
+    fp6_add(&f->c0, &a, &b);
+}
+
+// T = 2 T, and the tangent at T
+static void double_step(miller_pair *m, line *l) {
+    bn254_fp2 A, B, C, E, F, G, H, I, J, t;
+    fp2_mul(&A, &m->x, &m->y);
+    fp2_mul_fp(&A, &A, half);
+    fp2_sqr(&B, &m->y);
+    fp2_sqr(&C, &m->z);
+    fp2_mul(&E, &C, &twist_b3);
+    fp2_add(&F, &E, &E);
+    fp2_add(&F, &F, &E);
+    fp2_add(&G, &B, &F);
+    fp2_mul_fp(&G, &G, half);
+    fp2_add(&H, &m->y, &m->z);
+    fp2_sqr(&H, &H);
+    fp2_sub(&H, &H, &B);
+    fp2_sub(&H, &H, &C);
+    fp2_sub(&I, &E, &B);
+    fp2_sqr(&J, &m->x);
+
+    // X = A (B - F), Y = G^2 - 3 E^2, Z = B H
+    fp2_sub(&t, &B, &F);
+    fp2_mul(&m->x, &A, &t);
+    fp2_sqr(&t, &E);
+    fp2_add(&E, &t, &t);
+    fp2_add(&E, &E, &t);
+    fp2_sqr(&G, &G);
+    fp2_sub(&m->y, &G, &E);
+    fp2_mul(&m->z, &B, &H);
+
+    // l = -H yP + 3 J xP w + I w^3
+    u256 ny;
+    fe_neg(ny, m->py);
+    fp2_mul_fp(&l->l0, &H, ny);
+    fp2_add(&t, &J, &J);
+    fp2_add(&t, &t, &J);
+    fp2_mul_fp(&l->l1, &t, m->px);
+    l->l3 = I;
+}
+
+// T = T + q, and the line through them
+static void add_step(miller_pair *m, const bn254_g2 *q, line *l) {
+    bn254_fp2 theta, lambda, C, D, E, F, G, H, t;
+    fp2_mul(&t, &q->y, &m->z);
+    fp2_sub(&theta, &m->y, &t);
+    fp2_mul(&t, &q->x, &m->z);
+    fp2_sub(&lambda, &m->x, &t);
+    fp2_sqr(&C, &theta);
+    fp2_sqr(&D, &lambda);
+    fp2_mul(&E, &lambda, &D);
+    fp2_mul(&F, &m->z, &C);
+    fp2_mul(&G, &m->x, &D);
+    fp2_add(&H, &E, &F);
+    fp2_sub(&H, &H, &G);
+    fp2_sub(&H, &H, &G);
+
+    // X = lambda H, Y = theta (G - H) - Y E, Z = Z E
+    fp2_mul(&m->x, &lambda, &H);
+    fp2_sub(&t, &G, &H);
+    fp2_mul(&t, &theta, &t);
+    fp2_mul(&G, &m->y, &E);
+    fp2_sub(&m->y, &t, &G);
+    fp2_mul(&m->z, &m->z, &E);
+
+    // l = lambda yP - theta xP w + (theta xq - lambda yq) w^3
+    u256 nx;
+    fp2_mul_fp(&l->l0, &lambda, m->py);
+    fe_neg(nx, m->px);
+    fp2_mul_fp(&l->l1, &theta, nx);
+    fp2_mul(&t, &theta, &q->x);
+    fp2_mul(&l->l3, &lambda, &q->y);
+    fp2_sub(&l->l3, &t, &l->l3);
+}
+
+void bn254_miller_loop(bn254_fp12 *f, const bn254_g1 *p, const bn254_g2 *q,
+                       size_t n) {
+    size_t mark = arena_mark();
+    miller_pair *pairs = arena_alloc(n * sizeof(miller_pair));
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (p[i].infinity || q[i].infinity) {
+            continue;
+        }
+        miller_pair *e = &pairs[m++];
+        copy_words(e->px, (u64 *)p[i].x, 4);
+        copy_words(e->py, (u64 *)p[i].y, 4);
+        e->q = q[i];
+        e->x = q[i].x;
+        e->y = q[i].y;
+        __builtin_memset(&e->z, 0, sizeof(e->z));
+        copy_words(e->z.c0, (u64 *)mont_one, 4);
+    }
+
+    // f_{6x+2,Q}, with T = (6x + 2) Q at the end
+    bn254_fp12_one(f);
+    line l;
+    for (int i = 1; i < ATE_LEN; i++) {
+        if (i > 1) {
+            fp12_sqr(f, f);
+        }
+        for (size_t j = 0; j < m; j++) {
+            double_step(&pairs[j], &l);
+            mul_line(f, &l);
+            if (ate_naf[i] != 0) {
+                bn254_g2 e = pairs[j].q;
+                if (ate_naf[i] < 0) {
+                    fp2_neg(&e.y, &e.y);
+                }
+                add_step(&pairs[j], &e, &l);
+                mul_line(f, &l);
+            }
+        }
+    }
+
+    // the lines through T, Q1 = pi(Q) and -Q2 = -pi^2(Q), where pi is the
+    // Frobenius map carried over to the twist
+    for (size_t j = 0; j < m; j++) {
+        const bn254_g2 *e = &pairs[j].q;
+        bn254_g2 q1, q2;
+        fp2_conj(&q1.x, &e->x);
+        fp2_mul(&q1.x, &q1.x, &frob1[1]);
+        fp2_conj(&q1.y, &e->y);
+        fp2_mul(&q1.y, &q1.y, &frob1[2]);
+        fp2_mul_fp(&q2.x, &e->x, frob2[1]);
+        fp2_mul_fp(&q2.y, &e->y, frob2[2]);
+        fp2_neg(&q2.y, &q2.y);
+        add_step(&pairs[j], &q1, &l);
+        mul_line(f, &l);
+        add_step(&pairs[j], &q2, &l);
+        mul_line(f, &l);
+    }
+    arena_release(mark);
+}
+
+void bn254_pairing(bn254_fp12 *r, const bn254_g1 *p, const bn254_g2 *q) {
+    bn254_fp12 f;
+    bn254_miller_loop(&f, p, q, 1);
+    bn254_final_exp(r, &f);
+}
+
+bool bn254_pairing_check(const bn254_g1 *p, const bn254_g2 *q, size_t n) {
+    bn254_fp12 f;
+    bn254_miller_loop(&f, p, q, n);
+    bn254_final_exp(&f, &f);
+    return bn254_fp12_is_one(&f);
+}
+
+bool bn254_ec_pairing(uint8_t out[32], const uint8_t *in, size_t len) {
+    if (len % 192 != 0) {
+        return false;
+    }
+    size_t n = len / 192;
+    size_t mark = arena_mark();
+    bn254_g1 *p = arena_alloc(n * sizeof(bn254_g1));
+    bn254_g2 *q = arena_alloc(n * sizeof(bn254_g2));
+    bool ok = true;
+    for (size_t i = 0; i < n && ok; i++) {
+        ok = bn254_g1_from_bytes(&p[i], in + 192*i)
+             && bn254_g2_from_bytes(&q[i], in + 192*i + 64);
+    }
+    if (ok) {
+        __builtin_memset(out, 0, 32);
+        out[31] = bn254_pairing_check(p, q, n);
+    }
+    arena_release(mark);
+    return ok;
+}
@@ -0,0 +1,106 @@
+/*
+* Per-call cache of hostio environment reads
+* */
+#include <env.h>
+#include <hostio.h>
+
+enum env_field {
+    ENV_BLOCK_NUMBER    = 1 << 0,
+    ENV_BLOCK_TIMESTAMP = 1 << 1,
+    ENV_CHAINID         = 1 << 2,
+    ENV_BLOCK_BASEFEE   = 1 << 3,
+    ENV_TX_GAS_PRICE    = 1 << 4,
+    ENV_MSG_VALUE       = 1 << 5,
+    ENV_MSG_SENDER      = 1 << 6,
+};
+
+static struct {
+    u32 have; // env_field bits of the values below that have been read
+    u256 block_number;
+    u256 block_timestamp;
+    u256 chainid;
+    u256 block_basefee;
+    u256 tx_gas_price;
+    u256 msg_value;
+    uint8_t msg_sender[32];
+} env;
+
+void env_reset(void) {
+    env.have = 0;
+}
+
+static void set_u64(u256 x, u64 n) {
+    x[0] = n;
+    x[1] = x[2] = x[3] = 0;
+}
+
+static void read_word(u256 x, const uint8_t *word) {
+    // big endian -> little endian
+    for (int i = 0; i < 4; i++) {
+        __builtin_memcpy(&x[i], word+(24-(i*8)), 8);
+        x[i] = __builtin_bswap64(x[i]);
+    }
+}
+
+void env_block_number(u256 res) {
+    if (!(env.have & ENV_BLOCK_NUMBER)) {
+        set_u64(env.block_number, block_number());
+        env.have |= ENV_BLOCK_NUMBER;
+    }
+    copy_words(&res[0], env.block_number, 4);
+}
+
+void env_block_timestamp(u256 res) {
+    if (!(env.have & ENV_BLOCK_TIMESTAMP)) {
+        set_u64(env.block_timestamp, block_timestamp());
+        env.have |= ENV_BLOCK_TIMESTAMP;
+    }
+    copy_words(&res[0], env.block_timestamp, 4);
+}
+
+void env_chainid(u256 res) {
+    if (!(env.have & ENV_CHAINID)) {
+        set_u64(env.chainid, chainid());
+        env.have |= ENV_CHAINID;
+    }
+    copy_words(&res[0], env.chainid, 4);
+}
+
+void env_block_basefee(u256 res) {
+    if (!(env.have & ENV_BLOCK_BASEFEE)) {
+        uint8_t word[32];
+        block_basefee(word);
+        read_word(env.block_basefee, word);
+        env.have |= ENV_BLOCK_BASEFEE;
+    }
+    copy_words(&res[0], env.block_basefee, 4);
+}
+
+void env_tx_gas_price(u256 res) {
+    if (!(env.have & ENV_TX_GAS_PRICE)) {
+        uint8_t word[32];
+        tx_gas_price(word);
+        read_word(env.tx_gas_price, word);
+        env.have |= ENV_TX_GAS_PRICE;
+    }
+    copy_words(&res[0], env.tx_gas_price, 4);
+}
+
+void env_msg_value(u256 res) {
+    if (!(env.have & ENV_MSG_VALUE)) {
+        uint8_t word[32];
+        msg_value(word);
+        read_word(env.msg_value, word);
+        env.have |= ENV_MSG_VALUE;
+    }
+    copy_words(&res[0], env.msg_value, 4);
+}
+
+const uint8_t *env_msg_sender(void) {
+    if (!(env.have & ENV_MSG_SENDER)) {
+        __builtin_memset(env.msg_sender, 0, 12);
+        msg_sender(env.msg_sender+12);
+        env.have |= ENV_MSG_SENDER;
+    }
+    return env.msg_sender;
+}
@@ -1,18 +1,47 @@
 #include <stylus_types.h>
 #include <uint256.h>
+#include <uint256be.h>
+#include <uint256v.h>
+#include <abi.h>
+#include <arena.h>
+#include <batch.h>
+#include <packed.h>
+#include <interp.h>
+#include <opcodes.h>
+#include <profile.h>
+#include <secp256k1.h>
+#include <p256.h>
+#include <bn254.h>
+#include <poseidon.h>
+#include <hostio.h>
+#include <bebi.h>
 #include <uint256/Uint256.h>
 
 
 ArbResult inline nodata(ArbStatus status) {
     // return status with no data
+#ifdef INK_PROFILE
+    size_t len = 0;
+    const uint8_t *retval = profile_output(NULL, &len);
+    ArbResult res = {status, retval, len};
+#else
     ArbResult res = {status, NULL, 0};
+#endif
+    return res;
+}
+
+ArbResult inline success_len(uint8_t const *retval, size_t len) {
+    // return success with len bytes of data
+#ifdef INK_PROFILE
+    retval = profile_output(retval, &len);
+#endif
+    ArbResult res = {Success, retval, len};
     return res;
 }
 
 ArbResult inline success(uint8_t const *retval) {
     // return success with a single word
-    ArbResult res = {Success, retval , 32};
-    return res;
+    return success_len(retval, 32);
 }
 
 ArbResult default_func(void *storage, uint8_t *input, size_t len, bebi32 value)
@@ -67,13 +96,14 @@ ArbResult Add(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, y, buf_out;
+    u256 result, x, y;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, y);
 
     // perform operation
-    u256_add(result, x, y);
+    PROFILE(OP_ADD, u256_add(result, x, y));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -87,13 +117,14 @@ ArbResult Mul(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, y, buf_out;
+    u256 result, x, y;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, y);
 
     // perform operation
-    u256_mul(result, x, y);
+    PROFILE(OP_MUL, u256_mul(result, x, y));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -107,13 +138,14 @@ ArbResult Sub(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, y, buf_out;
+    u256 result, x, y;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, y);
 
     // perform operation
-    u256_sub(result, x, y);
+    PROFILE(OP_SUB, u256_sub(result, x, y));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -127,13 +159,14 @@ ArbResult Div(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, y, buf_out;
+    u256 result, x, y;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, y);
 
     // perform operation
-    u256_div(result, x, y);
+    PROFILE(OP_DIV, u256_div(result, x, y));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -147,13 +180,14 @@ ArbResult SDiv(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, y, buf_out;
+    u256 result, x, y;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, y);
 
     // perform operation
-    u256_sdiv(result, x, y);
+    PROFILE(OP_SDIV, u256_sdiv(result, x, y));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -167,13 +201,14 @@ ArbResult Mod(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    u256 result, x, m;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, m);
 
     // perform operation
-    u256_mod(result, x, m);
+    PROFILE(OP_MOD, u256_mod(result, x, m));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -187,13 +222,14 @@ ArbResult SMod(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    u256 result, x, m;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, m);
 
     // perform operation
-    u256_smod(result, x, m);
+    PROFILE(OP_SMOD, u256_smod(result, x, m));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -207,13 +243,14 @@ ArbResult AddMod(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, y, m, buf_out;
+    u256 result, x, y, m;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read3(input, x, y, m);
 
     // perform operation
-    u256_add_mod(result, x, y, m);
+    PROFILE(OP_ADDMOD, u256_add_mod(result, x, y, m));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -227,13 +264,14 @@ ArbResult MulMod(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, y, m, buf_out;
+    u256 result, x, y, m;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read3(input, x, y, m);
 
     // perform operation
-    u256_mul_mod(result, x, y, m);
+    PROFILE(OP_MULMOD, u256_mul_mod(result, x, y, m));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -247,13 +285,14 @@ ArbResult Exp(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    u256 result, x, m;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, m);
 
     // perform operation
-    u256_exp(result, x, m);
+    PROFILE(OP_EXP, u256_exp(result, x, m));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -268,13 +307,14 @@ ArbResult SignExtend(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    u256 result, x, m;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, m);
 
     // perform operation
-    u256_sign_extend(result, x, m);
+    PROFILE(OP_SIGNEXTEND, u256_sign_extend(result, x, m));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -291,148 +331,182 @@ ArbResult Lt(uint8_t *input, size_t len) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    // perform operation on the big endian words in place
+    bool r;
+    PROFILE(OP_LT, r = u256be_lt(input, input+32));
+    u256be_set_bool(input, r);
 
-    // big endian -> little endian
-    read2(input, x, m);
+    return success(input);
+}
 
-    // perform operation
-    bool r = u256_lt(x, m);
-    clear_words(&result[0], 4);
-    result[0] = r;
+ArbResult Gt(uint8_t *input, size_t len) {
+    // require input to be two evm words
+    if (len != 64) {
+        return nodata(Failure);
+    }
 
-    // convert result to big endian
-    write1(buf_out, result);
+    // perform operation on the big endian words in place
+    bool r;
+    PROFILE(OP_GT, r = u256be_gt(input, input+32));
+    u256be_set_bool(input, r);
 
-    return success((uint8_t*)buf_out);
+    return success(input);
 }
 
-ArbResult Gt(uint8_t *input, size_t len) {
+ArbResult Slt(uint8_t *input, size_t len) {
     // require input to be two evm words
     if (len != 64) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    // perform operation on the big endian words in place
+    bool r;
+    PROFILE(OP_SLT, r = u256be_slt(input, input+32));
+    u256be_set_bool(input, r);
 
-    // big endian -> little endian
-    read2(input, x, m);
+    return success(input);
+}
 
-    // perform operation
-    bool r = u256_gt(x, m);
-    clear_words(&result[0], 4);
-    result[0] = r;
+ArbResult Sgt(uint8_t *input, size_t len) {
+    // require input to be two evm words
+    if (len != 64) {
+        return nodata(Failure);
+    }
 
-    // convert result to big endian
-    write1(buf_out, result);
+    // perform operation on the big endian words in place
+    bool r;
+    PROFILE(OP_SGT, r = u256be_sgt(input, input+32));
+    u256be_set_bool(input, r);
 
-    return success((uint8_t*)buf_out);
+    return success(input);
 }
 
-ArbResult Slt(uint8_t *input, size_t len) {
+ArbResult Eq(uint8_t *input, size_t len) {
     // require input to be two evm words
     if (len != 64) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    // perform operation on the big endian words in place
+    bool r;
+    PROFILE(OP_EQ, r = u256be_eq(input, input+32));
+    u256be_set_bool(input, r);
 
-    // big endian -> little endian
-    read2(input, x, m);
+    return success(input);
+}
 
-    // perform operation
-    bool r = u256_slt(x, m);
-    clear_words(&result[0], 4);
-    result[0] = r;
+ArbResult IsZero(uint8_t *input, size_t len) {
+    // require input to be one evm word
+    if (len != 32) {
+        return nodata(Failure);
+    }
 
-    // convert result to big endian
-    write1(buf_out, result);
+    // perform operation on the big endian word in place
+    bool r;
+    PROFILE(OP_ISZERO, r = u256be_is_zero(input));
+    u256be_set_bool(input, r);
 
-    return success((uint8_t*)buf_out);
+    return success(input);
 }
 
-ArbResult Sgt(uint8_t *input, size_t len) {
+/*
+    Bitwise
+*/
+ArbResult And(uint8_t *input, size_t len) {
     // require input to be two evm words
     if (len != 64) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
-
-    // big endian -> little endian
-    read2(input, x, m);
-
-    // perform operation
-    bool r = u256_sgt(x, m);
-    clear_words(&result[0], 4);
-    result[0] = r;
+    // perform operation on the big endian words in place
+    PROFILE(OP_AND, u256be_and(input, input+32));
 
-    // convert result to big endian
-    write1(buf_out, result);
-
-    return success((uint8_t*)buf_out);
+    return success(input);
 }
 
-ArbResult Eq(uint8_t *input, size_t len) {
+ArbResult Or(uint8_t *input, size_t len) {
     // require input to be two evm words
     if (len != 64) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    // perform operation on the big endian words in place
+    PROFILE(OP_OR, u256be_or(input, input+32));
 
-    // big endian -> little endian
-    read2(input, x, m);
+    return success(input);
+}
 
-    // perform operation
-    bool r = u256_eq(x, m);
-    clear_words(&result[0], 4);
-    result[0] = r;
+ArbResult Xor(uint8_t *input, size_t len) {
+    // require input to be two evm words
+    if (len != 64) {
+        return nodata(Failure);
+    }
 
-    // convert result to big endian
-    write1(buf_out, result);
+    // perform operation on the big endian words in place
+    PROFILE(OP_XOR, u256be_xor(input, input+32));
 
-    return success((uint8_t*)buf_out);
+    return success(input);
 }
 
-ArbResult IsZero(uint8_t *input, size_t len) {
+ArbResult Not(uint8_t *input, size_t len) {
     // require input to be one evm word
     if (len != 32) {
         return nodata(Failure);
     }
 
-    u256 result, x, buf_out;
+    // perform operation on the big endian word in place
+    PROFILE(OP_NOT, u256be_not(input));
 
-    // big endian -> little endian
-    read1(input, x);
+    return success(input);
+}
 
-    // perform operation
-    bool r = u256_is_zero(x);
-    clear_words(&result[0], 4);
-    result[0] = r;
+ArbResult Byte(uint8_t *input, size_t len) {
+    // require input to be two evm words
+    if (len != 64) {
+        return nodata(Failure);
+    }
 
-    // convert result to big endian
-    write1(buf_out, result);
+    // perform operation on the big endian words in place
+    PROFILE(OP_BYTE, u256be_byte(input, input+32));
 
-    return success((uint8_t*)buf_out);
+    return success(input);
 }
 
-/*
-    Bitwise
-*/
-ArbResult And(uint8_t *input, size_t len) {
+int inline shift_bytes(const bebi32 shift) {
+    // the shift as a number of whole bytes (32 if >= 256 bits), or -1 if it
+    // isn't a multiple of 8
+    for (int i = 0; i < 31; i++) {
+        if (shift[i] != 0) {
+            return 32;
+        }
+    }
+    if ((shift[31] & 0x7) != 0) {
+        return -1;
+    }
+    return shift[31] >> 3;
+}
+
+ArbResult Shl(uint8_t *input, size_t len) {
     // require input to be two evm words
     if (len != 64) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    // shifts by whole bytes are done on the big endian words in place
+    int n = shift_bytes(input+32);
+    if (n >= 0) {
+        PROFILE(OP_SHL, u256be_shl_bytes(input, n));
+        return success(input);
+    }
+
+    u256 result, x, m;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, m);
 
     // perform operation
-    u256_and(result, x, m);
+    PROFILE(OP_SHL, u256_shl(result, x, m));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -440,19 +514,27 @@ ArbResult And(uint8_t *input, size_t len) {
     return success((uint8_t*)buf_out);
 }
 
-ArbResult Or(uint8_t *input, size_t len) {
+ArbResult Shr(uint8_t *input, size_t len) {
     // require input to be two evm words
     if (len != 64) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    // shifts by whole bytes are done on the big endian words in place
+    int n = shift_bytes(input+32);
+    if (n >= 0) {
+        PROFILE(OP_SHR, u256be_shr_bytes(input, n));
+        return success(input);
+    }
+
+    u256 result, x, m;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, m);
 
     // perform operation
-    u256_or(result, x, m);
+    PROFILE(OP_SHR, u256_shr(result, x, m));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -460,19 +542,27 @@ ArbResult Or(uint8_t *input, size_t len) {
     return success((uint8_t*)buf_out);
 }
 
-ArbResult Xor(uint8_t *input, size_t len) {
+ArbResult Sar(uint8_t *input, size_t len) {
     // require input to be two evm words
     if (len != 64) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    // shifts by whole bytes are done on the big endian words in place
+    int n = shift_bytes(input+32);
+    if (n >= 0) {
+        PROFILE(OP_SAR, u256be_sar_bytes(input, n));
+        return success(input);
+    }
+
+    u256 result, x, m;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read2(input, x, m);
 
     // perform operation
-    u256_xor(result, x, m);
+    PROFILE(OP_SAR, u256_sar(result, x, m));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -480,19 +570,23 @@ ArbResult Xor(uint8_t *input, size_t len) {
     return success((uint8_t*)buf_out);
 }
 
-ArbResult Not(uint8_t *input, size_t len) {
+/*
+    Bit counting
+*/
+ArbResult Clz(uint8_t *input, size_t len) {
     // require input to be one evm word
     if (len != 32) {
         return nodata(Failure);
     }
 
-    u256 result, x, buf_out;
+    u256 result, x;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
     read1(input, x);
 
     // perform operation
-    u256_not(result, x);
+    PROFILE(OP_CLZ, u256_clz(result, x));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -500,19 +594,20 @@ ArbResult Not(uint8_t *input, size_t len) {
     return success((uint8_t*)buf_out);
 }
 
-ArbResult Byte(uint8_t *input, size_t len) {
-    // require input to be two evm words
-    if (len != 64) {
+ArbResult Ctz(uint8_t *input, size_t len) {
+    // require input to be one evm word
+    if (len != 32) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    u256 result, x;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
-    read2(input, x, m);
+    read1(input, x);
 
     // perform operation
-    u256_byte(result, x, m);
+    PROFILE(PROF_CTZ, u256_ctz(result, x));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -520,19 +615,20 @@ ArbResult Byte(uint8_t *input, size_t len) {
     return success((uint8_t*)buf_out);
 }
 
-ArbResult Shl(uint8_t *input, size_t len) {
-    // require input to be two evm words
-    if (len != 64) {
+ArbResult Popcount(uint8_t *input, size_t len) {
+    // require input to be one evm word
+    if (len != 32) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    u256 result, x;
+    u64 *buf_out = arena_alloc(32);
 
     // big endian -> little endian
-    read2(input, x, m);
+    read1(input, x);
 
     // perform operation
-    u256_shl(result, x, m);
+    PROFILE(PROF_POPCOUNT, u256_popcount(result, x));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -540,19 +636,380 @@ ArbResult Shl(uint8_t *input, size_t len) {
     return success((uint8_t*)buf_out);
 }
 
-ArbResult Shr(uint8_t *input, size_t len) {
-    // require input to be two evm words
-    if (len != 64) {
+/*
+    Signatures
+*/
+#ifdef U256_SECP256K1
+static bool read_signature(const u256 *w, secp256k1_signature *sig) {
+    // hash, v, r, s as in the ecrecover precompile, v is 27 or 28
+    u64 v = w[1][0] - 27;
+    if (w[1][1] != 0 || w[1][2] != 0 || w[1][3] != 0 || v > 1) {
+        return false;
+    }
+    sig->v = (int)v;
+    copy_words(sig->hash, (u64 *)w[0], 4);
+    copy_words(sig->r, (u64 *)w[2], 4);
+    copy_words(sig->s, (u64 *)w[3], 4);
+    return true;
+}
+
+ArbResult EcRecover(uint8_t *input, size_t len) {
+    // require input to be four evm words
+    if (len != 128) {
         return nodata(Failure);
     }
 
-    u256 result, x, m, buf_out;
+    u256 w[4];
+    secp256k1_signature sig;
+    secp256k1_affine q;
+    read2(input, w[0], w[1]);
+    read2(input+64, w[2], w[3]);
+
+    // the address is the low 20 bytes of keccak256(x, y), or zero if the
+    // signature is invalid, like Solidity's ecrecover
+    uint8_t *out = arena_alloc(64);
+    __builtin_memset(out, 0, 32);
+    bool ok = read_signature(w, &sig);
+    PROFILE(PROF_EC_RECOVER,
+            ok = ok && secp256k1_recover(&q, sig.hash, sig.v, sig.r, sig.s));
+    if (ok) {
+        write1((u64*)out, q.x);
+        write1((u64*)(out+32), q.y);
+        native_keccak256(out, 64, out);
+        __builtin_memset(out, 0, 12);
+    }
 
-    // big endian -> little endian
-    read2(input, x, m);
+    return success(out);
+}
+
+ArbResult EcVerifyBatch(uint8_t *input, size_t len) {
+    // six words per signature: hash, v, r, s and the public key's x and y
+    abi_reader r;
+    abi_words words;
+    abi_init(&r, input, len);
+    if (!abi_array(&r, &words) || words.left % 6 != 0) {
+        return nodata(Failure);
+    }
+
+    size_t n = words.left / 6;
+    secp256k1_signature *sigs = arena_alloc(n * sizeof(secp256k1_signature));
+    bool ok = true;
+    for (size_t i = 0; i < n; i++) {
+        u256 w[6];
+        for (int j = 0; j < 6; j++) {
+            abi_words_next(&words, w[j]);
+        }
+        ok = ok && read_signature(w, &sigs[i]);
+        copy_words(sigs[i].pubkey.x, w[4], 4);
+        copy_words(sigs[i].pubkey.y, w[5], 4);
+        sigs[i].pubkey.infinity = false;
+    }
+    PROFILE(PROF_EC_VERIFY_BATCH, ok = ok && secp256k1_verify_batch(sigs, n));
+
+    uint8_t *out = arena_alloc(32);
+    u256be_set_bool(out, ok);
+    return success(out);
+}
+#endif // U256_SECP256K1
+
+#ifdef U256_P256
+ArbResult P256Verify(uint8_t *input, size_t len) {
+    // the RIP-7212 layout: hash, r, s and the public key's x and y
+    if (len != 160) {
+        return nodata(Failure);
+    }
+
+    u256 hash, r, s;
+    p256_affine q;
+    read3(input, hash, r, s);
+    read2(input+96, q.x, q.y);
+    q.infinity = false;
+
+    // 1 if the signature is valid, or no data, like the precompile
+    uint8_t *out = arena_alloc(32);
+    bool ok;
+    PROFILE(PROF_P256_VERIFY, ok = p256_verify(hash, r, s, &q));
+    if (!ok) {
+        return success_len(out, 0);
+    }
+    u256be_set_bool(out, true);
+    return success(out);
+}
+#endif // U256_P256
+
+/*
+    BN254
+*/
+#ifdef U256_BN254
+ArbResult EcAdd(uint8_t *input, size_t len) {
+    // the ecAdd precompile: x1, y1, x2, y2 -> x, y
+    uint8_t *out = arena_alloc(64);
+    bool ok;
+    PROFILE(PROF_EC_ADD, ok = bn254_ec_add(out, input, len));
+    if (!ok) {
+        return nodata(Failure);
+    }
+    return success_len(out, 64);
+}
+
+ArbResult EcMul(uint8_t *input, size_t len) {
+    // the ecMul precompile: x, y, k -> x, y
+    uint8_t *out = arena_alloc(64);
+    bool ok;
+    PROFILE(PROF_EC_MUL, ok = bn254_ec_mul(out, input, len));
+    if (!ok) {
+        return nodata(Failure);
+    }
+    return success_len(out, 64);
+}
+
+ArbResult EcMsm(uint8_t *input, size_t len) {
+    // three words per term, a point's x and y and its scalar -> x, y
+    abi_reader r;
+    abi_words words;
+    abi_init(&r, input, len);
+    if (!abi_array(&r, &words) || words.left % 3 != 0) {
+        return nodata(Failure);
+    }
+
+    size_t n = words.left / 3;
+    bn254_g1 *points = arena_alloc(n * sizeof(bn254_g1));
+    u256 *scalars = arena_alloc(n * sizeof(u256));
+    for (size_t i = 0; i < n; i++) {
+        if (!bn254_g1_from_bytes(&points[i], words.next + 96*i)) {
+            return nodata(Failure);
+        }
+        read1((uint8_t *)words.next + 96*i + 64, scalars[i]);
+    }
+    uint8_t *out = arena_alloc(64);
+    bn254_g1 sum;
+    PROFILE(PROF_EC_MSM, bn254_g1_msm(&sum, points, scalars, n));
+    bn254_g1_to_bytes(out, &sum);
+    return success_len(out, 64);
+}
+#endif // U256_BN254
+
+#ifdef U256_PAIRING
+ArbResult EcPairing(uint8_t *input, size_t len) {
+    // the ecPairing precompile's words, six per pair: G1 x, y and G2 x_im,
+    // x_re, y_im, y_re
+    abi_reader r;
+    abi_words words;
+    abi_init(&r, input, len);
+    if (!abi_array(&r, &words)) {
+        return nodata(Failure);
+    }
+    uint8_t *out = arena_alloc(32);
+    bool ok;
+    PROFILE(PROF_EC_PAIRING,
+            ok = bn254_ec_pairing(out, words.next, words.left * 32));
+    if (!ok) {
+        return nodata(Failure);
+    }
+    return success(out);
+}
+#endif // U256_PAIRING
+
+/*
+    Poseidon
+*/
+#ifdef U256_POSEIDON
+ArbResult Poseidon(uint8_t *input, size_t len) {
+    // circomlib's poseidon of 1 to poseidon_max_inputs words
+    abi_reader r;
+    abi_words words;
+    abi_init(&r, input, len);
+    if (!abi_array(&r, &words) || words.left > POSEIDON_MAX_INPUTS) {
+        return nodata(Failure);
+    }
+    u256 inputs[POSEIDON_MAX_INPUTS], h;
+    size_t n = words.left;
+    for (size_t i = 0; i < n; i++) {
+        abi_words_next(&words, inputs[i]);
+    }
+    bool ok;
+    PROFILE(PROF_POSEIDON, ok = poseidon_hash(h, inputs, n));
+    if (!ok) {
+        return nodata(Failure);
+    }
+    u64 *buf_out = arena_alloc(32);
+    write1(buf_out, h);
+    return success((uint8_t*)buf_out);
+}
+#endif // U256_POSEIDON
+
+/*
+    Batch
+*/
+ArbResult run_batch(const uint8_t *program, size_t program_len) {
+    // every output takes a two byte instruction, and they are returned as
+    // a uint256[]
+    int max_out = program_len / 2;
+    uint8_t *out = arena_alloc(64 + max_out*32);
+    int n = batch_run(program, program_len, out+64, max_out);
+    if (n < 0) {
+        return nodata(Failure);
+    }
+    bebi32_set_u32(out, 32);
+    bebi32_set_u32(out+32, n);
+
+    return success_len(out, 64 + n*32);
+}
+
+ArbResult Batch(uint8_t *input, size_t len) {
+    abi_reader r;
+    const uint8_t *program;
+    size_t program_len;
+    abi_init(&r, input, len);
+    if (!abi_bytes(&r, &program, &program_len)) {
+        return nodata(Failure);
+    }
+    return run_batch(program, program_len);
+}
+
+/*
+    Interpreter
+*/
+ArbResult Exec(uint8_t *input, size_t len) {
+    abi_reader r;
+    abi_words inputs;
+    const uint8_t *code;
+    size_t code_len;
+    abi_init(&r, input, len);
+    if (!abi_bytes(&r, &code, &code_len) || !abi_array(&r, &inputs)
+        || inputs.left > INTERP_STACK_SIZE) {
+        return nodata(Failure);
+    }
+
+    // inputs[0] starts on top of the stack
+    int n_inputs = inputs.left;
+    u256 *stack = arena_alloc(INTERP_STACK_SIZE * sizeof(u256));
+    for (int i = n_inputs - 1; i >= 0; i--) {
+        abi_words_next(&inputs, stack[i]);
+    }
+
+    int height = interp_run(code, code_len, stack, n_inputs);
+    if (height < 0) {
+        return nodata(Failure);
+    }
+
+    // the final stack is returned as a uint256[], top first
+    u64 *out = arena_alloc(64 + height*32);
+    for (int i = 0; i < height; i++) {
+        write1(out+8+(i*4), stack[height-1-i]);
+    }
+    bebi32_set_u32((uint8_t*)out, 32);
+    bebi32_set_u32((uint8_t*)(out+4), height);
+
+    return success_len((uint8_t*)out, 64 + height*32);
+}
+
+/*
+    Arrays
+*/
+bool read_array(abi_reader *r, u256v *v) {
+    // decodes a uint256[] argument straight into a struct of arrays
+    abi_words w;
+    if (!abi_array(r, &w)) {
+        return false;
+    }
+    u256v_alloc(v, w.left);
+    u256 x;
+    for (size_t i = 0; i < v->n; i++) {
+        abi_words_next(&w, x);
+        u256v_set(v, i, x);
+    }
+    return true;
+}
+
+bool read_pair(uint8_t *input, size_t len, u256v *x, u256v *y, u256 m) {
+    // two arrays of the same length, and a modulus if m isn't NULL
+    abi_reader r;
+    abi_init(&r, input, len);
+    if (!read_array(&r, x) || !read_array(&r, y) || x->n != y->n) {
+        return false;
+    }
+    return m == NULL || abi_u256(&r, m);
+}
+
+ArbResult success_array(const u256v *v) {
+    // return the array as a uint256[]
+    u64 *out = arena_alloc(64 + v->n*32);
+    u256 x;
+    for (size_t i = 0; i < v->n; i++) {
+        u256v_get(x, v, i);
+        write1(out+8+(i*4), x);
+    }
+    bebi32_set_u32((uint8_t*)out, 32);
+    bebi32_set_u32((uint8_t*)(out+4), v->n);
+
+    return success_len((uint8_t*)out, 64 + v->n*32);
+}
+
+ArbResult AddArray(uint8_t *input, size_t len) {
+    u256v x, y;
+    if (!read_pair(input, len, &x, &y, NULL)) {
+        return nodata(Failure);
+    }
+
+    // perform operation in place
+    PROFILE(PROF_ADD_ARRAY, u256v_add(&x, &x, &y));
+
+    return success_array(&x);
+}
+
+ArbResult MulArray(uint8_t *input, size_t len) {
+    u256v x, y;
+    if (!read_pair(input, len, &x, &y, NULL)) {
+        return nodata(Failure);
+    }
+
+    // perform operation in place
+    PROFILE(PROF_MUL_ARRAY, u256v_mul(&x, &x, &y));
+
+    return success_array(&x);
+}
+
+ArbResult MulModArray(uint8_t *input, size_t len) {
+    u256v x, y;
+    u256 m;
+    if (!read_pair(input, len, &x, &y, m)) {
+        return nodata(Failure);
+    }
+
+    // perform operation in place
+    PROFILE(PROF_MULMOD_ARRAY, u256v_mul_mod(&x, &x, &y, m));
+
+    return success_array(&x);
+}
+
+ArbResult InvModArray(uint8_t *input, size_t len) {
+    abi_reader r;
+    u256v x;
+    u256 m;
+    abi_init(&r, input, len);
+    if (!read_array(&r, &x) || !abi_u256(&r, m)) {
+        return nodata(Failure);
+    }
+
+    // perform operation in place, x[i] = 0 stays 0
+    PROFILE(PROF_INVMOD_ARRAY, u256v_inv_mod(&x, &x, m));
+
+    return success_array(&x);
+}
+
+ArbResult SumArray(uint8_t *input, size_t len) {
+    abi_reader r;
+    u256v x;
+    u256 result;
+    abi_init(&r, input, len);
+    if (!read_array(&r, &x)) {
+        return nodata(Failure);
+    }
+    u64 *buf_out = arena_alloc(32);
 
     // perform operation
-    u256_shr(result, x, m);
+    PROFILE(PROF_SUM_ARRAY, u256v_sum(result, &x));
 
     // convert result to big endian
     write1(buf_out, result);
@@ -560,22 +1017,70 @@ ArbResult Shr(uint8_t *input, size_t len) {
     return success((uint8_t*)buf_out);
 }
 
-ArbResult Sar(uint8_t *input, size_t len) {
-    // require input to be two evm words
-    if (len != 64) {
+ArbResult DotMod(uint8_t *input, size_t len) {
+    u256v x, y;
+    u256 m, result;
+    if (!read_pair(input, len, &x, &y, m)) {
         return nodata(Failure);
     }
+    u64 *buf_out = arena_alloc(32);
 
-    u256 result, x, m, buf_out;
+    // perform operation
+    PROFILE(PROF_DOT_MOD, u256v_dot_mod(result, &x, &y, m));
 
-    // big endian -> little endian
-    read2(input, x, m);
+    // convert result to big endian
+    write1(buf_out, result);
+
+    return success((uint8_t*)buf_out);
+}
+
+ArbResult LtMask(uint8_t *input, size_t len) {
+    u256v x, y;
+    if (!read_pair(input, len, &x, &y, NULL)) {
+        return nodata(Failure);
+    }
+
+    // bit i of the uint256[] result is set if x[i] < y[i]
+    size_t n_words = (x.n + 255) / 256;
+    u64 *mask = arena_alloc(n_words*32);
+    clear_words(mask, n_words*4);
+    PROFILE(PROF_LT_MASK, u256v_lt_mask(mask, &x, &y));
+
+    u64 *out = arena_alloc(64 + n_words*32);
+    for (size_t i = 0; i < n_words; i++) {
+        write1(out+8+(i*4), mask+(i*4));
+    }
+    bebi32_set_u32((uint8_t*)out, 32);
+    bebi32_set_u32((uint8_t*)(out+4), n_words);
+
+    return success_len((uint8_t*)out, 64 + n_words*32);
+}
+
+/*
+    Packed
+
+    These take the rest of the calldata after the selector as is, rather than
+    ABI encoded, see packed.h.
+*/
+ArbResult AddPacked(uint8_t *input, size_t len) {
+    packed_reader r;
+    u256 result, x, y;
+    if (packed_init(&r, input, len) < 0 || packed_next(&r, x) < 0
+        || packed_next(&r, y) < 0 || !packed_done(&r)) {
+        return nodata(Failure);
+    }
+    u64 *buf_out = arena_alloc(32);
 
     // perform operation
-    u256_sar(result, x, m);
+    PROFILE(PROF_ADD_PACKED, u256_add(result, x, y));
 
     // convert result to big endian
     write1(buf_out, result);
 
     return success((uint8_t*)buf_out);
-}
\ No newline at end of file
+}
+
+ArbResult BatchPacked(uint8_t *input, size_t len) {
+    // the calldata is the program
+    return run_batch(input, len);
+}
@@ -0,0 +1,188 @@
+/*
+* EVM bytecode interpreter over u256
+* */
+#include <interp.h>
+#include <arena.h>
+#include <profile.h>
+
+/*
+    The decoded program is a stream of handler addresses. A PUSH handler is
+    followed by the four little endian words of its immediate.
+*/
+typedef union insn {
+    const void *op;
+    u64 word;
+} insn;
+
+int interp_run(const uint8_t *code, size_t len, u256 *stack, int height) {
+    static const void *dispatch[256] = {
+        [0 ... 255] = &&op_invalid,
+
+        [OP_STOP] = &&op_stop,
+
+        [OP_ADD] = &&op_add, [OP_MUL] = &&op_mul, [OP_SUB] = &&op_sub,
+        [OP_DIV] = &&op_div, [OP_SDIV] = &&op_sdiv, [OP_MOD] = &&op_mod,
+        [OP_SMOD] = &&op_smod, [OP_ADDMOD] = &&op_addmod,
+        [OP_MULMOD] = &&op_mulmod, [OP_EXP] = &&op_exp,
+        [OP_SIGNEXTEND] = &&op_signextend,
+
+        [OP_LT] = &&op_lt, [OP_GT] = &&op_gt, [OP_SLT] = &&op_slt,
+        [OP_SGT] = &&op_sgt, [OP_EQ] = &&op_eq, [OP_ISZERO] = &&op_iszero,
+
+        [OP_AND] = &&op_and, [OP_OR] = &&op_or, [OP_XOR] = &&op_xor,
+        [OP_NOT] = &&op_not, [OP_BYTE] = &&op_byte, [OP_SHL] = &&op_shl,
+        [OP_SHR] = &&op_shr, [OP_SAR] = &&op_sar, [OP_CLZ] = &&op_clz,
+
+        [OP_POP] = &&op_pop,
+        [OP_PUSH0] = &&op_push0,
+        [OP_PUSH1 ... OP_PUSH32] = &&op_push,
+        [OP_DUP1 ... OP_DUP16] = &&op_dup,
+        [OP_SWAP1 ... OP_SWAP16] = &&op_swap,
+    };
+
+    if (height < 0 || height > INTERP_STACK_SIZE) {
+        return -1;
+    }
+
+    /*
+        Decode
+    */
+    size_t mark = arena_mark();
+    // worst case is a code of PUSH1s, five entries per two bytes, plus a STOP
+    insn *decoded = arena_alloc(((len*5)/2 + 1) * sizeof(insn));
+    insn *ip = decoded;
+    for (size_t pc = 0; pc < len; pc++) {
+        u8 op = code[pc];
+        ip->op = dispatch[op];
+        if (op >= OP_DUP1 && op <= OP_DUP16) {
+            // DUPn and SWAPn carry n in the following entry
+            ip++;
+            ip->word = op - OP_DUP1 + 1;
+        } else if (op >= OP_SWAP1 && op <= OP_SWAP16) {
+            ip++;
+            ip->word = op - OP_SWAP1 + 1;
+        } else if (op >= OP_PUSH1 && op <= OP_PUSH32) {
+            // big endian immediate -> little endian words
+            int n = op - OP_PUSH0;
+            if (len - pc - 1 < (size_t)n) {
+                arena_release(mark);
+                return -1;
+            }
+            u256 x;
+            clear_words(&x[0], 4);
+            for (int i = 0; i < n; i++) {
+                int k = n - 1 - i;
+                x[k/8] |= ((u64)code[pc+1+i]) << ((k&7)*8);
+            }
+            for (int i = 0; i < 4; i++) {
+                ip++;
+                ip->word = x[i];
+            }
+            pc += n;
+        }
+        ip++;
+    }
+    ip->op = &&op_stop;
+
+    /*
+        Execute
+    */
+    u256 *sp = stack + height; // one past the top of the stack
+    u256 *const limit = stack + INTERP_STACK_SIZE;
+    u256 t;
+    ip = decoded;
+
+#define NEXT goto *(ip++)->op
+#define NEED(n) if (sp - stack < (n)) goto error
+// pops n operands and writes t, computed from them, into the new top
+#define RESULT(n) sp -= (n) - 1; copy_words(sp[-1], &t[0], 4); NEXT
+#define BOOL(n) t[1] = t[2] = t[3] = 0; RESULT(n)
+
+    NEXT;
+
+op_add:        NEED(2); PROFILE(OP_ADD, u256_add(t, sp[-1], sp[-2])); RESULT(2);
+op_mul:        NEED(2); PROFILE(OP_MUL, u256_mul(t, sp[-1], sp[-2])); RESULT(2);
+op_sub:        NEED(2); PROFILE(OP_SUB, u256_sub(t, sp[-1], sp[-2])); RESULT(2);
+op_div:        NEED(2); PROFILE(OP_DIV, u256_div(t, sp[-1], sp[-2])); RESULT(2);
+op_sdiv:       NEED(2); PROFILE(OP_SDIV, u256_sdiv(t, sp[-1], sp[-2])); RESULT(2);
+op_mod:        NEED(2); PROFILE(OP_MOD, u256_mod(t, sp[-1], sp[-2])); RESULT(2);
+op_smod:       NEED(2); PROFILE(OP_SMOD, u256_smod(t, sp[-1], sp[-2])); RESULT(2);
+op_addmod:     NEED(3); PROFILE(OP_ADDMOD, u256_add_mod(t, sp[-1], sp[-2], sp[-3])); RESULT(3);
+op_mulmod:     NEED(3); PROFILE(OP_MULMOD, u256_mul_mod(t, sp[-1], sp[-2], sp[-3])); RESULT(3);
+op_exp:        NEED(2); PROFILE(OP_EXP, u256_exp(t, sp[-1], sp[-2])); RESULT(2);
+op_signextend: NEED(2); PROFILE(OP_SIGNEXTEND, u256_sign_extend(t, sp[-2], sp[-1])); RESULT(2);
+
+op_lt:         NEED(2); PROFILE(OP_LT, t[0] = u256_lt(sp[-1], sp[-2])); BOOL(2);
+op_gt:         NEED(2); PROFILE(OP_GT, t[0] = u256_gt(sp[-1], sp[-2])); BOOL(2);
+op_slt:        NEED(2); PROFILE(OP_SLT, t[0] = u256_slt(sp[-1], sp[-2])); BOOL(2);
+op_sgt:        NEED(2); PROFILE(OP_SGT, t[0] = u256_sgt(sp[-1], sp[-2])); BOOL(2);
+op_eq:         NEED(2); PROFILE(OP_EQ, t[0] = u256_eq(sp[-1], sp[-2])); BOOL(2);
+op_iszero:     NEED(1); PROFILE(OP_ISZERO, t[0] = u256_is_zero(sp[-1])); BOOL(1);
+
+op_and:        NEED(2); PROFILE(OP_AND, u256_and(t, sp[-1], sp[-2])); RESULT(2);
+op_or:         NEED(2); PROFILE(OP_OR, u256_or(t, sp[-1], sp[-2])); RESULT(2);
+op_xor:        NEED(2); PROFILE(OP_XOR, u256_xor(t, sp[-1], sp[-2])); RESULT(2);
+op_not:        NEED(1); PROFILE(OP_NOT, u256_not(t, sp[-1])); RESULT(1);
+op_byte:       NEED(2); PROFILE(OP_BYTE, u256_byte(t, sp[-2], sp[-1])); RESULT(2);
+op_shl:        NEED(2); PROFILE(OP_SHL, u256_shl(t, sp[-2], sp[-1])); RESULT(2);
+op_shr:        NEED(2); PROFILE(OP_SHR, u256_shr(t, sp[-2], sp[-1])); RESULT(2);
+op_sar:        NEED(2); PROFILE(OP_SAR, u256_sar(t, sp[-2], sp[-1])); RESULT(2);
+op_clz:        NEED(1); PROFILE(OP_CLZ, u256_clz(t, sp[-1])); RESULT(1);
+
+op_pop:
+    NEED(1);
+    sp--;
+    NEXT;
+
+op_push0:
+    if (sp == limit) {
+        goto error;
+    }
+    clear_words(sp[0], 4);
+    sp++;
+    NEXT;
+
+op_push:
+    if (sp == limit) {
+        goto error;
+    }
+    for (int i = 0; i < 4; i++) {
+        (*sp)[i] = (ip++)->word;
+    }
+    sp++;
+    NEXT;
+
+op_dup: {
+    int n = (ip++)->word;
+    NEED(n);
+    if (sp == limit) {
+        goto error;
+    }
+    copy_words(sp[0], sp[-n], 4);
+    sp++;
+    NEXT;
+}
+
+op_swap: {
+    int n = (ip++)->word;
+    NEED(n+1);
+    copy_words(&t[0], sp[-1], 4);
+    copy_words(sp[-1], sp[-1-n], 4);
+    copy_words(sp[-1-n], &t[0], 4);
+    NEXT;
+}
+
+#undef NEXT
+#undef NEED
+#undef RESULT
+#undef BOOL
+
+op_stop:
+    arena_release(mark);
+    return sp - stack;
+
+op_invalid:
+error:
+    arena_release(mark);
+    return -1;
+}
@@ -0,0 +1,341 @@
+/*
+* Number theoretic transforms over the BN254 scalar field
+* */
+#include <ntt.h>
+#include <fields.h>
+#include <arena.h>
+
+#ifndef __wasm__
+#include <pthread.h>
+#endif
+
+// 5^((r-1)/2^28), a primitive 2^28-th root of unity, as 5 generates the group
+static const u256 root_28 = {
+    0x9bd61b6e725b19f0ULL, 0x402d111e41112ed4ULL,
+    0x00e0a7eb8ef62abcULL, 0x2a3c09f0a58a7e85ULL
+};
+
+// the first stages run on blocks of 2^BLOCK_LOG elements, 128 kB, that stay
+// in cache
+#define BLOCK_LOG 12
+
+bool ntt_domain_init(ntt_domain *d, int log_n, u256 *twiddles) {
+    if (log_n < 1 || log_n > NTT_MAX_LOG) {
+        return false;
+    }
+    d->log_n = log_n;
+    d->n = (size_t)1 << log_n;
+    size_t half = d->n / 2;
+
+    u256 root, root_inv;
+    bn254_fr_from(root, root_28);
+    for (int i = log_n; i < NTT_MAX_LOG; i++) {
+        bn254_fr_sqr(root, root);
+    }
+    bn254_fr_inv(root_inv, root);
+
+    u256 *w = twiddles, *w_inv = twiddles + half;
+    bn254_fr_one(w[0]);
+    bn254_fr_one(w_inv[0]);
+    for (size_t i = 1; i < half; i++) {
+        bn254_fr_mul(w[i], w[i-1], root);
+        bn254_fr_mul(w_inv[i], w_inv[i-1], root_inv);
+    }
+    d->w = w;
+    d->w_inv = w_inv;
+
+    u256 n = {d->n, 0, 0, 0};
+    bn254_fr_from(d->n_inv, n);
+    bn254_fr_inv(d->n_inv, d->n_inv);
+    return true;
+}
+
+static size_t reverse_bits(size_t x, int bits) {
+    size_t r = 0;
+    for (int i = 0; i < bits; i++) {
+        r = (r << 1) | (x & 1);
+        x >>= 1;
+    }
+    return r;
+}
+
+static inline void swap(u256 a, u256 b) {
+    u256 t;
+    __builtin_memcpy(t, a, 32);
+    __builtin_memcpy(a, b, 32);
+    __builtin_memcpy(b, t, 32);
+}
+
+/*
+    With i = (hi, mid, lo) for hi and lo of NTT_TILE_LOG bits, reverse(i) =
+    (reverse(lo), reverse(mid), reverse(hi)): the tile of the elements with
+    the same mid goes to the tile of reverse(mid), and each is read and
+    written in runs of NTT_TILE contiguous elements.
+*/
+void ntt_bit_reverse(u256 *a, int log_n) {
+    size_t n = (size_t)1 << log_n;
+    if (log_n < 2 * NTT_TILE_LOG) {
+        for (size_t i = 0; i < n; i++) {
+            size_t j = reverse_bits(i, log_n);
+            if (i < j) {
+                swap(a[i], a[j]);
+            }
+        }
+        return;
+    }
+    int mid_log = log_n - 2 * NTT_TILE_LOG;
+    int hi_shift = log_n - NTT_TILE_LOG;
+    uint8_t rev[NTT_TILE];
+    for (int i = 0; i < NTT_TILE; i++) {
+        rev[i] = reverse_bits(i, NTT_TILE_LOG);
+    }
+    u256 t0[NTT_TILE][NTT_TILE], t1[NTT_TILE][NTT_TILE];
+    for (size_t m = 0; m < (size_t)1 << mid_log; m++) {
+        size_t m2 = reverse_bits(m, mid_log);
+        if (m2 < m) {
+            continue;
+        }
+        u256 *x = a + (m << NTT_TILE_LOG);
+        u256 *y = a + (m2 << NTT_TILE_LOG);
+        for (size_t h = 0; h < NTT_TILE; h++) {
+            __builtin_memcpy(t0[h], x + (h << hi_shift), sizeof(t0[h]));
+            if (m2 != m) {
+                __builtin_memcpy(t1[h], y + (h << hi_shift), sizeof(t1[h]));
+            }
+        }
+        for (size_t l = 0; l < NTT_TILE; l++) {
+            for (size_t h = 0; h < NTT_TILE; h++) {
+                __builtin_memcpy(y[((size_t)rev[l] << hi_shift) + rev[h]], t0[h][l], 32);
+                if (m2 != m) {
+                    __builtin_memcpy(x[((size_t)rev[l] << hi_shift) + rev[h]], t1[h][l], 32);
+                }
+            }
+        }
+    }
+}
+
+// a, b <- a + w b, a - w b
+static inline void butterfly(u256 a, u256 b, const u256 w) {
+    u256 t;
+    bn254_fr_mul(t, b, w);
+    bn254_fr_sub(b, a, t);
+    bn254_fr_add(a, a, t);
+}
+
+// a, b <- a + b, a - b, for w^0 = 1
+static inline void butterfly1(u256 a, u256 b) {
+    u256 t;
+    bn254_fr_sub(t, a, b);
+    bn254_fr_add(a, a, b);
+    __builtin_memcpy(b, t, 32);
+}
+
+/*
+    The stages are numbered by log2 of their half size m: stage s combines
+    pairs m = 2^s apart with the twiddles w_2m^j = w[j << (log_n - s - 1)].
+    A pass runs over the n elements of a, or a part of the parts of every
+    block's j. j = 0 has the twiddle 1, which saves most of the
+    multiplications of the first stages.
+*/
+static void pass2(u256 *a, size_t n, int s, const u256 *w, int log_n,
+                  int part, int parts) {
+    size_t m = (size_t)1 << s;
+    size_t lo = m * part / parts, hi = m * (part + 1) / parts;
+    int shift = log_n - s - 1;
+    for (size_t k = 0; k < n; k += 2*m) {
+        size_t j = lo;
+        if (j == 0 && hi > 0) {
+            butterfly1(a[k], a[k+m]);
+            j++;
+        }
+        for (; j < hi; j++) {
+            butterfly(a[k+j], a[k+j+m], w[j << shift]);
+        }
+    }
+}
+
+// stages s and s + 1 in one pass: w_4m^(j+m) = w_4m^j w_4
+static void pass4(u256 *a, size_t n, int s, const u256 *w, int log_n,
+                  int part, int parts) {
+    size_t m = (size_t)1 << s;
+    size_t lo = m * part / parts, hi = m * (part + 1) / parts;
+    int shift = log_n - s - 2;
+    for (size_t k = 0; k < n; k += 4*m) {
+        u256 *x = a + k;
+        size_t j = lo;
+        if (j == 0 && hi > 0) {
+            butterfly1(x[0], x[m]);
+            butterfly1(x[2*m], x[3*m]);
+            butterfly1(x[0], x[2*m]);
+            butterfly(x[m], x[3*m], w[m << shift]);
+            j++;
+        }
+        for (; j < hi; j++) {
+            const u64 *w1 = w[j << (shift + 1)];
+            butterfly(x[j], x[j+m], w1);
+            butterfly(x[j+2*m], x[j+3*m], w1);
+            butterfly(x[j], x[j+2*m], w[j << shift]);
+            butterfly(x[j+m], x[j+3*m], w[(j + m) << shift]);
+        }
+    }
+}
+
+// stages from to to - 1, with one radix-2 pass first for an odd count
+static void passes(u256 *a, size_t n, int from, int to, const u256 *w,
+                   int log_n) {
+    int s = from;
+    if ((to - from) & 1) {
+        pass2(a, n, s++, w, log_n, 0, 1);
+    }
+    for (; s < to; s += 2) {
+        pass4(a, n, s, w, log_n, 0, 1);
+    }
+}
+
+// the stages below block on blocks of 2^block elements, then the rest up to
+// to on all of a
+static void stages(u256 *a, size_t n, int to, int block, const u256 *w,
+                   int log_n) {
+    for (size_t k = 0; k < n; k += (size_t)1 << block) {
+        passes(a + k, (size_t)1 << block, 0, block, w, log_n);
+    }
+    passes(a, n, block, to, w, log_n);
+}
+
+static void scale(u256 *a, size_t n, const u256 c) {
+    for (size_t i = 0; i < n; i++) {
+        bn254_fr_mul(a[i], a[i], c);
+    }
+}
+
+static void transform(const ntt_domain *d, u256 *a, const u256 *w) {
+    ntt_bit_reverse(a, d->log_n);
+    int block = d->log_n < BLOCK_LOG ? d->log_n : BLOCK_LOG;
+    stages(a, d->n, d->log_n, block, w, d->log_n);
+}
+
+void ntt_forward(const ntt_domain *d, u256 *a) {
+    transform(d, a, d->w);
+}
+
+void ntt_inverse(const ntt_domain *d, u256 *a) {
+    transform(d, a, d->w_inv);
+    scale(a, d->n, d->n_inv);
+}
+
+#ifndef __wasm__
+/*
+    With 2^t threads, thread i first runs the stages below log n - t on its
+    own 1/2^t of a, and then the last t stages run one pass at a time, with
+    each thread taking 1/2^t of the j of every block.
+*/
+#define MAX_THREADS_LOG 8
+
+enum ntt_job { NTT_LOCAL, NTT_PASS2, NTT_PASS4, NTT_SCALE };
+
+typedef struct ntt_task {
+    pthread_t id;
+    enum ntt_job job;
+    const ntt_domain *d;
+    u256 *a;
+    const u256 *w;
+    int s;
+    int part;
+    int parts;
+} ntt_task;
+
+static void *ntt_run(void *arg) {
+    ntt_task *t = arg;
+    int log_n = t->d->log_n;
+    size_t chunk = t->d->n / t->parts;
+    u256 *own = t->a + chunk * t->part;
+    switch (t->job) {
+    case NTT_LOCAL: {
+        int local = t->s;
+        stages(own, chunk, local, local < BLOCK_LOG ? local : BLOCK_LOG, t->w,
+               log_n);
+        break;
+    }
+    case NTT_PASS2:
+        pass2(t->a, t->d->n, t->s, t->w, log_n, t->part, t->parts);
+        break;
+    case NTT_PASS4:
+        pass4(t->a, t->d->n, t->s, t->w, log_n, t->part, t->parts);
+        break;
+    case NTT_SCALE:
+        scale(own, chunk, t->d->n_inv);
+        break;
+    }
+    return NULL;
+}
+
+static void ntt_round(ntt_task *t, int parts, enum ntt_job job, int s) {
+    for (int i = 0; i < parts; i++) {
+        t[i].job = job;
+        t[i].s = s;
+    }
+    // this thread takes the first part, and the rest run in their own
+    int started = 1;
+    for (int i = 1; i < parts; i++, started++) {
+        if (pthread_create(&t[i].id, NULL, ntt_run, &t[i]) != 0) {
+            break;
+        }
+    }
+    ntt_run(&t[0]);
+    for (int i = 1; i < started; i++) {
+        pthread_join(t[i].id, NULL);
+    }
+    // parts of threads that couldn't start
+    for (int i = started; i < parts; i++) {
+        ntt_run(&t[i]);
+    }
+}
+
+static void transform_threads(const ntt_domain *d, u256 *a, const u256 *w,
+                              bool inverse, int threads) {
+    int t = 0;
+    while (t < MAX_THREADS_LOG && (2 << t) <= threads) {
+        t++;
+    }
+    if (d->log_n < NTT_THREAD_LOG || t == 0) {
+        transform(d, a, w);
+        if (inverse) {
+            scale(a, d->n, d->n_inv);
+        }
+        return;
+    }
+
+    size_t mark = arena_mark();
+    int parts = 1 << t;
+    ntt_task *tasks = arena_alloc(parts * sizeof(ntt_task));
+    for (int i = 0; i < parts; i++) {
+        tasks[i].d = d;
+        tasks[i].a = a;
+        tasks[i].w = w;
+        tasks[i].part = i;
+        tasks[i].parts = parts;
+    }
+    ntt_bit_reverse(a, d->log_n);
+    int local = d->log_n - t;
+    ntt_round(tasks, parts, NTT_LOCAL, local);
+    int s = local;
+    if (t & 1) {
+        ntt_round(tasks, parts, NTT_PASS2, s++);
+    }
+    for (; s < d->log_n; s += 2) {
+        ntt_round(tasks, parts, NTT_PASS4, s);
+    }
+    if (inverse) {
+        ntt_round(tasks, parts, NTT_SCALE, 0);
+    }
+    arena_release(mark);
+}
+
+void ntt_forward_threads(const ntt_domain *d, u256 *a, int threads) {
+    transform_threads(d, a, d->w, false, threads);
+}
+
+void ntt_inverse_threads(const ntt_domain *d, u256 *a, int threads) {
+    transform_threads(d, a, d->w_inv, true, threads);
+}
+#endif
@@ -0,0 +1,310 @@
+/*
+* P-256 ECDSA verification
+* */
+#include <p256.h>
+#include <fields.h>
+
+#define fe_add p256_fp_add
+#define fe_sub p256_fp_sub
+#define fe_mul p256_fp_mul
+#define fe_sqr p256_fp_sqr
+#define fe_neg p256_fp_neg
+#define fe_inv p256_fp_inv
+#define fe_eq p256_fp_eq
+#define fe_is_zero p256_fp_is_zero
+
+static const u256 curve_b = {0x3bce3c3e27d2604bULL, 0x651d06b0cc53b0f6ULL,
+                             0xb3ebbd55769886bcULL, 0x5ac635d8aa3a93e7ULL};
+
+// p - n, the x coordinates in [n, p) are the ones that exceed r by n
+static const u256 p_minus_n = {0x0c46353d039cdaaeULL, 0x4319055358e8617bULL,
+                               0x0000000000000000ULL, 0x0000000000000000ULL};
+
+static void set_infinity(p256_jacobian *r) {
+    clear_words(r->x, 4);
+    clear_words(r->y, 4);
+    clear_words(r->z, 4);
+}
+
+static bool is_infinity(const p256_jacobian *a) {
+    return fe_is_zero(a->z);
+}
+
+void p256_double(p256_jacobian *r, const p256_jacobian *a) {
+    // dbl-2001-b, for curves with a = -3
+    u256 delta, gamma, beta, alpha, t, u;
+    fe_sqr(delta, a->z);
+    fe_sqr(gamma, a->y);
+    fe_mul(beta, a->x, gamma);
+    fe_sub(t, a->x, delta);
+    fe_add(u, a->x, delta);
+    fe_mul(alpha, t, u);
+    fe_add(t, alpha, alpha);
+    fe_add(alpha, t, alpha);
+
+    // z3 = (y + z)^2 - gamma - delta, before y and z are overwritten
+    fe_add(t, a->y, a->z);
+    fe_sqr(t, t);
+    fe_sub(t, t, gamma);
+    fe_sub(r->z, t, delta);
+
+    fe_add(beta, beta, beta);
+    fe_add(beta, beta, beta);
+    fe_sqr(t, alpha);
+    fe_add(u, beta, beta);
+    fe_sub(r->x, t, u);
+    fe_sub(t, beta, r->x);
+    fe_mul(t, alpha, t);
+    fe_sqr(gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_sub(r->y, t, gamma);
+}
+
+// r = a + b, with add-2007-bl
+static void add_jacobian(p256_jacobian *r, const p256_jacobian *a,
+                         const p256_jacobian *b) {
+    if (is_infinity(a)) {
+        *r = *b;
+        return;
+    }
+    if (is_infinity(b)) {
+        *r = *a;
+        return;
+    }
+    u256 z1z1, z2z2, u1, u2, s1, s2, h, rr, t;
+    fe_sqr(z1z1, a->z);
+    fe_sqr(z2z2, b->z);
+    fe_mul(u1, a->x, z2z2);
+    fe_mul(u2, b->x, z1z1);
+    fe_mul(s1, a->y, b->z);
+    fe_mul(s1, s1, z2z2);
+    fe_mul(s2, b->y, a->z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, u1);
+    fe_sub(rr, s2, s1);
+    if (fe_is_zero(h)) {
+        if (fe_is_zero(rr)) {
+            p256_double(r, a);
+        } else {
+            set_infinity(r);
+        }
+        return;
+    }
+
+    u256 i, j, v, z3;
+    fe_add(i, h, h);
+    fe_sqr(i, i);
+    fe_mul(j, h, i);
+    fe_add(rr, rr, rr);
+    fe_mul(v, u1, i);
+    fe_add(z3, a->z, b->z);
+    fe_sqr(z3, z3);
+    fe_sub(z3, z3, z1z1);
+    fe_sub(z3, z3, z2z2);
+    fe_mul(r->z, z3, h);
+
+    fe_sqr(t, rr);
+    fe_sub(t, t, j);
+    fe_sub(t, t, v);
+    fe_sub(r->x, t, v);
+    fe_sub(t, v, r->x);
+    fe_mul(t, rr, t);
+    fe_mul(s1, s1, j);
+    fe_add(s1, s1, s1);
+    fe_sub(r->y, t, s1);
+}
+
+void p256_add_affine(p256_jacobian *r, const p256_jacobian *a,
+                     const p256_affine *b) {
+    // madd-2007-bl, b has z = 1
+    if (b->infinity) {
+        *r = *a;
+        return;
+    }
+    if (is_infinity(a)) {
+        copy_words(r->x, (u64 *)b->x, 4);
+        copy_words(r->y, (u64 *)b->y, 4);
+        p256_fp_one(r->z);
+        return;
+    }
+    u256 z1z1, u2, s2, h, rr, t;
+    fe_sqr(z1z1, a->z);
+    fe_mul(u2, b->x, z1z1);
+    fe_mul(s2, b->y, a->z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, a->x);
+    fe_sub(rr, s2, a->y);
+    if (fe_is_zero(h)) {
+        if (fe_is_zero(rr)) {
+            p256_double(r, a);
+        } else {
+            set_infinity(r);
+        }
+        return;
+    }
+
+    u256 hh, i, j, v, y1j;
+    fe_sqr(hh, h);
+    fe_add(i, hh, hh);
+    fe_add(i, i, i);
+    fe_mul(j, h, i);
+    fe_add(rr, rr, rr);
+    fe_mul(v, a->x, i);
+    fe_mul(y1j, a->y, j);
+    fe_add(y1j, y1j, y1j);
+    fe_add(r->z, a->z, h);
+    fe_sqr(r->z, r->z);
+    fe_sub(r->z, r->z, z1z1);
+    fe_sub(r->z, r->z, hh);
+
+    fe_sqr(t, rr);
+    fe_sub(t, t, j);
+    fe_sub(t, t, v);
+    fe_sub(r->x, t, v);
+    fe_sub(t, v, r->x);
+    fe_mul(t, rr, t);
+    fe_sub(r->y, t, y1j);
+}
+
+void p256_to_affine(p256_affine *r, const p256_jacobian *a) {
+    if (is_infinity(a)) {
+        clear_words(r->x, 4);
+        clear_words(r->y, 4);
+        r->infinity = true;
+        return;
+    }
+    u256 zi, zi2;
+    fe_inv(zi, a->z);
+    fe_sqr(zi2, zi);
+    fe_mul(r->x, a->x, zi2);
+    fe_mul(zi2, zi2, zi);
+    fe_mul(r->y, a->y, zi2);
+    r->infinity = false;
+}
+
+bool p256_on_curve(const p256_affine *a) {
+    if (a->infinity || !less_than((u64 *)a->x, (u64 *)p256_fp_P)
+        || !less_than((u64 *)a->y, (u64 *)p256_fp_P)) {
+        return false;
+    }
+    // y^2 = x^3 - 3x + b
+    u256 lhs, rhs, t;
+    fe_sqr(lhs, a->y);
+    fe_sqr(rhs, a->x);
+    fe_mul(rhs, rhs, a->x);
+    fe_add(t, a->x, a->x);
+    fe_add(t, t, a->x);
+    fe_sub(rhs, rhs, t);
+    fe_add(rhs, rhs, curve_b);
+    return fe_eq(lhs, rhs);
+}
+
+// Q's odd multiples, up to 15 Q
+#define Q_WINDOW 5
+#define Q_TABLE (1 << (Q_WINDOW - 2))
+
+// the digits of a scalar below n
+#define WNAF_LEN 258
+
+// the odd multiples of q, made affine with Montgomery's trick
+static void q_table(p256_affine *table, const p256_affine *q) {
+    p256_jacobian odd[Q_TABLE], q2;
+    copy_words(odd[0].x, (u64 *)q->x, 4);
+    copy_words(odd[0].y, (u64 *)q->y, 4);
+    p256_fp_one(odd[0].z);
+    p256_double(&q2, &odd[0]);
+    for (int i = 1; i < Q_TABLE; i++) {
+        add_jacobian(&odd[i], &odd[i-1], &q2);
+    }
+
+    // none of them is infinity, since Q has prime order
+    u256 zi[Q_TABLE], prefix[Q_TABLE], zi2;
+    for (int i = 0; i < Q_TABLE; i++) {
+        copy_words(zi[i], odd[i].z, 4);
+    }
+    p256_fp_inv_batch(zi, zi, Q_TABLE, prefix);
+    for (int i = 0; i < Q_TABLE; i++) {
+        fe_sqr(zi2, zi[i]);
+        fe_mul(table[i].x, odd[i].x, zi2);
+        fe_mul(zi2, zi2, zi[i]);
+        fe_mul(table[i].y, odd[i].y, zi2);
+        table[i].infinity = false;
+    }
+}
+
+static void add_digit(p256_jacobian *r, const p256_affine *table, int d) {
+    p256_affine e = table[(d < 0 ? -d : d) >> 1];
+    if (d < 0) {
+        fe_neg(e.y, e.y);
+    }
+    p256_add_affine(r, r, &e);
+}
+
+void p256_mul2(p256_jacobian *r, const u256 u1, const p256_affine *q,
+               const u256 u2) {
+    int8_t d1[WNAF_LEN] = {0}, d2[WNAF_LEN] = {0};
+    int len1 = u256_wnaf(d1, u1, P256_G_WINDOW);
+    int len2 = 0;
+    p256_affine table[Q_TABLE];
+    if (!q->infinity && !is_zero((u64 *)u2)) {
+        q_table(table, q);
+        len2 = u256_wnaf(d2, u2, Q_WINDOW);
+    }
+
+    set_infinity(r);
+    for (int i = (len1 > len2 ? len1 : len2) - 1; i >= 0; i--) {
+        p256_double(r, r);
+        if (d1[i] != 0) {
+            add_digit(r, p256_g_odd, d1[i]);
+        }
+        if (d2[i] != 0) {
+            add_digit(r, table, d2[i]);
+        }
+    }
+}
+
+// 0 < a < n
+static bool scalar_valid(const u256 a) {
+    return !is_zero((u64 *)a) && less_than((u64 *)a, (u64 *)p256_fn_P);
+}
+
+// whether a's x coordinate is r mod n, without making a affine
+static bool x_matches(const p256_jacobian *a, const u256 r) {
+    u256 z2, t, x;
+    fe_sqr(z2, a->z);
+    fe_mul(t, r, z2);
+    if (fe_eq(t, a->x)) {
+        return true;
+    }
+    if (!less_than((u64 *)r, (u64 *)p_minus_n)) {
+        return false;
+    }
+    u64 carry = 0;
+    for (int i = 0; i < 4; i++) {
+        carry = add64(&x[i], r[i], p256_fn_P[i], carry);
+    }
+    fe_mul(t, x, z2);
+    return fe_eq(t, a->x);
+}
+
+bool p256_verify(const u256 hash, const u256 r, const u256 s,
+                 const p256_affine *pubkey) {
+    if (!scalar_valid(r) || !scalar_valid(s) || !p256_on_curve(pubkey)) {
+        return false;
+    }
+    // u1 = hash / s and u2 = r / s, in the Montgomery form of n until the
+    // end. hash is reduced once, since 2^256 < 2n.
+    u256 z, w, u1, u2;
+    copy_words(z, (u64 *)hash, 4);
+    field_sub_if_above(z, 0, p256_fn_P);
+    p256_fn_from(w, s);
+    p256_fn_inv(w, w);
+    p256_fn_mul(u1, z, w);
+    p256_fn_mul(u2, r, w);
+
+    p256_jacobian R;
+    p256_mul2(&R, u1, pubkey, u2);
+    return !is_infinity(&R) && x_matches(&R, r);
+}
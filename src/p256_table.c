@@ -0,0 +1,133 @@
+// Generated by scripts/gen_p256_table.js, do not edit.
+#include <p256.h>
+
+const p256_affine p256_g_odd[64] = {
+    {{0xf4a13945d898c296ULL, 0x77037d812deb33a0ULL, 0xf8bce6e563a440f2ULL, 0x6b17d1f2e12c4247ULL},
+     {0xcbb6406837bf51f5ULL, 0x2bce33576b315eceULL, 0x8ee7eb4a7c0f9e16ULL, 0x4fe342e2fe1a7f9bULL}, false},
+    {{0xfb41661bc6e7fd6cULL, 0xe6c6b721efada985ULL, 0xc8f7ef951d4bf165ULL, 0x5ecbe4d1a6330a44ULL},
+     {0x9a79b127a27d5032ULL, 0xd82ab036384fb83dULL, 0x374b06ce1a64a2ecULL, 0x8734640c4998ff7eULL}, false},
+    {{0x21554a0dc3d033edULL, 0xef8c82fd1f5be524ULL, 0xd784c85608668fdfULL, 0x51590b7a515140d2ULL},
+     {0xd1d0bb44fda16da4ULL, 0x0d012f00d4d80888ULL, 0x8ae1bf36bf8a7926ULL, 0xe0c17da8904a727dULL}, false},
+    {{0x300628703187b2a3ULL, 0x7ef9f8b8a80fef5bULL, 0x25bb30667c01fb60ULL, 0x8e533b6fa0bf7b46ULL},
+     {0xc55e1a86c1f400b4ULL, 0x53c73633cb041b21ULL, 0x6d069f83a6f59000ULL, 0x73eb1dbde0331836ULL}, false},
+    {{0xd79e8a4b90949ee0ULL, 0x9e0acb8c2c6df8b3ULL, 0x878938d51d71f872ULL, 0xea68d7b6fedf0b71ULL},
+     {0xe85a224a4dd048faULL, 0x4d714feaa4de823fULL, 0x87014a964a8ea0c8ULL, 0x2a2744c972c9fce7ULL}, false},
+    {{0x433391d374bc21d1ULL, 0x16742ed0255048bfULL, 0x0638379db0c21cdaULL, 0x3ed113b7883b4c59ULL},
+     {0xe2f8eefce82a3740ULL, 0x090d04da5e9889daULL, 0x24c843afa4f4c68aULL, 0x9099209accc4c8a2ULL}, false},
+    {{0x98e15d9d46072c01ULL, 0x792e284b65ead58aULL, 0x61805df2d85ee2fcULL, 0x177c837ae0ac495aULL},
+     {0x9c43bbe2efc7bfd8ULL, 0x26ee14c3a1fb4df3ULL, 0xa24091adb40f4e72ULL, 0x63bb58cd4ebea558ULL}, false},
+    {{0x63668c63e59b9d5fULL, 0xae03af92de3a0ef1ULL, 0xadfb378999888265ULL, 0xf0454dc6971abae7ULL},
+     {0x47e59cde0d034f36ULL, 0x2a3b21ce75b5fa3fULL, 0x4e6594e51f9643e6ULL, 0xb5b93ee3592e2d1fULL}, false},
+    {{0xba1abce34738a73eULL, 0x5fa68678f0d64af8ULL, 0x9c0984b66f75301aULL, 0x47776904c0f1cc3aULL},
+     {0x32f787ff71f1fcdcULL, 0x81b2804428d5733fULL, 0x6231856577648e83ULL, 0xaa005ee6b5b95728ULL}, false},
+    {{0xc1fc7b74ab03ed83ULL, 0x782c452257884895ULL, 0xce39b7c17108c507ULL, 0xcb6d2861102c0c25ULL},
+     {0xe39150752bcecdaaULL, 0xa496716e30fa3e03ULL, 0x5c35e7100d6d6ce4ULL, 0x58d7614b24d9ef51ULL}, false},
+    {{0xfd76364e67399e83ULL, 0x3a582139f42b1523ULL, 0x2e4ac86eb473bca5ULL, 0x3250fcf686637c7bULL},
+     {0x15de24a071d48c09ULL, 0x897cd3c33b566a82ULL, 0x97b3090d1d7eb88cULL, 0x42e7c342667d3593ULL}, false},
+    {{0x672e573045ca7896ULL, 0x3c0bc0a5df64a4feULL, 0xd28a3e39d4583fa6ULL, 0x0e91c7239c2640d7ULL},
+     {0x138046543140ad55ULL, 0x7e68833575e7a5aeULL, 0x1a22733bb8e0bd6dULL, 0x5df65c3b550dba22ULL}, false},
+    {{0x84a4dc45f200d687ULL, 0x41652fc5b76f1b24ULL, 0x85f4f52d8c07fa84ULL, 0x3a67e2554b0c0bb6ULL},
+     {0xa9ed16b302f79324ULL, 0x8c188af735a7618aULL, 0x26daf267163afb0dULL, 0x27d0f1872f1fcf43ULL}, false},
+    {{0xf2e201173b0883d1ULL, 0x576355bd683e54abULL, 0xdeba2fac4611f378ULL, 0x184ffa5819d80d51ULL},
+     {0x20d242c260906e6fULL, 0x45bdeccc63f04916ULL, 0xa4c6d90826cb9995ULL, 0xc0a66e276688f359ULL}, false},
+    {{0xdedd693d1c784defULL, 0xfd8cd1c688b58a41ULL, 0xa7c36da090853b8cULL, 0xd6d33adefa195b07ULL},
+     {0x550c124593d1bca6ULL, 0x09a166ab4b95ededULL, 0x3f78245f558a5dcbULL, 0x84aaba16ee195d7eULL}, false},
+    {{0x3e3f9aa0a1b45b8bULL, 0xfac9db7d52a95b3eULL, 0xa85da026a7ae9aa0ULL, 0x301d9e502dc7e05dULL},
+     {0xd58db6aea17ee267ULL, 0x298d9ae46887ca61ULL, 0xe0d23c026b017d72ULL, 0x6551b6f6b3061223ULL}, false},
+    {{0x65c100f3cb2cd793ULL, 0xa03b0a533aa872fdULL, 0xfa9aa25b89d9d34eULL, 0x9807d699fcd81356ULL},
+     {0x2f6bf92479634af4ULL, 0xffe630b96c587853ULL, 0x86a01a4d1d091b2fULL, 0xc2a59cdccab11bf2ULL}, false},
+    {{0xa12d389033bb291aULL, 0x94e8e1fe92af9700ULL, 0x8ffa3ad7326c48caULL, 0xd58d4a589ed27d16ULL},
+     {0xa5b0c9c6f586b9d5ULL, 0x67271c163b034979ULL, 0x76ea92632dc7fef6ULL, 0xd45514d102726b85ULL}, false},
+    {{0x73a92894502b3348ULL, 0xe0d21379246bfd44ULL, 0xd6b0978611a826aaULL, 0x419a6a646ddb817dULL},
+     {0xdb1d6c81b09214b2ULL, 0x13c6d072f3dee1e2ULL, 0x545c9fb1954c2fd5ULL, 0x332544cf1102f584ULL}, false},
+    {{0xa0c199ddfb2776c4ULL, 0x547b942dd2d138d4ULL, 0x42014976a179046eULL, 0x22a682f7c3996d4dULL},
+     {0x5347f649cbaa285dULL, 0x979dcc310265b068ULL, 0xb918c9835a54356cULL, 0x4f4606b0102223eeULL}, false},
+    {{0x3a7de694995d2fa2ULL, 0x6067c5c3d4175a59ULL, 0x1cf258d2e6cfe8aaULL, 0x67a6bec240dee065ULL},
+     {0x49c24ce1441feed5ULL, 0x1542c7ee209aca6cULL, 0x6c249b49464d4499ULL, 0xde692b7022d13158ULL}, false},
+    {{0x7544dc129b82d28dULL, 0x8f4bc4c6d009b30fULL, 0xd04230861d8f4b49ULL, 0x986ae2506f1ff104ULL},
+     {0x25110c441bb07e97ULL, 0xd86fc6289c189f25ULL, 0xe328a4d97d3c7b61ULL, 0x003cccc0a6460e0aULL}, false},
+    {{0x79c78080fae0ba03ULL, 0x0f5f609edd29d6d9ULL, 0x3ecd0f5ddff0672eULL, 0xa891d06670bde99bULL},
+     {0xefc3edc8166934aeULL, 0x1c6b38f0feb0f2ccULL, 0x419a88c4033c1ce7ULL, 0xb596cd922cbfa1c1ULL}, false},
+    {{0x51d689227b1c0d7cULL, 0xdd5b31583e19066dULL, 0x595361ea83071bbcULL, 0x42c315cc48958708ULL},
+     {0xd6c4a72bb2f9b1b9ULL, 0x74f1a1e1eb87f164ULL, 0x2914d1dfbb7a7990ULL, 0x649a61ce571b9585ULL}, false},
+    {{0x7d228ce6a5674455ULL, 0x28fb7ea9758fd4fdULL, 0xbb22b146866e6c05ULL, 0xf785b0e098068875ULL},
+     {0xe7bc490c10d62408ULL, 0x4b04b6fd5f3aa60aULL, 0xe15c767f0d9f5b41ULL, 0x73fdb0bf6080da6eULL}, false},
+    {{0x044360f0018e22b1ULL, 0x95f7eb56e81008ffULL, 0xaadee6863c1d68bcULL, 0x672c4a514d9de43eULL},
+     {0x9935399191f37104ULL, 0x136246589704d941ULL, 0x611de5a4ace203f7ULL, 0x548c7e9196a25bfeULL}, false},
+    {{0xf126ec9f7449d036ULL, 0x982b1ca78de9b983ULL, 0x5a47802254b88039ULL, 0x6f01bd49c9d95245ULL},
+     {0x360233dd989e17dbULL, 0xa78551bfc3749b08ULL, 0x11a0f21a608776ceULL, 0x1562080ff1d5deabULL}, false},
+    {{0xdec1dff7df6e60a0ULL, 0xc2a595b762c1eadaULL, 0x7571a109fe7fea2cULL, 0x079dba7ba068c926ULL},
+     {0xfb0da5aeb4824deaULL, 0x83eb2df35751a397ULL, 0x1d223f9d2a9588abULL, 0xdc1e19b743d4d181ULL}, false},
+    {{0x8abd97b1d0f56077ULL, 0x289d406e2d6c6bd8ULL, 0x126d45a8ea907f86ULL, 0xc116e30ebb4d2865ULL},
+     {0x313fd7fda410c206ULL, 0x7d5bd5e89e59c8c5ULL, 0xb8b16d9bb13b8765ULL, 0xe9478823c35b30c2ULL}, false},
+    {{0xa2b6ea0e0faa4b45ULL, 0xe50941119e8dc8ecULL, 0x765b2784fca9bdf7ULL, 0x665f1a6ffe0c6437ULL},
+     {0x6e25a6602b7f4ccfULL, 0x7dede5bf81e215bcULL, 0x6e8cca29f7eac37fULL, 0x490e2ca49ffd18c2ULL}, false},
+    {{0x5939ac380d32af0eULL, 0x3e7910a08b724fd5ULL, 0x2d3a6b3d8d990001ULL, 0x059ccb19edd3da9aULL},
+     {0x928e1e3c97fe91d1ULL, 0x1621f7a33956cecdULL, 0xda65281b9345638eULL, 0xbb6ad7eccad49159ULL}, false},
+    {{0x32a290825d8bdac1ULL, 0xdf53c8af01a7cd38ULL, 0x2a1f28a08acc7d8fULL, 0x6a9501d85bf5dc80ULL},
+     {0x30aff53d5f1ef1a3ULL, 0xf8461b5c697a6f35ULL, 0x81c6c6e44a3c56a3ULL, 0xca640ad193473743ULL}, false},
+    {{0x11aa2ec254ea3410ULL, 0x9c7046afcbf39f66ULL, 0x343d0535537dd5e0ULL, 0x34325dcb458d8e5bULL},
+     {0x6f3b1601f3c869c9ULL, 0x794deb3ead76feb8ULL, 0x96cd238c49676718ULL, 0x8568d1dc50295547ULL}, false},
+    {{0xd916cd0b10a6483cULL, 0xa46a6529ce596ff8ULL, 0xeaef897b52466883ULL, 0x2d27033cb622fa8cULL},
+     {0x599a4bf4edc331b2ULL, 0x2a05d594ab147bf9ULL, 0xd0123f6d09832688ULL, 0xea177493148e92a4ULL}, false},
+    {{0x1db82b9f5c1874feULL, 0x1bab33236b7459b2ULL, 0xe90d03a299cb5585ULL, 0x52910a011565810bULL},
+     {0xdd2b2504ca42a562ULL, 0x05490ffc4c597233ULL, 0x511c2b1865bcdfd1ULL, 0xe3d03339f660528dULL}, false},
+    {{0x8b49bb9d9260e969ULL, 0x9fae27b0bff2a1daULL, 0xaa5d897cf601dc0aULL, 0x6e4b20574af29f6aULL},
+     {0xc0ac3c58afa16213ULL, 0x3e937c54efd04659ULL, 0x46d7eaad0896b1d2ULL, 0x61d496eea86c4f26ULL}, false},
+    {{0x36920e63cc4940cdULL, 0xd62b953bef294a13ULL, 0x4457d51dbb46a198ULL, 0x392c4bba3e610624ULL},
+     {0x5fded58287146bd2ULL, 0xfcfd867956882209ULL, 0xb3c3d7bf6b594c91ULL, 0xe50c821ad6af849dULL}, false},
+    {{0x6cd5ed29e021934bULL, 0x61a043cd71bbd4fcULL, 0x3e1cd4eed4432405ULL, 0x8d435a0fdd81431fULL},
+     {0x968f1ceceaa1d1acULL, 0x08f9ce9475feeb9bULL, 0x532912cb2a671076ULL, 0xbcd8433681b32c85ULL}, false},
+    {{0x17d871340893be7bULL, 0xf4efe021b38029c0ULL, 0x1a9d18eb72d5c720ULL, 0x5821b002dba27725ULL},
+     {0x1bbe9540e59f2363ULL, 0x869c04f125ded1c3ULL, 0xdf9b62f63fff5866ULL, 0x23ec12d67a538534ULL}, false},
+    {{0xd4dbc74df0222957ULL, 0x624289e1dcb58b8bULL, 0x121ef296d3aea625ULL, 0xdbd2f3d34beebf77ULL},
+     {0x3e344b3b3838fb9fULL, 0x587e52133edb809eULL, 0xeb3e890abc26ed34ULL, 0x94a16bbe7e5762d0ULL}, false},
+    {{0x2cdcf0c2a8a3b072ULL, 0x1e2a1b96700bb9b1ULL, 0x8464c3093dc72e91ULL, 0xd829ab2d2eed358cULL},
+     {0xcf3bc0b0b543775eULL, 0x166273e2d406aaf7ULL, 0xe1f6c7be2a598059ULL, 0x3ec1bbe459cae899ULL}, false},
+    {{0x28b945c867e045e8ULL, 0x631e6eddfe1aa0bdULL, 0x61e3fe0285630a57ULL, 0x8ff01da682fdda57ULL},
+     {0x5e039b1b1b7d52d8ULL, 0x72565cec7b0f557fULL, 0x645291e2e58038b4ULL, 0x3be3b91ef709bc92ULL}, false},
+    {{0x1f97fea1c9f64e8bULL, 0xa942f1f95dab9175ULL, 0x3fbea9cf65bdd242ULL, 0x84d067191caffc0eULL},
+     {0xc46fbcd4b30900d9ULL, 0x61304a7c351ef683ULL, 0xc68bfd91caf3f8b3ULL, 0xd8c9d818f5b6ea38ULL}, false},
+    {{0x672fc426889334fcULL, 0x9433543b9d296f1cULL, 0xf49d996faee48687ULL, 0xd2b3ef863cbff9c5ULL},
+     {0xd4511c8e8e2f4f0eULL, 0x921ba797f1b1baebULL, 0x5b046629035cf83cULL, 0x566d7e001025a8eeULL}, false},
+    {{0xc96a49751f461042ULL, 0x21b5fa95141f580fULL, 0x3e70b728e31a34faULL, 0xfc8b9e62fd84b49aULL},
+     {0xf51db6524f3d820dULL, 0x6da77b7c5a014ab0ULL, 0x8bfc86cb0b63b608ULL, 0xd5b4287a2a5816f7ULL}, false},
+    {{0x89c4cc1d387738caULL, 0xf240907ebc707101ULL, 0x30c619436dd3f71eULL, 0x07a1e7e2c7de6ba1ULL},
+     {0x41a8d7714d3c7049ULL, 0x03123fe158e45dd2ULL, 0xb2828204cb47806dULL, 0x9cfc4945aa3fd5ffULL}, false},
+    {{0x291d9c0ab90a4a9dULL, 0xe55acd833679e294ULL, 0x414994e1dc29a3c6ULL, 0xd73fc6300614a355ULL},
+     {0x31dd941178e83eb1ULL, 0xc0d43d8000c88792ULL, 0xb1b71c30ce01e631ULL, 0x03ed6f0e2cd69c0dULL}, false},
+    {{0x8aa17c957d462774ULL, 0xedf5380bdd4388c8ULL, 0x29f9e1eba1a2b0c0ULL, 0xdabd62029b4d0d13ULL},
+     {0xed0cc412a77ea93fULL, 0xcc263496d577e42eULL, 0x31cb988965424681ULL, 0x9ac784cdc8ad3fcdULL}, false},
+    {{0xbf1949e634bf9a19ULL, 0xb067b13cd17fe6d3ULL, 0xb6bd8a416b9faa62ULL, 0x20668209714547d0ULL},
+     {0x076a4965a9d1fd83ULL, 0xa1fd67f8aa682fbdULL, 0xde5738a8930de06dULL, 0x113ca8c80168fe5dULL}, false},
+    {{0x8a0e83174c8c609cULL, 0x49688dc911e3a74cULL, 0x1ad0857e7e1dbcc7ULL, 0x21508b35b4afe0f0ULL},
+     {0x9408df4140f7fcb5ULL, 0x8ccd53fc446fe12dULL, 0x83681e414ad64ae9ULL, 0xe2f8f5d3f58be2cdULL}, false},
+    {{0x76ae0b0e749833afULL, 0xb17ad259fbe717c2ULL, 0x85b3bf94c7269ad1ULL, 0xcfc746589e4a1407ULL},
+     {0x11e7bb1930978ef8ULL, 0xe8a1006aef0e41f6ULL, 0xbe4f9367e271322cULL, 0x9ee25d020b5be979ULL}, false},
+    {{0x7f3fb1c1fc2aabf6ULL, 0xf379987131d5ed29ULL, 0x6033c6114f7232d6ULL, 0x99f888ff112b3f5dULL},
+     {0xfc983789dfce6f67ULL, 0xe4bfa2b0706ac282ULL, 0x4f3531d93f8b3a2dULL, 0x5d6cb14380271b23ULL}, false},
+    {{0x496bbc6162ab6cc2ULL, 0xfff59bdc9abbc3aaULL, 0x70a8313e6db1fe12ULL, 0xd4cf299b52904a67ULL},
+     {0xf9346544e51769f9ULL, 0xffed4546c22d751eULL, 0xe4d8a1135f292428ULL, 0xfc494ce7a52a4c83ULL}, false},
+    {{0xd4ea99cfe649ce7fULL, 0xd897e7a5fc7d75bbULL, 0xe77a915d28dedac2ULL, 0xf9c1c90b9aac1fc3ULL},
+     {0xab113c2dfa54a06bULL, 0x144bec235d38d3dcULL, 0x42429ee2ef2f1a7fULL, 0x7c7deb67a844cd38ULL}, false},
+    {{0x0432191239585f43ULL, 0x5700d21eb9a17624ULL, 0x72399f899019993bULL, 0x05949c0407257fa1ULL},
+     {0x07401e7bf7233606ULL, 0x9bf0d4e8dc71f1d9ULL, 0x45dff17312db1759ULL, 0xbdf1d7ea1dc39756ULL}, false},
+    {{0xcad2cccdb85b089eULL, 0x6233002be8063cb1ULL, 0x0fe2c0ae1093724fULL, 0x3fc424067a1f679bULL},
+     {0x66aaaef8c6629ecfULL, 0xcf9fc800f7934c94ULL, 0x2aedbb47eda98d26ULL, 0x5bb243009e581be5ULL}, false},
+    {{0xa73c1a3004d85e13ULL, 0x8e4100d7f5b4bfe1ULL, 0x467d26bf88c13fd7ULL, 0x95e3476b96a9454dULL},
+     {0x9bfd92a132b7bccaULL, 0x4043f9d4c830228eULL, 0xa88dcbf9f340e0ecULL, 0x4676645ea10f7550ULL}, false},
+    {{0xf4bc4671406b50e4ULL, 0x03cbb8d52209b18dULL, 0x8f6e6637ecb67bbaULL, 0x49efa5f0a3978fe3ULL},
+     {0xb7210c6a6deef872ULL, 0x0bd2e06acb555371ULL, 0x9148ff2bac153b35ULL, 0x8551c53605e93452ULL}, false},
+    {{0xa697ef313de16f2dULL, 0x72850383b2b91283ULL, 0x45bd77200497c5b0ULL, 0xf9d9f00c0c3d1048ULL},
+     {0x85f8e9d1a4c34e09ULL, 0x4d99ef6db92b6cbaULL, 0x473f886a537b8fcdULL, 0x0ddee1f404154e79ULL}, false},
+    {{0xd19c9b1d4d5a20c5ULL, 0x41af2eae2ba4b223ULL, 0x59f33217266fa0afULL, 0x050f1973f0204768ULL},
+     {0xb02b3a1092e16df0ULL, 0x13d0e0a9b6b540aeULL, 0xd1fea9a5a272feafULL, 0xe3a723ef8d64df2aULL}, false},
+    {{0xada7e96300cb7a69ULL, 0xbec04e4db26cd86eULL, 0xd9aa4cfc8af6741bULL, 0xe78e6b2aff0e7073ULL},
+     {0x3b68ea73311638c8ULL, 0xc3042b42b0496b7dULL, 0x9e36a299addaeea8ULL, 0x14442eb0e6c87bdeULL}, false},
+    {{0x7c2b237be99aac39ULL, 0x19e7c3f9b0024f02ULL, 0xdd84747297fec477ULL, 0x811a6c2bd2a547d0ULL},
+     {0xa12aa0c4d083ff64ULL, 0x058cec6f18368f72ULL, 0x1524a0f5ea4bfed6ULL, 0xa9230acbd163d0cbULL}, false},
+    {{0xec9b2d3732248956ULL, 0xe827db6eec05db6dULL, 0xd83b1b497c1538c6ULL, 0x8ac7e1b94ed385deULL},
+     {0x01754c4aadb1e63cULL, 0x6444f1bfc89743d8ULL, 0x7067cfd8e2448a48ULL, 0x2bc15c273913ccb5ULL}, false},
+    {{0x67cebdfac42d623cULL, 0xa8d4eb58c6aaad35ULL, 0xd2a5d0a765f16013ULL, 0x534d45db6baca8e2ULL},
+     {0x17fdf664419e500cULL, 0xeef093e0f23a631dULL, 0x4154357f992ccec8ULL, 0xfad669c89a2a54e4ULL}, false},
+};
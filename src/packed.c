@@ -0,0 +1,68 @@
+/*
+* Decoder for packed u256 operands
+* */
+#include <packed.h>
+
+int packed_literal(u256 x, const uint8_t *data, size_t len) {
+    if (len < 1 || data[0] > 32 || len - 1 < data[0]) {
+        return -1;
+    }
+    int n = data[0];
+    const uint8_t *src = data + 1;
+
+    // big endian -> little endian
+    clear_words(&x[0], 4);
+    for (int i = 0; i < n; i++) {
+        int k = n - 1 - i;
+        x[k/8] |= ((u64)src[i]) << ((k&7)*8);
+    }
+    return n + 1;
+}
+
+int packed_init(packed_reader *r, const uint8_t *data, size_t len) {
+    if (len < 1 || data[0] > PACKED_MAX_DICT) {
+        return -1;
+    }
+    r->data = data;
+    r->len = len;
+    r->n_dict = data[0];
+
+    // check and skip the dictionary literals
+    size_t pos = 1;
+    for (int i = 0; i < r->n_dict; i++) {
+        if (pos >= len || data[pos] > 32 || len - pos - 1 < data[pos]) {
+            return -1;
+        }
+        r->dict[i] = pos;
+        pos += data[pos] + 1;
+    }
+    r->pos = pos;
+    return 0;
+}
+
+int packed_next(packed_reader *r, u256 x) {
+    if (r->pos >= r->len) {
+        return -1;
+    }
+    u8 h = r->data[r->pos];
+    if (h >= PACKED_DICT_REF) {
+        int i = h - PACKED_DICT_REF;
+        if (i >= r->n_dict) {
+            return -1;
+        }
+        // dictionary literals were checked by packed_init
+        packed_literal(x, r->data + r->dict[i], r->len - r->dict[i]);
+        r->pos++;
+        return 0;
+    }
+    int n = packed_literal(x, r->data + r->pos, r->len - r->pos);
+    if (n < 0) {
+        return -1;
+    }
+    r->pos += n;
+    return 0;
+}
+
+bool packed_done(const packed_reader *r) {
+    return r->pos == r->len;
+}
@@ -0,0 +1,89 @@
+/*
+* Poseidon, circomlib's parameters over the BN254 scalar field
+* */
+#include <poseidon.h>
+#include <fields.h>
+
+#define fe_add bn254_fr_add
+#define fe_mul bn254_fr_mul
+#define fe_sqr bn254_fr_sqr
+
+#define FULL_ROUNDS 8
+#define MAX_T (POSEIDON_MAX_INPUTS + 1)
+
+// x = (x + c)^5
+static void sbox(u256 x, const u256 c) {
+    u256 x2, x4;
+    fe_add(x, x, c);
+    fe_sqr(x2, x);
+    fe_sqr(x4, x2);
+    fe_mul(x, x4, x);
+}
+
+// state = m state, for a dense t * t matrix
+static void mix(u256 *state, const u256 *m, int t) {
+    u256 out[MAX_T], p;
+    for (int i = 0; i < t; i++) {
+        fe_mul(out[i], m[i*t], state[0]);
+        for (int j = 1; j < t; j++) {
+            fe_mul(p, m[i*t + j], state[j]);
+            fe_add(out[i], out[i], p);
+        }
+    }
+    for (int i = 0; i < t; i++) {
+        copy_words(state[i], out[i], 4);
+    }
+}
+
+// state = s state, for s = [[s0, row], [column, I]]
+static void mix_sparse(u256 *state, const u256 *s, int t) {
+    u256 s0, p;
+    fe_mul(s0, s[0], state[0]);
+    for (int j = 1; j < t; j++) {
+        fe_mul(p, s[j], state[j]);
+        fe_add(s0, s0, p);
+    }
+    for (int i = 1; i < t; i++) {
+        fe_mul(p, s[t + i - 1], state[0]);
+        fe_add(state[i], state[i], p);
+    }
+    copy_words(state[0], s0, 4);
+}
+
+static void full_round(const poseidon_params *p, u256 *state, int r,
+                       const u256 *m) {
+    for (int i = 0; i < p->t; i++) {
+        sbox(state[i], p->full[r * p->t + i]);
+    }
+    mix(state, m, p->t);
+}
+
+void poseidon_permute(const poseidon_params *p, u256 *state) {
+    int t = p->t;
+    for (int r = 0; r < FULL_ROUNDS/2 - 1; r++) {
+        full_round(p, state, r, p->mds);
+    }
+    full_round(p, state, FULL_ROUNDS/2 - 1, p->pre);
+    for (int r = 0; r < p->partial_rounds; r++) {
+        sbox(state[0], p->partial[r]);
+        mix_sparse(state, p->sparse + r * (2*t - 1), t);
+    }
+    for (int r = FULL_ROUNDS/2; r < FULL_ROUNDS; r++) {
+        full_round(p, state, r, p->mds);
+    }
+}
+
+bool poseidon_hash(u256 out, const u256 *inputs, size_t n) {
+    if (n < 1 || n > (size_t)poseidon_max_inputs) {
+        return false;
+    }
+    // Montgomery multiplication by R2 reduces any 256 bit input below r
+    u256 state[MAX_T];
+    clear_words(state[0], 4);
+    for (size_t i = 0; i < n; i++) {
+        bn254_fr_from(state[i + 1], inputs[i]);
+    }
+    poseidon_permute(&poseidon_widths[n - 1], state);
+    bn254_fr_to(out, state[0]);
+    return true;
+}
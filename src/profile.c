@@ -0,0 +1,43 @@
+/*
+* Ink profile table, only compiled in with -DINK_PROFILE
+* */
+#include <profile.h>
+#include <arena.h>
+
+#ifdef INK_PROFILE
+
+static uint64_t profile_count[PROF_SITES];
+static uint64_t profile_ink[PROF_SITES];
+
+void profile_record(int site, uint64_t ink_before) {
+    uint64_t ink = ink_before - evm_ink_left();
+    profile_count[site]++;
+    profile_ink[site] += ink;
+}
+
+static void write_u64(uint8_t *dst, uint64_t x) {
+    // big endian
+    x = __builtin_bswap64(x);
+    __builtin_memcpy(dst, &x, sizeof(uint64_t));
+}
+
+const uint8_t *profile_output(const uint8_t *data, size_t *len) {
+    size_t n = *len;
+    uint8_t *buf = arena_alloc(n + (PROF_SITES+1)*32);
+    if (n > 0) {
+        __builtin_memcpy(buf, data, n);
+    }
+
+    uint8_t *trailer = buf + n;
+    __builtin_memset(trailer, 0, (PROF_SITES+1)*32);
+    for (int i = 0; i < PROF_SITES; i++) {
+        write_u64(trailer+(i*32)+8, profile_count[i]);
+        write_u64(trailer+(i*32)+24, profile_ink[i]);
+    }
+    write_u64(trailer+(PROF_SITES*32)+24, PROF_SITES);
+
+    *len = n + (PROF_SITES+1)*32;
+    return buf;
+}
+
+#endif // INK_PROFILE
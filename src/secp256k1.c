@@ -0,0 +1,625 @@
+/*
+* secp256k1 points, scalar multiplication and ECDSA
+* */
+#include <secp256k1.h>
+#include <fields.h>
+#include <arena.h>
+#include <hostio.h>
+
+#define fe_add secp256k1_fp_add
+#define fe_sub secp256k1_fp_sub
+#define fe_mul secp256k1_fp_mul
+#define fe_sqr secp256k1_fp_sqr
+#define fe_neg secp256k1_fp_neg
+#define fe_inv secp256k1_fp_inv
+#define fe_eq secp256k1_fp_eq
+#define fe_is_zero secp256k1_fp_is_zero
+
+static const u256 curve_b = {7, 0, 0, 0};
+
+// p - n, the x coordinates in [n, p) are the ones that exceed r by n
+static const u256 p_minus_n = {0x402da1722fc9baeeULL, 0x4551231950b75fc4ULL,
+                               0x0000000000000001ULL, 0x0000000000000000ULL};
+
+static const u256 half_n = {0xdfe92f46681b20a0ULL, 0x5d576e7357a4501dULL,
+                            0xffffffffffffffffULL, 0x7fffffffffffffffULL};
+
+// the endomorphism: lambda * (x, y) = (beta * x, y)
+static const u256 beta = {0xc1396c28719501eeULL, 0x9cf0497512f58995ULL,
+                          0x6e64479eac3434e9ULL, 0x7ae96a2b657c0710ULL};
+static const u256 lambda = {0xdf02967c1b23bd72ULL, 0x122e22ea20816678ULL,
+                            0xa5261c028812645aULL, 0x5363ad4cc05c30e0ULL};
+
+// the lattice basis for the split and its rounded inverse, g = 2^384 b / n,
+// as in libsecp256k1
+static const u256 minus_b1 = {0x6f547fa90abfe4c3ULL, 0xe4437ed6010e8828ULL,
+                              0x0000000000000000ULL, 0x0000000000000000ULL};
+static const u256 minus_b2 = {0xd765cda83db1562cULL, 0x8a280ac50774346dULL,
+                              0xfffffffffffffffeULL, 0xffffffffffffffffULL};
+static const u256 g1 = {0xe893209a45dbb031ULL, 0x3daa8a1471e8ca7fULL,
+                        0xe86c90e49284eb15ULL, 0x3086d221a7d46bcdULL};
+static const u256 g2 = {0x1571b4ae8ac47f71ULL, 0x221208ac9df506c6ULL,
+                        0x6f547fa90abfe4c4ULL, 0xe4437ed6010e8828ULL};
+
+/*
+    points
+*/
+static void set_infinity(secp256k1_jacobian *r) {
+    clear_words(r->x, 4);
+    clear_words(r->y, 4);
+    clear_words(r->z, 4);
+}
+
+static bool is_infinity(const secp256k1_jacobian *a) {
+    return fe_is_zero(a->z);
+}
+
+void secp256k1_double(secp256k1_jacobian *r, const secp256k1_jacobian *a) {
+    // dbl-2009-l, for curves with a = 0. 2 * infinity has z = 0 too.
+    u256 A, B, C, D, E, F, t, z3;
+    fe_sqr(A, a->x);
+    fe_sqr(B, a->y);
+    fe_sqr(C, B);
+    fe_add(t, a->x, B);
+    fe_sqr(t, t);
+    fe_sub(t, t, A);
+    fe_sub(t, t, C);
+    fe_add(D, t, t);
+    fe_add(E, A, A);
+    fe_add(E, E, A);
+    fe_sqr(F, E);
+    fe_mul(z3, a->y, a->z);
+    fe_add(z3, z3, z3);
+
+    fe_add(t, D, D);
+    fe_sub(r->x, F, t);
+    fe_sub(t, D, r->x);
+    fe_mul(t, E, t);
+    fe_add(C, C, C);
+    fe_add(C, C, C);
+    fe_add(C, C, C);
+    fe_sub(r->y, t, C);
+    copy_words(r->z, z3, 4);
+}
+
+void secp256k1_add(secp256k1_jacobian *r, const secp256k1_jacobian *a,
+                   const secp256k1_jacobian *b) {
+    // add-2007-bl
+    if (is_infinity(a)) {
+        *r = *b;
+        return;
+    }
+    if (is_infinity(b)) {
+        *r = *a;
+        return;
+    }
+    u256 z1z1, z2z2, u1, u2, s1, s2, h, rr, t;
+    fe_sqr(z1z1, a->z);
+    fe_sqr(z2z2, b->z);
+    fe_mul(u1, a->x, z2z2);
+    fe_mul(u2, b->x, z1z1);
+    fe_mul(s1, a->y, b->z);
+    fe_mul(s1, s1, z2z2);
+    fe_mul(s2, b->y, a->z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, u1);
+    fe_sub(rr, s2, s1);
+    if (fe_is_zero(h)) {
+        if (fe_is_zero(rr)) {
+            secp256k1_double(r, a);
+        } else {
+            set_infinity(r);
+        }
+        return;
+    }
+
+    u256 i, j, v, z3;
+    fe_add(i, h, h);
+    fe_sqr(i, i);
+    fe_mul(j, h, i);
+    fe_add(rr, rr, rr);
+    fe_mul(v, u1, i);
+    fe_add(z3, a->z, b->z);
+    fe_sqr(z3, z3);
+    fe_sub(z3, z3, z1z1);
+    fe_sub(z3, z3, z2z2);
+    fe_mul(r->z, z3, h);
+
+    fe_sqr(t, rr);
+    fe_sub(t, t, j);
+    fe_sub(t, t, v);
+    fe_sub(r->x, t, v);
+    fe_sub(t, v, r->x);
+    fe_mul(t, rr, t);
+    fe_mul(s1, s1, j);
+    fe_add(s1, s1, s1);
+    fe_sub(r->y, t, s1);
+}
+
+void secp256k1_add_affine(secp256k1_jacobian *r, const secp256k1_jacobian *a,
+                          const secp256k1_affine *b) {
+    // madd-2007-bl, b has z = 1
+    if (b->infinity) {
+        *r = *a;
+        return;
+    }
+    if (is_infinity(a)) {
+        copy_words(r->x, (u64 *)b->x, 4);
+        copy_words(r->y, (u64 *)b->y, 4);
+        secp256k1_fp_one(r->z);
+        return;
+    }
+    u256 z1z1, u2, s2, h, rr, t;
+    fe_sqr(z1z1, a->z);
+    fe_mul(u2, b->x, z1z1);
+    fe_mul(s2, b->y, a->z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, a->x);
+    fe_sub(rr, s2, a->y);
+    if (fe_is_zero(h)) {
+        if (fe_is_zero(rr)) {
+            secp256k1_double(r, a);
+        } else {
+            set_infinity(r);
+        }
+        return;
+    }
+
+    u256 hh, i, j, v, y1j;
+    fe_sqr(hh, h);
+    fe_add(i, hh, hh);
+    fe_add(i, i, i);
+    fe_mul(j, h, i);
+    fe_add(rr, rr, rr);
+    fe_mul(v, a->x, i);
+    fe_mul(y1j, a->y, j);
+    fe_add(y1j, y1j, y1j);
+    fe_add(r->z, a->z, h);
+    fe_sqr(r->z, r->z);
+    fe_sub(r->z, r->z, z1z1);
+    fe_sub(r->z, r->z, hh);
+
+    fe_sqr(t, rr);
+    fe_sub(t, t, j);
+    fe_sub(t, t, v);
+    fe_sub(r->x, t, v);
+    fe_sub(t, v, r->x);
+    fe_mul(t, rr, t);
+    fe_sub(r->y, t, y1j);
+}
+
+// r = a with z^-1 = zi
+static void scale(secp256k1_affine *r, const secp256k1_jacobian *a,
+                  const u256 zi) {
+    u256 zi2, zi3;
+    fe_sqr(zi2, zi);
+    fe_mul(zi3, zi2, zi);
+    fe_mul(r->x, a->x, zi2);
+    fe_mul(r->y, a->y, zi3);
+    r->infinity = false;
+}
+
+static void affine_infinity(secp256k1_affine *r) {
+    clear_words(r->x, 4);
+    clear_words(r->y, 4);
+    r->infinity = true;
+}
+
+void secp256k1_to_affine(secp256k1_affine *r, const secp256k1_jacobian *a) {
+    if (is_infinity(a)) {
+        affine_infinity(r);
+        return;
+    }
+    u256 zi;
+    fe_inv(zi, a->z);
+    scale(r, a, zi);
+}
+
+void secp256k1_to_affine_batch(secp256k1_affine *r,
+                               const secp256k1_jacobian *a, size_t n) {
+    // the z's of points at infinity are 0, and so are their inverses
+    size_t mark = arena_mark();
+    u256 *zi = arena_alloc(2 * n * sizeof(u256));
+    for (size_t i = 0; i < n; i++) {
+        copy_words(zi[i], (u64 *)a[i].z, 4);
+    }
+    secp256k1_fp_inv_batch(zi, zi, n, zi + n);
+    for (size_t i = 0; i < n; i++) {
+        if (is_infinity(&a[i])) {
+            affine_infinity(&r[i]);
+        } else {
+            scale(&r[i], &a[i], zi[i]);
+        }
+    }
+    arena_release(mark);
+}
+
+// y^2 for x
+static void curve_rhs(u256 r, const u256 x) {
+    u256 t;
+    fe_sqr(t, x);
+    fe_mul(t, t, x);
+    fe_add(r, t, curve_b);
+}
+
+static bool below_p(const u256 x) {
+    return less_than((u64 *)x, (u64 *)secp256k1_fp_P);
+}
+
+bool secp256k1_on_curve(const secp256k1_affine *a) {
+    if (a->infinity || !below_p(a->x) || !below_p(a->y)) {
+        return false;
+    }
+    u256 lhs, rhs;
+    fe_sqr(lhs, a->y);
+    curve_rhs(rhs, a->x);
+    return fe_eq(lhs, rhs);
+}
+
+bool secp256k1_decompress(secp256k1_affine *r, const u256 x, bool odd) {
+    if (!below_p(x)) {
+        return false;
+    }
+    u256 rhs, y, t;
+    curve_rhs(rhs, x);
+    secp256k1_fp_sqrt(y, rhs);
+    fe_sqr(t, y);
+    if (!fe_eq(t, rhs)) {
+        return false;
+    }
+    if ((y[0] & 1) != odd) {
+        fe_neg(y, y);
+    }
+    copy_words(r->x, (u64 *)x, 4);
+    copy_words(r->y, y, 4);
+    r->infinity = false;
+    return true;
+}
+
+/*
+    scalars, mod n
+*/
+static void scalar_mul(u256 r, const u256 a, const u256 b) {
+    // two Montgomery products: a b / R, then times R^2 / R
+    secp256k1_fn_mul(r, a, b);
+    secp256k1_fn_mul(r, r, secp256k1_fn_R2);
+}
+
+static void scalar_inv(u256 r, const u256 a) {
+    u256 t;
+    secp256k1_fn_from(t, a);
+    secp256k1_fn_inv(t, t);
+    secp256k1_fn_to(r, t);
+}
+
+// inverts the n scalars in place with one inversion, none may be zero
+static void scalar_inv_batch(u256 *x, size_t n) {
+    size_t mark = arena_mark();
+    u256 *prefix = arena_alloc(n * sizeof(u256));
+    for (size_t i = 0; i < n; i++) {
+        secp256k1_fn_from(x[i], x[i]);
+    }
+    secp256k1_fn_inv_batch(x, x, n, prefix);
+    for (size_t i = 0; i < n; i++) {
+        secp256k1_fn_to(x[i], x[i]);
+    }
+    arena_release(mark);
+}
+
+// any u256 mod n, since 2^256 < 2n
+static void scalar_reduce(u256 r, const u256 a) {
+    copy_words(r, (u64 *)a, 4);
+    field_sub_if_above(r, 0, secp256k1_fn_P);
+}
+
+// 0 < a < n
+static bool scalar_valid(const u256 a) {
+    return !is_zero((u64 *)a) && less_than((u64 *)a, (u64 *)secp256k1_fn_P);
+}
+
+// round(k * g / 2^384)
+static void mul_shift_384(u256 r, const u256 k, const u256 g) {
+    u512 x;
+    umul(x, k, g);
+    u64 carry = add64(&r[0], x[6], x[5] >> 63, 0);
+    add64(&r[1], x[7], 0, carry);
+    r[2] = 0;
+    r[3] = 0;
+}
+
+// a or n - a, whichever is smaller
+static bool scalar_abs(u256 a) {
+    if (!less_than((u64 *)half_n, a)) {
+        return false;
+    }
+    secp256k1_fn_neg(a, a);
+    return true;
+}
+
+void secp256k1_split_lambda(u256 k1, bool *neg1, u256 k2, bool *neg2,
+                            const u256 k) {
+    // k2 = c1 (-b1) + c2 (-b2), k1 = k - k2 lambda, with c1 and c2 the
+    // rounded coordinates of k in the lattice basis
+    u256 kk, c1, c2, t;
+    scalar_reduce(kk, k);
+    mul_shift_384(c1, kk, g1);
+    mul_shift_384(c2, kk, g2);
+    scalar_mul(c1, c1, minus_b1);
+    scalar_mul(c2, c2, minus_b2);
+    secp256k1_fn_add(k2, c1, c2);
+    scalar_mul(t, k2, lambda);
+    secp256k1_fn_sub(k1, kk, t);
+    *neg1 = scalar_abs(k1);
+    *neg2 = scalar_abs(k2);
+}
+
+/*
+    scalar multiplication
+*/
+void secp256k1_mul_gen(secp256k1_jacobian *r, const u256 k) {
+    // bit 64j + 32b + i of k is tooth j of the comb for block b at step i
+    u256 kk;
+    scalar_reduce(kk, k);
+    set_infinity(r);
+    for (int i = 31; i >= 0; i--) {
+        secp256k1_double(r, r);
+        for (int b = 0; b < SECP256K1_COMB_BLOCKS; b++) {
+            int index = 0;
+            for (int j = 0; j < SECP256K1_COMB_TEETH; j++) {
+                index |= (int)((kk[j] >> (32*b + i)) & 1) << j;
+            }
+            if (index != 0) {
+                secp256k1_add_affine(r, r, &secp256k1_g_comb[b][index]);
+            }
+        }
+    }
+}
+
+// the window of the points' wNAF digits, with 2^(W-2) odd multiples each
+#define POINT_WINDOW 5
+#define POINT_TABLE (1 << (POINT_WINDOW - 2))
+
+// digits of a split scalar, below 2^128
+#define WNAF_LEN 130
+
+// one scalar of the sum, split into k1 for the point and k2 for lambda times
+// the point
+typedef struct msm_term {
+    const secp256k1_affine *table;
+    int8_t digits[2][WNAF_LEN];
+    bool neg[2];
+} msm_term;
+
+static int split_term(msm_term *t, const u256 k, int w) {
+    u256 k1, k2;
+    if (k[2] == 0 && k[3] == 0) {
+        // already short, like the coefficients of a batch
+        copy_words(k1, (u64 *)k, 4);
+        clear_words(k2, 4);
+        t->neg[0] = false;
+        t->neg[1] = false;
+    } else {
+        secp256k1_split_lambda(k1, &t->neg[0], k2, &t->neg[1], k);
+    }
+    __builtin_memset(t->digits, 0, sizeof(t->digits));
+    int len1 = u256_wnaf(t->digits[0], k1, w);
+    int len2 = u256_wnaf(t->digits[1], k2, w);
+    return len1 > len2 ? len1 : len2;
+}
+
+// odd[i] = (2i + 1) p
+static void odd_multiples(secp256k1_jacobian *odd, const secp256k1_affine *p) {
+    secp256k1_jacobian p2;
+    copy_words(odd[0].x, (u64 *)p->x, 4);
+    copy_words(odd[0].y, (u64 *)p->y, 4);
+    secp256k1_fp_one(odd[0].z);
+    secp256k1_double(&p2, &odd[0]);
+    for (int i = 1; i < POINT_TABLE; i++) {
+        secp256k1_add(&odd[i], &odd[i-1], &p2);
+    }
+}
+
+void secp256k1_msm(secp256k1_jacobian *r, const u256 g,
+                   const secp256k1_affine *points, const u256 *scalars,
+                   size_t n) {
+    size_t mark = arena_mark();
+    msm_term *terms = arena_alloc((n + 1) * sizeof(msm_term));
+    size_t m = 0;
+    int len = 0;
+
+    // G's odd multiples are static, so its digits can be wider
+    if (g != NULL && !is_zero((u64 *)g)) {
+        terms[m].table = secp256k1_g_odd;
+        int l = split_term(&terms[m++], g, SECP256K1_G_WINDOW);
+        len = l > len ? l : len;
+    }
+
+    // the points' odd multiples, made affine with one inversion
+    size_t first = m;
+    secp256k1_affine *tables =
+        arena_alloc(n * POINT_TABLE * sizeof(secp256k1_affine));
+    size_t jmark = arena_mark();
+    secp256k1_jacobian *odd =
+        arena_alloc(n * POINT_TABLE * sizeof(secp256k1_jacobian));
+    for (size_t i = 0; i < n; i++) {
+        u256 k;
+        scalar_reduce(k, scalars[i]);
+        if (points[i].infinity || is_zero(k)) {
+            continue;
+        }
+        odd_multiples(&odd[(m - first) * POINT_TABLE], &points[i]);
+        terms[m].table = &tables[(m - first) * POINT_TABLE];
+        int l = split_term(&terms[m++], k, POINT_WINDOW);
+        len = l > len ? l : len;
+    }
+    secp256k1_to_affine_batch(tables, odd, (m - first) * POINT_TABLE);
+    arena_release(jmark);
+
+    // one chain of doublings for every digit of every term
+    set_infinity(r);
+    for (int i = len - 1; i >= 0; i--) {
+        secp256k1_double(r, r);
+        for (size_t j = 0; j < m; j++) {
+            for (int s = 0; s < 2; s++) {
+                int d = terms[j].digits[s][i];
+                if (d == 0) {
+                    continue;
+                }
+                secp256k1_affine e = terms[j].table[(d < 0 ? -d : d) >> 1];
+                if (s == 1) {
+                    fe_mul(e.x, e.x, beta);
+                }
+                if ((d < 0) != terms[j].neg[s]) {
+                    fe_neg(e.y, e.y);
+                }
+                secp256k1_add_affine(r, r, &e);
+            }
+        }
+    }
+    arena_release(mark);
+}
+
+/*
+    ECDSA
+*/
+// whether a's x coordinate is r mod n, without making a affine
+static bool x_matches(const secp256k1_jacobian *a, const u256 r) {
+    u256 z2, t, x;
+    fe_sqr(z2, a->z);
+    fe_mul(t, r, z2);
+    if (fe_eq(t, a->x)) {
+        return true;
+    }
+    // x may also be r + n, when that is below p
+    if (!less_than((u64 *)r, (u64 *)p_minus_n)) {
+        return false;
+    }
+    u64 carry = 0;
+    for (int i = 0; i < 4; i++) {
+        carry = add64(&x[i], r[i], secp256k1_fn_P[i], carry);
+    }
+    fe_mul(t, x, z2);
+    return fe_eq(t, a->x);
+}
+
+bool secp256k1_verify(const u256 hash, const u256 r, const u256 s,
+                      const secp256k1_affine *pubkey) {
+    if (!scalar_valid(r) || !scalar_valid(s) || !secp256k1_on_curve(pubkey)) {
+        return false;
+    }
+    // R = (hash / s) G + (r / s) Q
+    u256 z, w, u1, u2;
+    scalar_reduce(z, hash);
+    scalar_inv(w, s);
+    scalar_mul(u1, z, w);
+    scalar_mul(u2, r, w);
+
+    secp256k1_jacobian R;
+    secp256k1_msm(&R, u1, pubkey, (const u256 *)&u2, 1);
+    return !is_infinity(&R) && x_matches(&R, r);
+}
+
+bool secp256k1_recover(secp256k1_affine *pubkey, const u256 hash, int v,
+                       const u256 r, const u256 s) {
+    secp256k1_affine R;
+    if (!scalar_valid(r) || !scalar_valid(s) || (v != 0 && v != 1)
+        || !secp256k1_decompress(&R, r, v)) {
+        return false;
+    }
+    // Q = (-hash / r) G + (s / r) R
+    u256 z, w, u1, u2;
+    scalar_reduce(z, hash);
+    scalar_inv(w, r);
+    scalar_mul(u1, z, w);
+    secp256k1_fn_neg(u1, u1);
+    scalar_mul(u2, s, w);
+
+    secp256k1_jacobian Q;
+    secp256k1_msm(&Q, u1, &R, (const u256 *)&u2, 1);
+    if (is_infinity(&Q)) {
+        return false;
+    }
+    secp256k1_to_affine(pubkey, &Q);
+    return true;
+}
+
+static void store_be(uint8_t *out, const u256 x) {
+    for (int i = 0; i < 4; i++) {
+        u64 limb = __builtin_bswap64(x[3-i]);
+        __builtin_memcpy(out + 8*i, &limb, 8);
+    }
+}
+
+bool secp256k1_verify_batch(const secp256k1_signature *sigs, size_t n) {
+    size_t mark = arena_mark();
+    secp256k1_affine *points = arena_alloc(2 * n * sizeof(secp256k1_affine));
+    u256 *scalars = arena_alloc(2 * n * sizeof(u256));
+
+    // the coefficients are keccak256(seed, i), with a seed that commits to
+    // every signature, so they can't be chosen to cancel a bad one
+    uint8_t *buf = arena_alloc(n * 192 > 64 ? n * 192 : 64);
+    for (size_t i = 0; i < n; i++) {
+        u256 v = {(u64)sigs[i].v, 0, 0, 0};
+        store_be(buf + 192*i, sigs[i].hash);
+        store_be(buf + 192*i + 32, sigs[i].r);
+        store_be(buf + 192*i + 64, sigs[i].s);
+        store_be(buf + 192*i + 96, v);
+        store_be(buf + 192*i + 128, sigs[i].pubkey.x);
+        store_be(buf + 192*i + 160, sigs[i].pubkey.y);
+    }
+    uint8_t seed[32];
+    native_keccak256(buf, n * 192, seed);
+
+    bool ok = true;
+    u256 *w = arena_alloc(n * sizeof(u256));
+    for (size_t i = 0; i < n && ok; i++) {
+        const secp256k1_signature *sig = &sigs[i];
+        ok = scalar_valid(sig->r) && scalar_valid(sig->s)
+             && (sig->v == 0 || sig->v == 1)
+             && secp256k1_on_curve(&sig->pubkey)
+             && secp256k1_decompress(&points[2*i+1], sig->r, sig->v);
+        copy_words(w[i], (u64 *)sig->s, 4);
+    }
+    if (ok) {
+        scalar_inv_batch(w, n);
+    }
+
+    u256 g = {0, 0, 0, 0};
+    for (size_t i = 0; i < n && ok; i++) {
+        const secp256k1_signature *sig = &sigs[i];
+
+        // a = 1 for the first signature, a 128 bit hash for the others
+        u256 a = {1, 0, 0, 0};
+        if (i > 0) {
+            uint8_t h[32];
+            u256 index = {(u64)i, 0, 0, 0};
+            __builtin_memcpy(buf, seed, 32);
+            store_be(buf + 32, index);
+            native_keccak256(buf, 64, h);
+            __builtin_memcpy(&a[0], h, 8);
+            __builtin_memcpy(&a[1], h + 8, 8);
+            a[0] |= is_zero(a);
+        }
+
+        u256 z, u1, u2;
+        scalar_reduce(z, sig->hash);
+        scalar_mul(u1, z, w[i]);
+        scalar_mul(u2, sig->r, w[i]);
+
+        // a u1 G + a u2 Q + a (-R), which keeps R's scalar at 128 bits
+        scalar_mul(u1, u1, a);
+        secp256k1_fn_add(g, g, u1);
+        points[2*i] = sig->pubkey;
+        scalar_mul(scalars[2*i], u2, a);
+        fe_neg(points[2*i+1].y, points[2*i+1].y);
+        copy_words(scalars[2*i+1], a, 4);
+    }
+
+    if (ok) {
+        secp256k1_jacobian sum;
+        secp256k1_msm(&sum, g, points, (const u256 *)scalars, 2 * n);
+        ok = is_infinity(&sum);
+    }
+    arena_release(mark);
+    return ok;
+}
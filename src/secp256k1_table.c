@@ -0,0 +1,106 @@
+// Generated by scripts/gen_secp256k1_table.js, do not edit.
+#include <secp256k1.h>
+
+const secp256k1_affine secp256k1_g_odd[16] = {
+    {{0x59f2815b16f81798ULL, 0x029bfcdb2dce28d9ULL, 0x55a06295ce870b07ULL, 0x79be667ef9dcbbacULL},
+     {0x9c47d08ffb10d4b8ULL, 0xfd17b448a6855419ULL, 0x5da4fbfc0e1108a8ULL, 0x483ada7726a3c465ULL}, false},
+    {{0x8601f113bce036f9ULL, 0xb531c845836f99b0ULL, 0x49344f85f89d5229ULL, 0xf9308a019258c310ULL},
+     {0x6cb9fd7584b8e672ULL, 0x6500a99934c2231bULL, 0x0fe337e62a37f356ULL, 0x388f7b0f632de814ULL}, false},
+    {{0xcba8d569b240efe4ULL, 0xe88b84bddc619ab7ULL, 0x55b4a7250a5c5128ULL, 0x2f8bde4d1a072093ULL},
+     {0xdca87d3aa6ac62d6ULL, 0xf788271bab0d6840ULL, 0xd4dba9dda6c9c426ULL, 0xd8ac222636e5e3d6ULL}, false},
+    {{0xe92bddedcac4f9bcULL, 0x3d419b7e0330e39cULL, 0xa398f365f2ea7a0eULL, 0x5cbdf0646e5db4eaULL},
+     {0xa5082628087264daULL, 0xa813d0b813fde7b5ULL, 0xa3178d6d861a54dbULL, 0x6aebca40ba255960ULL}, false},
+    {{0xc35f110dfc27ccbeULL, 0xe09796974c57e714ULL, 0x09ad178a9f559abdULL, 0xacd484e2f0c7f653ULL},
+     {0x05cc262ac64f9c37ULL, 0xadd888a4375f8e0fULL, 0x64380971763b61e9ULL, 0xcc338921b0a7d9fdULL}, false},
+    {{0xbbec17895da008cbULL, 0x5649980be5c17891ULL, 0x5ef4246b70c65aacULL, 0x774ae7f858a9411eULL},
+     {0x301d74c9c953c61bULL, 0x372db1e2dff9d6a8ULL, 0x0243dd56d7b7b365ULL, 0xd984a032eb6b5e19ULL}, false},
+    {{0xdeeddf8f19405aa8ULL, 0xb075fbc6610e58cdULL, 0xc7d1d205c3748651ULL, 0xf28773c2d975288bULL},
+     {0x29b5cb52db03ed81ULL, 0x3a1a06da521fa91fULL, 0x758212eb65cdaf47ULL, 0x0ab0902e8d880a89ULL}, false},
+    {{0x44adbcf8e27e080eULL, 0x31e5946f3c85f79eULL, 0x5a465ae3095ff411ULL, 0xd7924d4f7d43ea96ULL},
+     {0xc504dc9ff6a26b58ULL, 0xea40af2bd896d3a5ULL, 0x83842ec228cc6defULL, 0x581e2872a86c72a6ULL}, false},
+    {{0x66e4faa04a2d4a34ULL, 0xeb9898ae79b97687ULL, 0xa420fee807eacf21ULL, 0xdefdea4cdb677750ULL},
+     {0xcfb199f69e56eb77ULL, 0xced1f4a04a95c0f6ULL, 0xe997b0ead2a93daeULL, 0x4211ab0694635168ULL}, false},
+    {{0x7475656138385b6cULL, 0xf06acfebd7e86d27ULL, 0x93ef5cff444f4979ULL, 0x2b4ea0a797a443d2ULL},
+     {0xb570c854e5c09b7aULL, 0x1a01f60c50269763ULL, 0xb343083b5a1c8613ULL, 0x85e89bc037945d93ULL}, false},
+    {{0x81340aef25be59d5ULL, 0x1d9ad40271f81071ULL, 0x4f93fa332ce33330ULL, 0x352bbf4a4cdd1256ULL},
+     {0x67bd3d8bcf81998cULL, 0x4a1b3b2e71b1039cULL, 0xd59c18259dda3e1fULL, 0x321eb4075348f534ULL}, false},
+    {{0xdc9cdadd4ecacc3fULL, 0xe42ab8dfeff5ff29ULL, 0x0230010559879124ULL, 0x2fa2104d6b38d11bULL},
+     {0x423ba76b532b7d67ULL, 0x181d70ecfc882648ULL, 0xb64569335bd5dd80ULL, 0x02de1068295dd865ULL}, false},
+    {{0x69ca0cd7f5453714ULL, 0x263c3d84e09572e2ULL, 0xab21a9b066edda83ULL, 0x9248279b09b4d68dULL},
+     {0xe54a32ce97cb3402ULL, 0x3fc0de2a887912ffULL, 0x5d1aa71bdea2b1ffULL, 0x73016f7bf234aadeULL}, false},
+    {{0x7e996d443dee8729ULL, 0x2f570e144bf615c0ULL, 0x8e70132fb0beb752ULL, 0xdaed4f2be3a8bf27ULL},
+     {0xab40e52290be1c55ULL, 0x3f83c230f3afa726ULL, 0xd4a1aca87ef8d700ULL, 0xa69dce4a7d6c98e8ULL}, false},
+    {{0xe6a3b5e87d22e7dbULL, 0x11ecd9e9fdf281b0ULL, 0x8acf28d7cbb19f90ULL, 0xc44d12c7065d812eULL},
+     {0xa039063f0e0e6482ULL, 0x0e106e861edf61c5ULL, 0x76c45926c982fdacULL, 0x2119a460ce326cdcULL}, false},
+    {{0xb61c65cbd269e6b4ULL, 0x152b695336c28063ULL, 0xc89a20cfded60853ULL, 0x6a245bf6dc698504ULL},
+     {0xfd5e6348100d8a82ULL, 0x8b33ba48d0423b6eULL, 0x8b3f5126f16a24adULL, 0xe022cf42c2bd4a70ULL}, false},
+};
+
+const secp256k1_affine secp256k1_g_comb[2][16] = {
+  {
+    {{0, 0, 0, 0}, {0, 0, 0, 0}, true},
+    {{0x59f2815b16f81798ULL, 0x029bfcdb2dce28d9ULL, 0x55a06295ce870b07ULL, 0x79be667ef9dcbbacULL},
+     {0x9c47d08ffb10d4b8ULL, 0xfd17b448a6855419ULL, 0x5da4fbfc0e1108a8ULL, 0x483ada7726a3c465ULL}, false},
+    {{0x13b7e0e742d0e6bdULL, 0xf774d163db0f5e53ULL, 0x82a2147c104d6ecbULL, 0x3322d401243c4e25ULL},
+     {0x24f3a2e96c28b2a0ULL, 0x2805f63ea2873af6ULL, 0xbfb019bc4ddaf9b7ULL, 0x56e70797e9664ef5ULL}, false},
+    {{0xdca81127829d122aULL, 0x8f17f31467e99549ULL, 0x9b8890856a8a9e73ULL, 0x583fdfd9846dd99dULL},
+     {0xf3c7719e63c4eac4ULL, 0xb44685a3b734b37aULL, 0x9f92d2d6572a47a6ULL, 0xabc6232f2ff57d81ULL}, false},
+    {{0x1b7b444c9ec4c0daULL, 0xe88c5678723ea335ULL, 0x9239c1ad981f162eULL, 0x8f68b9d2f63b5f33ULL},
+     {0xf23cbf79501fff82ULL, 0xbbea2cfe95510bfdULL, 0xde1d90c2b6be215dULL, 0x662a9f2dba063986ULL}, false},
+    {{0x63c5e885114cbf09ULL, 0x2f27ce937be77e3eULL, 0xdaa6d12df54a3e33ULL, 0x8b300e513eff872cULL},
+     {0x26c6ff28b3b10a39ULL, 0x08f6a7aa9aaf7169ULL, 0x446f0d466b8238eaULL, 0x1cec30677f43c0ccULL}, false},
+    {{0xba16ce6a075e9070ULL, 0xbc26893d9b5cfe37ULL, 0xe1ddadfe9c510774ULL, 0x90922d88fe3ae2f4ULL},
+     {0x653943cc5c08824aULL, 0x06d74475fce8f4bcULL, 0x8d101fa7533c615dULL, 0x7b1903f6742108a9ULL}, false},
+    {{0x1bcfa45c6ebdc96cULL, 0xe400bc041c7584baULL, 0x6395e20e74cf531fULL, 0x1edd0bb1c5131b30ULL},
+     {0xa117161be358cf9eULL, 0xe490d6f02724d11cULL, 0xf75062f6ee6dd8c9ULL, 0x31e03b2bfba373e4ULL}, false},
+    {{0x7f3b58fa2120e2b3ULL, 0x7a58fdce7f47f9aaULL, 0xe7be4ae34ce6e521ULL, 0xeaa649f21f51bdbaULL},
+     {0xd47a5305ba5ad93dULL, 0x01a6b965f13f7e59ULL, 0xc69a80f89879aa5aULL, 0xbe3279ed5bbbb03aULL}, false},
+    {{0xcf291a3327bb4d71ULL, 0x6caf7d6b33524832ULL, 0x6e0ee131766584eeULL, 0x160cb0f6d064c589ULL},
+     {0x9d5de55417136e8dULL, 0xe3f2d4681aab720eULL, 0xd1378b49ccf75cc2ULL, 0x6920c375c4ff16e1ULL}, false},
+    {{0x3eef9e961a9ee611ULL, 0xfe4d7bf39cc37fafULL, 0x462aa9b3b321d965ULL, 0x1702da3e208736c5ULL},
+     {0xfba57bbf3a545cebULL, 0x6dbcd7667ea858f5ULL, 0x088e897c680d92f1ULL, 0x468c1fd8bc626c80ULL}, false},
+    {{0xb40f85c7b188660aULL, 0xc5873c1999bc3c36ULL, 0x3c7b45417f33b54cULL, 0x4cd3a93c1f8c9bf8ULL},
+     {0xf8dce38033099cb0ULL, 0x7a167dd62edd2f33ULL, 0x576d89870ffe35b7ULL, 0xd2de0386c68ace5cULL}, false},
+    {{0x9a9e0a726658bb08ULL, 0xe23c5f2ac589607bULL, 0xa048ca14f2bfb4c8ULL, 0x4d9a0f89c62c2291ULL},
+     {0x427b5f310f827294ULL, 0x1ea7a8b59f2c35cdULL, 0x95442e5685a3c00fULL, 0x8cb831219b57975aULL}, false},
+    {{0x4333f0da51f5cf67ULL, 0x6d3ea47cf4f0d3cbULL, 0x442fda14a05a831fULL, 0x6a496013016d3e81ULL},
+     {0xf647318ce52e0f48ULL, 0x5ff3a66e4a0d5ff1ULL, 0x046ed81a61199ba8ULL, 0x578edf083e79c23aULL}, false},
+    {{0xb8f996f83ea01ea7ULL, 0xc0045d337497bb15ULL, 0xc4749dc96205647cULL, 0xd89460540efd22c9ULL},
+     {0x062dcb0912774ad5ULL, 0xcb13f3108be06e3aULL, 0xca281d35235de1a9ULL, 0xaf8a741269c3645cULL}, false},
+    {{0x8808ca5fbeb8b1e2ULL, 0x0262b204ea0dda76ULL, 0xb6fffffcddeb356bULL, 0x52de253afbb83870ULL},
+     {0x961f40c08f8d21eaULL, 0x89686278002f03edULL, 0x0ff834d738e421eaULL, 0x3a270d6fd36fb8dbULL}, false},
+  },
+  {
+    {{0, 0, 0, 0}, {0, 0, 0, 0}, true},
+    {{0xefd7835b39a48db0ULL, 0x9f1215a29b3c03bfULL, 0x2791d0a09b7bde45ULL, 0x100f44da696e7167ULL},
+     {0x0fbd5cd62bc65a09ULL, 0xb7ff4a18ff5195acULL, 0x2ec8f3300c090666ULL, 0xcdd9e13192a00b77ULL}, false},
+    {{0x32427e2840fb27b6ULL, 0xc76e3db2be430576ULL, 0x10f238ad61686aa5ULL, 0xfea74e3dbe778b1bULL},
+     {0x701d3db7f23cb96fULL, 0x126b596b973f7b77ULL, 0x7cf674deccb6af93ULL, 0x6e0568db9b0b1329ULL}, false},
+    {{0x6cac51542c8118bcULL, 0x19bd4b34399ddd98ULL, 0x47248a8d2e9c8949ULL, 0x734cb6a82cefa3b1ULL},
+     {0xf1b340ad1e410fd5ULL, 0xa2982beec4873539ULL, 0x7b5a3ea4d4de4530ULL, 0xae46e10e42202574ULL}, false},
+    {{0xcbfc99c8ac1f98cdULL, 0x523489054d7f0308ULL, 0xfaed8a9c1cc66021ULL, 0x9c3919a84a474870ULL},
+     {0xbe7e5e03d4fc599dULL, 0x905326f76c64c8e6ULL, 0x584f044bf260e641ULL, 0xddb84f0f4a4ddd57ULL}, false},
+    {{0xc4aacaa8ed7cebedULL, 0xb75d2dce4fae424eULL, 0xa01585a2ba20735eULL, 0x3d75f24bba122399ULL},
+     {0xcbe4606fd5570dceULL, 0x9d00bfd72da192c2ULL, 0x9c3ce86ba57b7265ULL, 0x987a22f1ec4edf5eULL}, false},
+    {{0x211b971573ea0665ULL, 0x86f485d4f3a1abbbULL, 0xabd242d8cd076f0eULL, 0x862332ab0ba5dc88ULL},
+     {0x09af505c7b784911ULL, 0xc89544e8caf4fae7ULL, 0x256625f6ae9a32ebULL, 0xe2532b72606d1a3fULL}, false},
+    {{0x79e9f3130deaf885ULL, 0x938ff76e46df21c9ULL, 0x1968f5fba953bb2cULL, 0xdff538bf29155f27ULL},
+     {0xf7bae0b131d5d020ULL, 0x5afdc7871a676a8dULL, 0x11b4f032fa9d53ffULL, 0x86ba433ec5959167ULL}, false},
+    {{0x884fdff09475b7baULL, 0xe039e730e4918b3dULL, 0x3d3e57edf5018cdbULL, 0x959396981943785cULL},
+     {0xe9b8abf87524f2fdULL, 0x9c653f64c8709385ULL, 0x8ba0386a4b9cd684ULL, 0x2e7e552888c331ddULL}, false},
+    {{0x940bef53eefe79e5ULL, 0xc518d286be9b87f3ULL, 0x9e0c7c767833042cULL, 0x104e2cb511fbe152ULL},
+     {0xc0d35e0f50bbec83ULL, 0xee4879be4acd0fccULL, 0xc8d80f5d006085eeULL, 0x3c51bc1c72fe1ac1ULL}, false},
+    {{0x06187f61b2de976eULL, 0x52869e18f5e4b4b6ULL, 0x74d4facd38d332caULL, 0x5c1c90b4b3a2f8d9ULL},
+     {0x98644d09daa37893ULL, 0x682435a8abe39818ULL, 0x17e46617469c53a0ULL, 0x642f963277dc2e64ULL}, false},
+    {{0xad2101c5222f6c54ULL, 0xb05c7a58fa74785eULL, 0xce55fa79489bcdafULL, 0xc1f920fdffe88d54ULL},
+     {0x32553ab09065e490ULL, 0x7611b9af35329f74ULL, 0x57df19efab7b24c0ULL, 0xb9a787496181c447ULL}, false},
+    {{0x392f156fa80b7ea8ULL, 0x57ab7ca08ae4a8bfULL, 0xac32074750c4b178ULL, 0x146041b90e781febULL},
+     {0xd343f075845279b2ULL, 0x2d4fe7577387afa5ULL, 0x151e0948a72f3c39ULL, 0x41a6d54e550da168ULL}, false},
+    {{0xb3134ed3075a0010ULL, 0x9fa76f4b7ae93e23ULL, 0xc0db256f7bb4daaaULL, 0x7668dc27464dd8a3ULL},
+     {0x150063f59f5da977ULL, 0x3acac5c805efce00ULL, 0xc8e12ffc884493feULL, 0x4ab936d888f06bd2ULL}, false},
+    {{0x996fde775d09ea98ULL, 0x16ddf5124145da58ULL, 0xa97a6ca8dc2fb225ULL, 0xc7331f30fbdcdf5aULL},
+     {0x838f99e086a86e52ULL, 0x68d39b2977795eddULL, 0xe4e4f97e9f412aaaULL, 0xe5cc2c0a30d25352ULL}, false},
+    {{0xb3d686509c21ff71ULL, 0x11e7589dddbe3884ULL, 0x7efd4055423bac67ULL, 0x587a729346957425ULL},
+     {0x360adc2e8f5a8fc6ULL, 0x6f8bbafbbd69f12eULL, 0xf671f4230a3f3b4dULL, 0xb49acb4759942dc3ULL}, false},
+  },
+};
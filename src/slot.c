@@ -0,0 +1,134 @@
+/*
+* Write-back storage slot cache
+* */
+#include <slot.h>
+#include <hostio.h>
+
+typedef struct slot_entry {
+    uint8_t key[32];
+    u256 value;
+    bool used;
+    bool dirty;
+} slot_entry;
+
+static slot_entry slot_table[SLOT_CACHE_SIZE];
+static int slot_count;
+
+void slot_reset(void) {
+    // wasm starts every call with a zeroed table, so this is usually free
+    if (slot_count > 0) {
+        __builtin_memset(slot_table, 0, sizeof(slot_table));
+        slot_count = 0;
+    }
+}
+
+void slot_flush(void) {
+    uint8_t word[32];
+    for (int i = 0; i < SLOT_CACHE_SIZE && slot_count > 0; i++) {
+        slot_entry *e = &slot_table[i];
+        if (!e->used || !e->dirty) {
+            continue;
+        }
+        // little endian -> big endian
+        for (int j = 0; j < 4; j++) {
+            u64 limb = __builtin_bswap64(e->value[3-j]);
+            __builtin_memcpy(word+(j*8), &limb, 8);
+        }
+        storage_store_bytes32(e->key, word);
+        e->dirty = false;
+    }
+}
+
+static u64 slot_hash(const bebi32 key) {
+    // keys are either small integers or keccak hashes, mix both ends
+    u64 hi, lo;
+    __builtin_memcpy(&hi, key, 8);
+    __builtin_memcpy(&lo, key+24, 8);
+    return (hi ^ lo) * 0x9e3779b97f4a7c15ULL;
+}
+
+static slot_entry *slot_lookup(const bebi32 key) {
+    u64 h = slot_hash(key) >> (64 - __builtin_ctz(SLOT_CACHE_SIZE));
+    for (;;) {
+        slot_entry *e = &slot_table[h & (SLOT_CACHE_SIZE-1)];
+        if (!e->used) {
+            break;
+        }
+        if (__builtin_memcmp(e->key, key, 32) == 0) {
+            return e;
+        }
+        h++;
+    }
+
+    // keep the table at most 3/4 full, writing everything back when it fills
+    if (slot_count >= (SLOT_CACHE_SIZE*3)/4) {
+        slot_flush();
+        slot_reset();
+        return slot_lookup(key);
+    }
+
+    slot_entry *e = &slot_table[h & (SLOT_CACHE_SIZE-1)];
+    uint8_t word[32];
+    storage_load_bytes32(key, word);
+    // big endian -> little endian
+    for (int j = 0; j < 4; j++) {
+        __builtin_memcpy(&e->value[3-j], word+(j*8), 8);
+        e->value[3-j] = __builtin_bswap64(e->value[3-j]);
+    }
+    __builtin_memcpy(e->key, key, 32);
+    e->used = true;
+    e->dirty = false;
+    slot_count++;
+    return e;
+}
+
+void slot_get(u256 res, const bebi32 key) {
+    copy_words(&res[0], slot_lookup(key)->value, 4);
+}
+
+void slot_set(const bebi32 key, u256 value) {
+    slot_entry *e = slot_lookup(key);
+    copy_words(e->value, &value[0], 4);
+    e->dirty = true;
+}
+
+void slot_add(const bebi32 key, u256 x) {
+    slot_entry *e = slot_lookup(key);
+    u256_add(e->value, e->value, x);
+    e->dirty = true;
+}
+
+int slot_sub_checked(const bebi32 key, u256 x) {
+    slot_entry *e = slot_lookup(key);
+    if (less_than(e->value, x)) {
+        return -1;
+    }
+    u256_sub(e->value, e->value, x);
+    e->dirty = true;
+    return 0;
+}
+
+int slot_mul_div(const bebi32 key, u256 num, u256 den) {
+    if (is_zero(den)) {
+        return -1;
+    }
+    slot_entry *e = slot_lookup(key);
+
+    u512 p, quot;
+    umul(p, e->value, num);
+    if ((p[4] | p[5] | p[6] | p[7]) == 0) {
+        u256_div(e->value, &p[0], den);
+        e->dirty = true;
+        return 0;
+    }
+
+    // the high half is non zero, so p has more words than den
+    clear_words(&quot[0], 8);
+    udivrem(quot, p, 8, den, NULL);
+    if ((quot[4] | quot[5] | quot[6] | quot[7]) != 0) {
+        return -1;
+    }
+    copy_words(e->value, &quot[0], 4);
+    e->dirty = true;
+    return 0;
+}
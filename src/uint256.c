@@ -2,6 +2,7 @@
 * EVM Opcodes
 * */
 #include <uint256.h>
+#include <profile.h>
 
 /*
     arithmetic operations
@@ -68,7 +69,7 @@ void u256_div(u256 res, u256 x, u256 y) {
     }
 
     u256 _;
-    udivrem(res, x, 4, y, _);
+    PROFILE(PROF_UDIVREM, udivrem(res, x, 4, y, _));
 }
 
 void u256_sdiv(u256 res, u256 n, u256 d) {
@@ -123,7 +124,7 @@ void u256_mod(u256 res, u256 x, u256 y) {
     }
 
     u256 _;
-    udivrem(_, x, 4, y, res);
+    PROFILE(PROF_UDIVREM, udivrem(_, x, 4, y, res));
 }
 
 void u256_smod(u256 res, u256 x, u256 m) {
@@ -147,7 +148,36 @@ void u256_smod(u256 res, u256 x, u256 m) {
     }
 }
 
+#ifdef U256_BRANCH_FREE
+// The reciprocal of the last modulus, as callers tend to repeat one
+#ifdef __wasm__
+static u256 add_mod_m;
+static u320 add_mod_mu;
+#else
+static _Thread_local u256 add_mod_m;
+static _Thread_local u320 add_mod_mu;
+#endif
+#endif
+
 void u256_add_mod(u256 res, u256 x, u256 y, u256 m) {
+#ifdef U256_BRANCH_FREE
+    // reduce the 257 bit sum with reduce4, which only branches on m
+    if (m[3] != 0) {
+        u512 sum;
+        clear_words(&sum[0], 8);
+        sum[4] = add64(&sum[0], x[0], y[0], 0);
+        sum[4] = add64(&sum[1], x[1], y[1], sum[4]);
+        sum[4] = add64(&sum[2], x[2], y[2], sum[4]);
+        sum[4] = add64(&sum[3], x[3], y[3], sum[4]);
+        if (!eq(m, add_mod_m)) {
+            copy_words(&add_mod_m[0], &m[0], 4);
+            PROFILE(PROF_RECIPROCAL, reciprocal(add_mod_mu, m));
+        }
+        PROFILE(PROF_REDUCE4, reduce4(res, sum, m, add_mod_mu));
+        return;
+    }
+#else
+    // x and y are below 2m here, so subtracting m once reduces them
     if ((m[3] != 0) && (x[3] <= m[3]) && (y[3] <= m[3])) {
         u64 gte_c1 = 0;
         u64 gte_c2 = 0;
@@ -194,6 +224,7 @@ void u256_add_mod(u256 res, u256 x, u256 y, u256 m) {
         copy_words(&res[0], &tmp[0], 4);
         return;
     }
+#endif
 
     if (is_zero(m)) {
         clear_words(&res[0], 4);
@@ -206,7 +237,7 @@ void u256_add_mod(u256 res, u256 x, u256 y, u256 m) {
     if (overflow) {
         sum[4] = 1;
         u64 quot[5]; clear_words(&quot[0], 5);
-        udivrem(quot, sum, 5, m, res);
+        PROFILE(PROF_UDIVREM, udivrem(quot, sum, 5, m, res));
         return;
     }
     u256_mod(res, sum, m);
@@ -222,8 +253,8 @@ void u256_mul_mod(u256 res, u256 x, u256 y, u256 m) {
 
     if (m[3] != 0) {
         u320 mu;
-        reciprocal(mu, m);
-        reduce4(res, p, m, mu);
+        PROFILE(PROF_RECIPROCAL, reciprocal(mu, m));
+        PROFILE(PROF_REDUCE4, reduce4(res, p, m, mu));
         return;
     }
 
@@ -237,7 +268,7 @@ void u256_mul_mod(u256 res, u256 x, u256 y, u256 m) {
     }
 
     u512 _;
-    udivrem(_, p, 8, m, res);
+    PROFILE(PROF_UDIVREM, udivrem(_, p, 8, m, res));
 }
 
 void u256_exp(u256 res, u256 base, u256 exponent) {
@@ -247,6 +278,7 @@ void u256_exp(u256 res, u256 base, u256 exponent) {
     copy_words(&multiplier[0], &base[0], 4);
     int exp_bit_len = bit_len(exponent);
 
+    PROFILE_BEGIN(exp);
     int cur_bit = 0;
     u64 word = exponent[0];
     for (;cur_bit < exp_bit_len && cur_bit < 64; cur_bit++) {
@@ -283,6 +315,7 @@ void u256_exp(u256 res, u256 base, u256 exponent) {
         squared(multiplier);
         word >>= 1;
     }
+    PROFILE_END(exp, PROF_EXP_LOOP);
 }
 
 void u256_sign_extend(u256 res, u256 x, u256 b) {
@@ -338,6 +371,18 @@ bool u256_gt(u256 x, u256 y) {
     return greater_than(x, y);
 }
 
+#ifdef U256_BRANCH_FREE
+// flipping the sign bits maps the signed order onto the unsigned one
+bool u256_slt(u256 x, u256 y) {
+    u256 a = {x[0], x[1], x[2], x[3] ^ 0x8000000000000000ULL};
+    u256 b = {y[0], y[1], y[2], y[3] ^ 0x8000000000000000ULL};
+    return less_than(a, b);
+}
+
+bool u256_sgt(u256 x, u256 y) {
+    return u256_slt(y, x);
+}
+#else
 bool u256_slt(u256 x, u256 y) {
     int x_sign = sign(x);
     int y_sign = sign(y);
@@ -363,6 +408,7 @@ bool u256_sgt(u256 x, u256 y) {
 
     return greater_than(x, y);
 }
+#endif // U256_BRANCH_FREE
 
 bool u256_eq(u256 x, u256 y) {
     return eq(x, y);
@@ -441,3 +487,90 @@ void u256_sar(u256 res, u256 value, u256 shift) {
     }
     srsh(res, value, shift[0]);
 }
+
+/*
+    bit counting
+*/
+void u256_clz(u256 res, u256 x) {
+    u64 n = 256 - bit_len(x);
+    clear_words(&res[0], 4);
+    res[0] = n;
+}
+
+void u256_ctz(u256 res, u256 x) {
+    u64 n = 256;
+    for (int i = 3; i >= 0; i--) {
+        if (x[i] != 0) {
+            n = 64*i + __builtin_ctzll(x[i]);
+        }
+    }
+    clear_words(&res[0], 4);
+    res[0] = n;
+}
+
+void u256_popcount(u256 res, u256 x) {
+    u64 n = __builtin_popcountll(x[0]) + __builtin_popcountll(x[1])
+          + __builtin_popcountll(x[2]) + __builtin_popcountll(x[3]);
+    clear_words(&res[0], 4);
+    res[0] = n;
+}
+
+static inline u64 reverse64(u64 x) {
+#if __has_builtin(__builtin_bitreverse64)
+    return __builtin_bitreverse64(x);
+#else
+    // swap bits, pairs and nibbles, then the bytes
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    x = ((x >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((x & 0x0f0f0f0f0f0f0f0fULL) << 4);
+    return __builtin_bswap64(x);
+#endif
+}
+
+void u256_bit_reverse(u256 res, u256 x) {
+    u64 lo = reverse64(x[0]);
+    u64 hi = reverse64(x[1]);
+    res[0] = reverse64(x[3]);
+    res[1] = reverse64(x[2]);
+    res[2] = hi;
+    res[3] = lo;
+}
+
+void u256_bswap(u256 res, u256 x) {
+    u64 lo = __builtin_bswap64(x[0]);
+    u64 hi = __builtin_bswap64(x[1]);
+    res[0] = __builtin_bswap64(x[3]);
+    res[1] = __builtin_bswap64(x[2]);
+    res[2] = hi;
+    res[3] = lo;
+}
+
+int u256_wnaf(int8_t *digits, const u256 x, int w) {
+    u256 t;
+    copy_words(t, (u64 *)x, 4);
+    int len = 0;
+    while (!is_zero(t)) {
+        int d = 0;
+        if (t[0] & 1) {
+            d = (int)(t[0] & ((1ULL << w) - 1));
+            if (d >= 1 << (w - 1)) {
+                d -= 1 << w;
+            }
+            // t -= d clears the low w bits
+            if (d > 0) {
+                t[0] -= (u64)d;
+            } else {
+                u64 carry = add64(&t[0], t[0], (u64)-d, 0);
+                for (int i = 1; i < 4; i++) {
+                    carry = add64(&t[i], t[i], 0, carry);
+                }
+            }
+        }
+        digits[len++] = (int8_t)d;
+        for (int i = 0; i < 3; i++) {
+            t[i] = (t[i] >> 1) | (t[i+1] << 63);
+        }
+        t[3] >>= 1;
+    }
+    return len;
+}
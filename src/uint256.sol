@@ -37,4 +37,44 @@ abstract contract Uint256 {
     function Shl(uint x, uint shift) public pure virtual returns (uint z);
     function Shr(uint x, uint shift) public pure virtual returns (uint z);
     function Sar(uint x, uint shift) public pure virtual returns (uint z);
+
+    // bit counting
+    function Clz(uint x) public pure virtual returns (uint z);
+    function Ctz(uint x) public pure virtual returns (uint z);
+    function Popcount(uint x) public pure virtual returns (uint z);
+
+    // signatures, see include/secp256k1.h
+    function EcRecover(bytes32 hash, uint8 v, bytes32 r, bytes32 s) public pure virtual returns (address);
+    function EcVerifyBatch(uint[] memory sigs) public pure virtual returns (bool);
+
+    // returns 1, or no data if the signature is invalid, like the RIP-7212
+    // precompile
+    function P256Verify(bytes32 hash, bytes32 r, bytes32 s, bytes32 x, bytes32 y) public pure virtual returns (uint);
+
+    // BN254, with the input and output of the precompiles 0x06 and 0x07
+    function EcAdd(uint x1, uint y1, uint x2, uint y2) public pure virtual returns (uint x, uint y);
+    function EcMul(uint x1, uint y1, uint k) public pure virtual returns (uint x, uint y);
+    function EcMsm(uint[] memory terms) public pure virtual returns (uint x, uint y);
+    function EcPairing(uint[] memory pairs) public pure virtual returns (bool);
+
+    // poseidon
+    function Poseidon(uint[] memory inputs) public pure virtual returns (uint);
+
+    // batch
+    function Batch(bytes memory program) public pure virtual returns (uint[] memory);
+    function Exec(bytes memory code, uint[] memory inputs) public pure virtual returns (uint[] memory);
+
+    // arrays
+    function AddArray(uint[] memory x, uint[] memory y) public pure virtual returns (uint[] memory);
+    function MulArray(uint[] memory x, uint[] memory y) public pure virtual returns (uint[] memory);
+    function MulModArray(uint[] memory x, uint[] memory y, uint m) public pure virtual returns (uint[] memory);
+    function InvModArray(uint[] memory x, uint m) public pure virtual returns (uint[] memory);
+    function SumArray(uint[] memory x) public pure virtual returns (uint z);
+    function DotMod(uint[] memory x, uint[] memory y, uint m) public pure virtual returns (uint z);
+    function LtMask(uint[] memory x, uint[] memory y) public pure virtual returns (uint[] memory);
+
+    // packed: called with the selector followed by the packed bytes, not an
+    // ABI encoded bytes argument. See include/packed.h and scripts/packed.js
+    function AddPacked(bytes memory data) public pure virtual returns (uint z);
+    function BatchPacked(bytes memory program) public pure virtual returns (uint[] memory);
 }
@@ -16,56 +16,9 @@ void copy_words(u64 *dest, u64 *src, int num_words) {
     __builtin_memcpy(dest, src, num_words * sizeof(u64));
 }
 
-static const unsigned char len8tab[] = {
-    0x00, 0x01, 0x02, 0x02, 0x03, 0x03, 0x03, 0x03,
-    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
-    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
-    0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
-    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
-    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
-    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
-    0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
-    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
-    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
-    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
-    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
-    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
-    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
-    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
-    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
-    0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08
-};
-
 u64 len64(u64 x) {
-    u64 n = 0;
-    if (x >= (1ULL<<32ULL)) {
-        x >>= 32;
-        n = 32ULL;
-    }
-    if (x >= (1ULL<<16ULL)) {
-        x >>= 16;
-        n += 16ULL;
-    }
-    if (x >= (1ULL<<8ULL)) {
-        x >>= 8;
-        n += 8ULL;
-    }
-    return n + len8tab[x];
+    // a single i64.clz on wasm, the zero check folds into a select
+    return x == 0 ? 0 : 64 - __builtin_clzll(x);
 }
 
 u64 leading_zeros64(u64 x) {
@@ -580,6 +533,60 @@ void srsh64(u256 res, u256 x) {
     res[3] = 0xffffffffffffffffULL;
 }
 
+#ifdef U256_BRANCH_FREE
+/*
+    Funnel shifts by n % 64 followed by a masked select of the whole limb
+    shift n / 64, so the instructions run don't depend on n. Shifts of 256
+    and more select nothing and return zero.
+*/
+void lsh(u256 res, u256 x, u64 n) {
+    u64 s = n & 63;
+    u64 q = n >> 6;
+    u256 t;
+    // (y >> 1) >> (63 - s) is y >> (64 - s) without shifting by 64
+    t[0] = x[0] << s;
+    t[1] = (x[1] << s) | ((x[0] >> 1) >> (63 - s));
+    t[2] = (x[2] << s) | ((x[1] >> 1) >> (63 - s));
+    t[3] = (x[3] << s) | ((x[2] >> 1) >> (63 - s));
+
+    for (int i = 0; i < 4; i++) {
+        u64 r = 0;
+        for (int k = 0; k <= i; k++) {
+            r |= t[i-k] & -(u64)(q == (u64)k);
+        }
+        res[i] = r;
+    }
+}
+
+void rsh(u256 res, u256 x, u64 n) {
+    u64 s = n & 63;
+    u64 q = n >> 6;
+    u256 t;
+    t[0] = (x[0] >> s) | ((x[1] << 1) << (63 - s));
+    t[1] = (x[1] >> s) | ((x[2] << 1) << (63 - s));
+    t[2] = (x[2] >> s) | ((x[3] << 1) << (63 - s));
+    t[3] = x[3] >> s;
+
+    for (int i = 0; i < 4; i++) {
+        u64 r = 0;
+        for (int k = 0; i + k < 4; k++) {
+            r |= t[i+k] & -(u64)(q == (u64)k);
+        }
+        res[i] = r;
+    }
+}
+
+void srsh(u256 res, u256 x, u64 n) {
+    // for a negative x, ~(~x >> n) shifts in ones
+    u64 fill = -(x[3] >> 63);
+    u256 y = {x[0] ^ fill, x[1] ^ fill, x[2] ^ fill, x[3] ^ fill};
+    rsh(res, y, n);
+    res[0] ^= fill;
+    res[1] ^= fill;
+    res[2] ^= fill;
+    res[3] ^= fill;
+}
+#else
 void lsh(u256 res, u256 x, u64 n) {
     if (n == 0) {
         copy_words(&res[0], &x[0], 4);
@@ -726,6 +733,7 @@ void srsh(u256 res, u256 x, u64 n) {
         }
     }
 }
+#endif // U256_BRANCH_FREE
 
 void reciprocal(u320 mu, u256 m) {
     if (m[3] == 0) {
@@ -1110,6 +1118,33 @@ void reduce4(u256 res, u512 x, u256 m, u64 *mu) {
     b = sub64(&r3, x3, r3, b);
     b = sub64(&r4, x4, r4, b);
 
+#ifdef U256_BRANCH_FREE
+    // the estimate of the quotient is at most one too large and three too
+    // small, so add m back under a mask and make exactly three masked
+    // subtractions instead of looping
+    u64 mask = -b;
+    c = add64(&r0, r0, m[0] & mask, 0);
+    c = add64(&r1, r1, m[1] & mask, c);
+    c = add64(&r2, r2, m[2] & mask, c);
+    c = add64(&r3, r3, m[3] & mask, c);
+        add64(&r4, r4,           0, c);
+
+    for (int i = 0; i < 3; i++) {
+        b = sub64(&q0, r0, m[0], 0);
+        b = sub64(&q1, r1, m[1], b);
+        b = sub64(&q2, r2, m[2], b);
+        b = sub64(&q3, r3, m[3], b);
+        b = sub64(&q4, r4,    0, b);
+
+        // keep the difference when it didn't borrow
+        mask = b - 1;
+        r0 = (q0 & mask) | (r0 & ~mask);
+        r1 = (q1 & mask) | (r1 & ~mask);
+        r2 = (q2 & mask) | (r2 & ~mask);
+        r3 = (q3 & mask) | (r3 & ~mask);
+        r4 = (q4 & mask) | (r4 & ~mask);
+    }
+#else
     if (b != 0) {
         c = add64(&r0, r0, m[0], 0);
         c = add64(&r1, r1, m[1], c);
@@ -1135,6 +1170,7 @@ void reduce4(u256 res, u512 x, u256 m, u64 *mu) {
         r1 = q1;
         r0 = q0;
     }
+#endif // U256_BRANCH_FREE
 
     res[3] = r3;
     res[2] = r2;
@@ -0,0 +1,121 @@
+/*
+* Big endian opcodes, in place on bebi32 words
+* */
+#include <uint256be.h>
+
+static inline u64 load64(const uint8_t *src) {
+    u64 x;
+    __builtin_memcpy(&x, src, sizeof(u64));
+    return x;
+}
+
+static inline void store64(uint8_t *dst, u64 x) {
+    __builtin_memcpy(dst, &x, sizeof(u64));
+}
+
+/*
+    comparison operations
+*/
+static int cmp(const bebi32 x, const bebi32 y) {
+    // the most significant word comes first
+    for (int i = 0; i < 32; i += 8) {
+        u64 a = __builtin_bswap64(load64(x+i));
+        u64 b = __builtin_bswap64(load64(y+i));
+        if (a != b) {
+            return a < b ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+bool u256be_lt(const bebi32 x, const bebi32 y) {
+    return cmp(x, y) < 0;
+}
+
+bool u256be_gt(const bebi32 x, const bebi32 y) {
+    return cmp(x, y) > 0;
+}
+
+bool u256be_slt(const bebi32 x, const bebi32 y) {
+    bool x_neg = x[0] >= 0x80;
+    bool y_neg = y[0] >= 0x80;
+    if (x_neg != y_neg) {
+        return x_neg;
+    }
+    return cmp(x, y) < 0;
+}
+
+bool u256be_sgt(const bebi32 x, const bebi32 y) {
+    return u256be_slt(y, x);
+}
+
+bool u256be_eq(const bebi32 x, const bebi32 y) {
+    return ((load64(x) ^ load64(y)) | (load64(x+8) ^ load64(y+8))
+          | (load64(x+16) ^ load64(y+16)) | (load64(x+24) ^ load64(y+24))) == 0;
+}
+
+bool u256be_is_zero(const bebi32 x) {
+    return (load64(x) | load64(x+8) | load64(x+16) | load64(x+24)) == 0;
+}
+
+void u256be_set_bool(bebi32 x, bool b) {
+    __builtin_memset(x, 0, 31);
+    x[31] = b;
+}
+
+/*
+    bitwise operations
+*/
+void u256be_and(bebi32 x, const bebi32 y) {
+    for (int i = 0; i < 32; i += 8) {
+        store64(x+i, load64(x+i) & load64(y+i));
+    }
+}
+
+void u256be_or(bebi32 x, const bebi32 y) {
+    for (int i = 0; i < 32; i += 8) {
+        store64(x+i, load64(x+i) | load64(y+i));
+    }
+}
+
+void u256be_xor(bebi32 x, const bebi32 y) {
+    for (int i = 0; i < 32; i += 8) {
+        store64(x+i, load64(x+i) ^ load64(y+i));
+    }
+}
+
+void u256be_not(bebi32 x) {
+    for (int i = 0; i < 32; i += 8) {
+        store64(x+i, ~load64(x+i));
+    }
+}
+
+void u256be_byte(bebi32 x, const bebi32 i) {
+    // byte 0 is the most significant, which is also the first in memory
+    uint8_t b = 0;
+    uint8_t hi = 0;
+    for (int k = 0; k < 31; k++) {
+        hi |= i[k];
+    }
+    if (hi == 0 && i[31] < 32) {
+        b = x[i[31]];
+    }
+    u256be_set_bool(x, false);
+    x[31] = b;
+}
+
+void u256be_shl_bytes(bebi32 x, int n) {
+    __builtin_memmove(x, x+n, 32-n);
+    __builtin_memset(x+(32-n), 0, n);
+}
+
+void u256be_shr_bytes(bebi32 x, int n) {
+    __builtin_memmove(x+n, x, 32-n);
+    __builtin_memset(x, 0, n);
+}
+
+void u256be_sar_bytes(bebi32 x, int n) {
+    uint8_t fill = x[0] >= 0x80 ? 0xff : 0;
+    __builtin_memmove(x+n, x, 32-n);
+    __builtin_memset(x, fill, n);
+}
@@ -0,0 +1,201 @@
+/*
+* Element-wise opcodes over struct of arrays
+* */
+#include <uint256v.h>
+#include <arena.h>
+
+void u256v_alloc(u256v *v, size_t n) {
+    u64 *limbs = arena_alloc(4 * n * sizeof(u64));
+    for (int j = 0; j < 4; j++) {
+        v->limb[j] = limbs + (j * n);
+    }
+    v->n = n;
+}
+
+void u256v_get(u256 x, const u256v *v, size_t i) {
+    x[0] = v->limb[0][i];
+    x[1] = v->limb[1][i];
+    x[2] = v->limb[2][i];
+    x[3] = v->limb[3][i];
+}
+
+void u256v_set(u256v *v, size_t i, u256 x) {
+    v->limb[0][i] = x[0];
+    v->limb[1][i] = x[1];
+    v->limb[2][i] = x[2];
+    v->limb[3][i] = x[3];
+}
+
+void u256v_add(u256v *res, const u256v *x, const u256v *y) {
+    u64 *r0 = res->limb[0], *r1 = res->limb[1];
+    u64 *r2 = res->limb[2], *r3 = res->limb[3];
+    const u64 *x0 = x->limb[0], *x1 = x->limb[1];
+    const u64 *x2 = x->limb[2], *x3 = x->limb[3];
+    const u64 *y0 = y->limb[0], *y1 = y->limb[1];
+    const u64 *y2 = y->limb[2], *y3 = y->limb[3];
+    for (size_t i = 0; i < x->n; i++) {
+        u64 carry;
+        carry = add64(&r0[i], x0[i], y0[i], 0);
+        carry = add64(&r1[i], x1[i], y1[i], carry);
+        carry = add64(&r2[i], x2[i], y2[i], carry);
+                add64(&r3[i], x3[i], y3[i], carry);
+    }
+}
+
+void u256v_mul(u256v *res, const u256v *x, const u256v *y) {
+    u256 a, b, r;
+    for (size_t i = 0; i < x->n; i++) {
+        u256v_get(a, x, i);
+        u256v_get(b, y, i);
+        u256_mul(r, a, b);
+        u256v_set(res, i, r);
+    }
+}
+
+void u256v_mul_mod(u256v *res, const u256v *x, const u256v *y, u256 m) {
+    u256 a, b, r;
+    if (m[3] == 0) {
+        // small moduli take the udivrem path, nothing to share
+        for (size_t i = 0; i < x->n; i++) {
+            u256v_get(a, x, i);
+            u256v_get(b, y, i);
+            u256_mul_mod(r, a, b, m);
+            u256v_set(res, i, r);
+        }
+        return;
+    }
+
+    // the reciprocal only depends on m
+    u320 mu;
+    reciprocal(mu, m);
+    for (size_t i = 0; i < x->n; i++) {
+        u512 p;
+        u256v_get(a, x, i);
+        u256v_get(b, y, i);
+        umul(p, a, b);
+        reduce4(r, p, m, mu);
+        u256v_set(res, i, r);
+    }
+}
+
+void u256v_sum(u256 res, const u256v *x) {
+    const u64 *x0 = x->limb[0], *x1 = x->limb[1];
+    const u64 *x2 = x->limb[2], *x3 = x->limb[3];
+    u64 r0 = 0, r1 = 0, r2 = 0, r3 = 0;
+    for (size_t i = 0; i < x->n; i++) {
+        u64 carry;
+        carry = add64(&r0, r0, x0[i], 0);
+        carry = add64(&r1, r1, x1[i], carry);
+        carry = add64(&r2, r2, x2[i], carry);
+                add64(&r3, r3, x3[i], carry);
+    }
+    res[0] = r0;
+    res[1] = r1;
+    res[2] = r2;
+    res[3] = r3;
+}
+
+void u256v_dot_mod(u256 res, const u256v *x, const u256v *y, u256 m) {
+    clear_words(&res[0], 4);
+    if (is_zero(m)) {
+        return;
+    }
+
+    u320 mu;
+    if (m[3] != 0) {
+        reciprocal(mu, m);
+    }
+    u256 a, b, r;
+    for (size_t i = 0; i < x->n; i++) {
+        u256v_get(a, x, i);
+        u256v_get(b, y, i);
+        if (m[3] != 0) {
+            u512 p;
+            umul(p, a, b);
+            reduce4(r, p, m, mu);
+        } else {
+            u256_mul_mod(r, a, b, m);
+        }
+        // res and r are both reduced
+        u256_add_mod(res, res, r, m);
+    }
+}
+
+// r = a * b % m, with mu the reciprocal of m when m is 4 limbs
+static void mul_mod_mu(u256 r, u256 a, u256 b, u256 m, u64 *mu) {
+    if (m[3] != 0) {
+        u512 p;
+        umul(p, a, b);
+        reduce4(r, p, m, mu);
+    } else {
+        u256_mul_mod(r, a, b, m);
+    }
+}
+
+void u256v_inv_mod(u256v *res, const u256v *x, u256 m) {
+    size_t n = x->n;
+    if (m[3] == 0 && m[2] == 0 && m[1] == 0 && m[0] < 2) {
+        for (int j = 0; j < 4; j++) {
+            clear_words(res->limb[j], n);
+        }
+        return;
+    }
+    u320 mu;
+    if (m[3] != 0) {
+        reciprocal(mu, m);
+    }
+
+    // prefix[i] is the product of the nonzero elements before i, or 0 if
+    // x[i] is 0 mod m
+    size_t mark = arena_mark();
+    u256v prefix = *res;
+    if (res->limb[0] == x->limb[0]) {
+        u256v_alloc(&prefix, n);
+    }
+    u256 acc = {1, 0, 0, 0}, zero = {0, 0, 0, 0}, a, t;
+    for (size_t i = 0; i < n; i++) {
+        u256v_get(a, x, i);
+        mul_mod_mu(t, acc, a, m, mu);
+        if (is_zero(t)) {
+            u256v_set(&prefix, i, zero);
+        } else {
+            u256v_set(&prefix, i, acc);
+            copy_words(acc, t, 4);
+        }
+    }
+
+    // acc^-1 = acc^(m-2)
+    u256 e, inv = {1, 0, 0, 0}, two = {2, 0, 0, 0};
+    u256_sub(e, m, two);
+    for (int i = bit_len(e) - 1; i >= 0; i--) {
+        mul_mod_mu(inv, inv, inv, m, mu);
+        if ((e[i/64] >> (i%64)) & 1) {
+            mul_mod_mu(inv, inv, acc, m, mu);
+        }
+    }
+
+    // from the end, inv is the inverse of the product up to x[i], so
+    // x[i]^-1 = inv prefix[i] and inv x[i] is the next inv
+    for (size_t i = n; i-- > 0;) {
+        u256v_get(t, &prefix, i);
+        if (is_zero(t)) {
+            u256v_set(res, i, zero);
+            continue;
+        }
+        u256v_get(a, x, i);
+        mul_mod_mu(t, inv, t, m, mu);
+        mul_mod_mu(inv, inv, a, m, mu);
+        u256v_set(res, i, t);
+    }
+    arena_release(mark);
+}
+
+void u256v_lt_mask(u64 *mask, const u256v *x, const u256v *y) {
+    clear_words(mask, (x->n + 63) / 64);
+    u256 a, b;
+    for (size_t i = 0; i < x->n; i++) {
+        u256v_get(a, x, i);
+        u256v_get(b, y, i);
+        mask[i/64] |= (u64)less_than(a, b) << (i % 64);
+    }
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <ntt.h>
+#include <fields.h>
+
+/*
+    Native benchmarks of the NTT: forward and inverse transforms of 2^10 to
+    2^20 elements, single threaded and with the threads given as the first
+    argument, 4 by default. Times are wall clock and the best of a few runs.
+*/
+
+#define MIN_LOG 10
+#define MAX_LOG 20
+
+static double now_ms() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+static u64 xorshift() {
+    static u64 x = 88172645463325252ULL;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+}
+
+// the best time of runs of f(d, a, threads), or of the serial f if
+// threads is 0
+typedef void (*ntt_fn)(const ntt_domain *, u256 *);
+typedef void (*ntt_threads_fn)(const ntt_domain *, u256 *, int);
+
+static double best_ms(const ntt_domain *d, u256 *a, int runs, ntt_fn f,
+                      ntt_threads_fn ft, int threads) {
+    double best = 0;
+    for (int i = 0; i < runs; i++) {
+        double t0 = now_ms();
+        if (ft) {
+            ft(d, a, threads);
+        } else {
+            f(d, a);
+        }
+        double t = now_ms() - t0;
+        if (i == 0 || t < best) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    int threads = argc > 1 ? atoi(argv[1]) : 4;
+    size_t max = (size_t)1 << MAX_LOG;
+    u256 *a = malloc(max * sizeof(u256));
+    u256 *twiddles = malloc(max * sizeof(u256));
+    if (!a || !twiddles) {
+        return 1;
+    }
+    for (size_t i = 0; i < max; i++) {
+        u256 x = {xorshift(), xorshift(), xorshift(), xorshift() >> 3};
+        bn254_fr_from(a[i], x);
+    }
+
+    printf("%-6s %12s %12s %12s %12s %10s\n", "log n", "forward ms",
+           "inverse ms", "fwd thr ms", "inv thr ms", "ns/bfly");
+    for (int log_n = MIN_LOG; log_n <= MAX_LOG; log_n++) {
+        ntt_domain d;
+        ntt_domain_init(&d, log_n, twiddles);
+        int runs = log_n < 16 ? 5 : 2;
+        double fwd = best_ms(&d, a, runs, ntt_forward, NULL, 0);
+        double inv = best_ms(&d, a, runs, ntt_inverse, NULL, 0);
+        double fwd_t = best_ms(&d, a, runs, NULL, ntt_forward_threads, threads);
+        double inv_t = best_ms(&d, a, runs, NULL, ntt_inverse_threads, threads);
+        double butterflies = (double)d.n / 2 * log_n;
+        printf("%-6d %12.2f %12.2f %12.2f %12.2f %10.1f\n", log_n, fwd, inv,
+               fwd_t, inv_t, fwd * 1e6 / butterflies);
+    }
+    free(a);
+    free(twiddles);
+    return 0;
+}
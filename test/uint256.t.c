@@ -1,8 +1,32 @@
 #include <stdio.h>
 #include <assert.h>
 #include <uint256.h>
+#include <uint256be.h>
+#include <uint256v.h>
+#include <abi.h>
+#include <bitfield.h>
+#include <bitmap.h>
+#include <arena.h>
+#include <batch.h>
+#include <packed.h>
+#include <interp.h>
+#include <slot.h>
+#include <env.h>
+#include <fields.h>
+#include <secp256k1.h>
+#include <p256.h>
+#include <bn254.h>
+#include <poseidon.h>
+#include <ntt.h>
 #include "libuint256testgen.h"
 
+#ifdef U256_BRANCH_FREE
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 
 #define NUM_TESTS 10000
 
@@ -693,6 +717,2023 @@ void test_sar() {
         "Maximum shift right for negative value should return all 1s", true);
 }
 
+/*
+    Bit counting tests
+*/
+void test_bit_counting() {
+    u256 x = {0, 0, 0, 0};
+    u256 have;
+    u256 want = {256, 0, 0, 0};
+
+    u256_clz(have, x);
+    verbose_assert_eq(have, want, "Clz", "Clz of zero should be 256", true);
+    u256_ctz(have, x);
+    verbose_assert_eq(have, want, "Ctz", "Ctz of zero should be 256", true);
+
+    x[0] = 1;
+    want[0] = 255;
+    u256_clz(have, x);
+    verbose_assert_eq(have, want, "Clz", "Clz of one should be 255", true);
+    want[0] = 0;
+    u256_ctz(have, x);
+    verbose_assert_eq(have, want, "Ctz", "Ctz of one should be 0", true);
+
+    x[0] = 0; x[3] = 0x8000000000000000ULL;
+    u256_clz(have, x);
+    verbose_assert_eq(have, want, "Clz",
+                      "Clz of the top bit should be 0", true);
+    want[0] = 255;
+    u256_ctz(have, x);
+    verbose_assert_eq(have, want, "Ctz",
+                      "Ctz of the top bit should be 255", true);
+
+    x[0] = 0x100; x[1] = 0; x[2] = 0; x[3] = 0;
+    want[0] = 247;
+    u256_clz(have, x);
+    verbose_assert_eq(have, want, "Clz",
+                      "Clz should count across limbs", true);
+
+    set_all_one(x);
+    want[0] = 256;
+    u256_popcount(have, x);
+    verbose_assert_eq(have, want, "Popcount",
+                      "Popcount of all ones should be 256", true);
+
+    u256 one = {1, 0, 0, 0};
+    u256 top_bit = {0, 0, 0, 0x8000000000000000ULL};
+    u256_bit_reverse(have, one);
+    verbose_assert_eq(have, top_bit, "BitReverse",
+                      "Bit 0 should move to bit 255", true);
+
+    u256 ordered = {0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL,
+                    0x1716151413121110ULL, 0x1f1e1d1c1b1a1918ULL};
+    u256 reversed = {0x18191a1b1c1d1e1fULL, 0x1011121314151617ULL,
+                     0x08090a0b0c0d0e0fULL, 0x0001020304050607ULL};
+    u256_bswap(have, ordered);
+    verbose_assert_eq(have, reversed, "Bswap",
+                      "Byte i should move to byte 31 - i", true);
+
+    // CLZ in batch programs and bytecode
+    uint8_t program[] = {
+        BATCH_LOAD, 0, 2, 1, 0,                 // r0 = 256
+        OP_CLZ, 1, 0,                           // r1 = clz(r0)
+        BATCH_OUT, 1,
+    };
+    uint8_t out[32];
+    int n = batch_run(program, sizeof(program), out, 1);
+    verbose_assert_bool(n == 1 && out[31] == 247, true, "Clz",
+                        "Batch programs should run CLZ", true);
+
+    static u256 stack[INTERP_STACK_SIZE];
+    uint8_t code[] = {OP_PUSH1, 1, OP_CLZ};
+    int height = interp_run(code, sizeof(code), stack, 0);
+    want[0] = 255;
+    verbose_assert_bool(height == 1, true, "Clz",
+                        "Bytecode CLZ should leave one word", true);
+    verbose_assert_eq(stack[0], want, "Clz", "Bytecode should run CLZ", true);
+}
+
+/*
+    Batch tests
+*/
+// Convert a big endian output word back to little endian
+void read_be(u256 x, uint8_t *word) {
+    for (int i = 0; i < 4; i++) {
+        __builtin_memcpy(&x[i], word+(24-(i*8)), 8);
+        x[i] = __builtin_bswap64(x[i]);
+    }
+}
+
+void test_batch() {
+    uint8_t program[] = {
+        BATCH_LOAD, 0, 1, 7,                    // r0 = 7
+        BATCH_LOAD, 1, 9, 1, 0, 0, 0, 0, 0, 0, 0, 0, // r1 = 2**64
+        BATCH_LOAD, 2, 0,                       // r2 = 0
+        OP_ADD, 3, 0, 1,                        // r3 = r0 + r1
+        OP_MUL, 3, 3, 3,                        // r3 = r3 * r3
+        OP_SUB, 4, 2, 0,                        // r4 = 0 - 7
+        OP_SLT, 5, 4, 2,                        // r5 = -7 < 0
+        OP_MULMOD, 6, 3, 1, 0,                  // r6 = r3 * r1 % 7
+        BATCH_OUT, 3,
+        BATCH_OUT, 4,
+        BATCH_OUT, 5,
+        BATCH_OUT, 6,
+    };
+    uint8_t out[4*32];
+
+    int n = batch_run(program, sizeof(program), out, 4);
+    verbose_assert_bool(n == 4, true, "Batch", "Should output four words",
+                        true);
+
+    u256 have;
+    u256 want = {49, 14, 1, 0};
+    read_be(have, out);
+    verbose_assert_eq(have, want, "Batch",
+                      "Registers should chain across instructions", true);
+
+    u256 minus_seven = {MAX_U64-6, MAX_U64, MAX_U64, MAX_U64};
+    read_be(have, out+32);
+    verbose_assert_eq(have, minus_seven, "Batch", "Sub should wrap", true);
+
+    u256 one = {1, 0, 0, 0};
+    read_be(have, out+64);
+    verbose_assert_eq(have, one, "Batch",
+                      "Comparisons should write a boolean word", true);
+
+    // 2**64 % 7 == 2, so (2**64+7)**2 * 2**64 % 7 == 2**3 % 7 == 1
+    read_be(have, out+96);
+    verbose_assert_eq(have, one, "Batch",
+                      "Three operand opcodes should read all operands", true);
+
+    n = batch_run(program, sizeof(program), out, 3);
+    verbose_assert_bool(n == -1, true, "Batch",
+                        "Too many outputs should fail", true);
+
+    uint8_t bad_register[] = {OP_ADD, 0, 1, BATCH_REGISTERS};
+    n = batch_run(bad_register, sizeof(bad_register), out, 4);
+    verbose_assert_bool(n == -1, true, "Batch",
+                        "Registers out of range should fail", true);
+
+    uint8_t truncated[] = {BATCH_LOAD, 0, 4, 1, 2};
+    n = batch_run(truncated, sizeof(truncated), out, 4);
+    verbose_assert_bool(n == -1, true, "Batch",
+                        "Truncated loads should fail", true);
+
+    uint8_t unknown[] = {OP_STOP};
+    n = batch_run(unknown, sizeof(unknown), out, 4);
+    verbose_assert_bool(n == -1, true, "Batch",
+                        "Unknown opcodes should fail", true);
+}
+
+/*
+    ABI tests
+*/
+void test_abi() {
+    abi_reader r;
+    abi_words w;
+    u256 have;
+
+    // (uint256 7, bytes "abc", uint256[] [1, 2^255])
+    uint8_t data[32*8] = {0};
+    data[31] = 7;
+    data[63] = 0x60;                        // offset of the bytes
+    data[95] = 0xa0;                        // offset of the array
+    data[127] = 3;                          // bytes length
+    __builtin_memcpy(data+128, "abc", 3);
+    data[191] = 2;                          // array length
+    data[223] = 1;
+    data[224] = 0x80;
+
+    abi_init(&r, data, sizeof(data));
+    u256 seven = {7, 0, 0, 0};
+    verbose_assert_bool(abi_u256(&r, have), true, "ABI",
+                        "Static words should be read", true);
+    verbose_assert_eq(have, seven, "ABI",
+                      "Static words should be little endian", true);
+
+    const uint8_t *bytes;
+    size_t n;
+    verbose_assert_bool(abi_bytes(&r, &bytes, &n) && n == 3
+                        && bytes[0] == 'a', true, "ABI",
+                        "Bytes should point into the input", true);
+
+    verbose_assert_bool(abi_array(&r, &w) && w.left == 2, true, "ABI",
+                        "Arrays should be read", true);
+    u256 one = {1, 0, 0, 0};
+    u256 top = {0, 0, 0, 0x8000000000000000ULL};
+    abi_words_next(&w, have);
+    verbose_assert_eq(have, one, "ABI", "Elements should be in order", true);
+    abi_words_next(&w, have);
+    verbose_assert_eq(have, top, "ABI", "Elements should be in order", true);
+    verbose_assert_bool(abi_words_next(&w, have), false, "ABI",
+                        "Reading past the array should fail", true);
+
+    // an array that claims more elements than the input holds
+    data[191] = 3;
+    abi_init(&r, data, sizeof(data));
+    abi_u256(&r, have);
+    abi_bytes(&r, &bytes, &n);
+    verbose_assert_bool(abi_array(&r, &w), false, "ABI",
+                        "Arrays past the end of the input should fail", true);
+
+    data[95] = 0xff;
+    abi_init(&r, data, sizeof(data));
+    abi_u256(&r, have);
+    abi_bytes(&r, &bytes, &n);
+    verbose_assert_bool(abi_array(&r, &w), false, "ABI",
+                        "Offsets past the end of the input should fail", true);
+}
+
+/*
+    Packed tests
+*/
+void test_packed() {
+    packed_reader r;
+    u256 have;
+
+    // node scripts/packed.js 1000 0 1000 1000 255 0x10000000000000000
+    uint8_t data[] = {
+        0x01, 0x02, 0x03, 0xe8, 0x40, 0x00, 0x40, 0x40, 0x01, 0xff,
+        0x09, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+    u256 want[] = {
+        {1000, 0, 0, 0}, {0, 0, 0, 0}, {1000, 0, 0, 0}, {1000, 0, 0, 0},
+        {255, 0, 0, 0}, {0, 1, 0, 0},
+    };
+    verbose_assert_bool(packed_init(&r, data, sizeof(data)) == 0, true,
+                        "Packed", "Dictionary should be read", true);
+    for (int i = 0; i < 6; i++) {
+        verbose_assert_bool(packed_next(&r, have) == 0, true, "Packed",
+                            "Operand should be read", true);
+        verbose_assert_eq(have, want[i], "Packed",
+                          "Operand should match the encoder", true);
+    }
+    verbose_assert_bool(packed_done(&r), true, "Packed",
+                        "Every operand should be read", true);
+    verbose_assert_bool(packed_next(&r, have) == -1, true, "Packed",
+                        "Reading past the end should fail", true);
+
+    uint8_t full[33] = {32, 0x80};
+    u256 top = {0, 0, 0, 0x8000000000000000ULL};
+    verbose_assert_bool(packed_literal(have, full, sizeof(full)) == 33, true,
+                        "Packed", "32 byte literals should be read", true);
+    verbose_assert_eq(have, top, "Packed",
+                      "Literals should be big endian", true);
+
+    uint8_t truncated[] = {0x00, 0x02, 0x01};
+    packed_init(&r, truncated, sizeof(truncated));
+    verbose_assert_bool(packed_next(&r, have) == -1, true, "Packed",
+                        "Truncated literals should fail", true);
+
+    uint8_t bad_ref[] = {0x00, 0x40};
+    packed_init(&r, bad_ref, sizeof(bad_ref));
+    verbose_assert_bool(packed_next(&r, have) == -1, true, "Packed",
+                        "References past the dictionary should fail", true);
+
+    uint8_t too_long[] = {0x00, 33};
+    packed_init(&r, too_long, sizeof(too_long));
+    verbose_assert_bool(packed_next(&r, have) == -1, true, "Packed",
+                        "Literals over 32 bytes should fail", true);
+
+    uint8_t bad_dict[] = {0x02, 0x00};
+    verbose_assert_bool(packed_init(&r, bad_dict, sizeof(bad_dict)) == -1,
+                        true, "Packed", "Truncated dictionary should fail",
+                        true);
+}
+
+/*
+    Interpreter tests
+*/
+void test_interp() {
+    static u256 stack[INTERP_STACK_SIZE];
+    u256 have;
+
+    // (x + y) * 3 - 1, with x on top of the stack
+    uint8_t code[] = {
+        OP_ADD,
+        OP_PUSH1, 3,
+        OP_MUL,
+        OP_PUSH1, 1,
+        OP_SWAP1,
+        OP_SUB,
+    };
+    u256 x = {MAX_U64, 0, 0, 0};
+    u256 y = {1, 0, 0, 0};
+    copy_words(stack[0], y, 4);
+    copy_words(stack[1], x, 4);
+
+    int height = interp_run(code, sizeof(code), stack, 2);
+    verbose_assert_bool(height == 1, true, "Interp",
+                        "Should leave one word on the stack", true);
+    u256 want = {MAX_U64, 2, 0, 0};
+    verbose_assert_eq(stack[0], want, "Interp",
+                      "Operands should be taken from the top first", true);
+
+    // 1 << 4, then byte 31 of it
+    uint8_t shift[] = {
+        OP_PUSH1, 1,
+        OP_PUSH1, 4,
+        OP_SHL,
+        OP_DUP1,
+        OP_PUSH1, 31,
+        OP_BYTE,
+        OP_EQ,
+        OP_STOP,
+        OP_ADD,
+    };
+    height = interp_run(shift, sizeof(shift), stack, 0);
+    verbose_assert_bool(height == 1, true, "Interp",
+                        "Should stop at STOP", true);
+    u256 one = {1, 0, 0, 0};
+    verbose_assert_eq(stack[0], one, "Interp",
+                      "Shift and byte should take the index on top", true);
+
+    // PUSH32 immediates are converted to little endian
+    uint8_t push32[33] = {OP_PUSH32, 0x80};
+    push32[32] = 0x01;
+    height = interp_run(push32, sizeof(push32), stack, 0);
+    u256 big = {1, 0, 0, 0x8000000000000000ULL};
+    copy_words(have, stack[0], 4);
+    verbose_assert_eq(have, big, "Interp",
+                      "PUSH32 should decode a big endian word", true);
+
+    uint8_t underflow[] = {OP_PUSH0, OP_ADD};
+    height = interp_run(underflow, sizeof(underflow), stack, 0);
+    verbose_assert_bool(height == -1, true, "Interp",
+                        "Stack underflow should fail", true);
+
+    uint8_t overflow[] = {OP_PUSH0};
+    height = interp_run(overflow, sizeof(overflow), stack, INTERP_STACK_SIZE);
+    verbose_assert_bool(height == -1, true, "Interp",
+                        "Stack overflow should fail", true);
+
+    uint8_t truncated[] = {OP_PUSH1 + 1, 0};
+    height = interp_run(truncated, sizeof(truncated), stack, 0);
+    verbose_assert_bool(height == -1, true, "Interp",
+                        "Truncated pushes should fail", true);
+
+    uint8_t jump[] = {0x56};
+    height = interp_run(jump, sizeof(jump), stack, 0);
+    verbose_assert_bool(height == -1, true, "Interp",
+                        "Unsupported opcodes should fail", true);
+
+    // long code decodes into the arena, and is freed afterwards
+    static uint8_t pushes[3*8000];
+    for (int i = 0; i < sizeof(pushes); i += 3) {
+        uint8_t push_pop[] = {OP_PUSH1, i & 0xff, OP_POP};
+        __builtin_memcpy(pushes+i, push_pop, 3);
+    }
+    size_t mark = arena_mark();
+    height = interp_run(pushes, sizeof(pushes), stack, 0);
+    verbose_assert_bool(height == 0, true, "Interp",
+                        "Long code should run", true);
+    verbose_assert_bool(arena_mark() == mark, true, "Interp",
+                        "Decoded code should be released", true);
+}
+
+/*
+    Arena tests
+*/
+void test_arena() {
+    arena_reset();
+    size_t start = arena_mark();
+
+    uint8_t *a = arena_alloc(1);
+    uint8_t *b = arena_alloc(33);
+    verbose_assert_bool(((uintptr_t)a % ARENA_ALIGN) == 0
+                        && ((uintptr_t)b % ARENA_ALIGN) == 0, true, "Arena",
+                        "Allocations should be aligned", true);
+    verbose_assert_bool(b >= a + 1, true, "Arena",
+                        "Allocations should not overlap", true);
+
+    size_t mark = arena_mark();
+    arena_alloc(1000);
+    arena_release(mark);
+    verbose_assert_bool(arena_alloc(0) == b + 48, true, "Arena",
+                        "Release should free everything after the mark", true);
+
+    // natively the arena grows past a step without moving what it holds
+    b[32] = 0x5a;
+    uint8_t *big = arena_alloc(3 * ARENA_NATIVE_STEP);
+    big[0] = 1;
+    big[3 * ARENA_NATIVE_STEP - 1] = 2;
+    verbose_assert_bool(b[32] == 0x5a && big > b, true, "Arena",
+                        "Growing should keep earlier allocations", true);
+
+    arena_reset();
+    verbose_assert_bool(arena_mark() == start, true, "Arena",
+                        "Reset should free everything", true);
+}
+
+/*
+    Slot cache tests
+*/
+// fake storage, counting hostio calls
+#define STORAGE_SLOTS 1024
+static uint8_t storage_keys[STORAGE_SLOTS][32];
+static uint8_t storage_values[STORAGE_SLOTS][32];
+static int storage_count;
+static int storage_loads, storage_stores;
+
+static uint8_t *storage_find(const uint8_t *key) {
+    for (int i = 0; i < storage_count; i++) {
+        if (__builtin_memcmp(key, storage_keys[i], 32) == 0) {
+            return storage_values[i];
+        }
+    }
+    return NULL;
+}
+
+void storage_load_bytes32(const uint8_t *key, uint8_t *dest) {
+    storage_loads++;
+    uint8_t *value = storage_find(key);
+    if (value != NULL) {
+        __builtin_memcpy(dest, value, 32);
+    } else {
+        __builtin_memset(dest, 0, 32);
+    }
+}
+
+void storage_store_bytes32(const uint8_t *key, const uint8_t *value) {
+    storage_stores++;
+    uint8_t *dest = storage_find(key);
+    if (dest == NULL) {
+        __builtin_memcpy(storage_keys[storage_count], key, 32);
+        dest = storage_values[storage_count++];
+    }
+    __builtin_memcpy(dest, value, 32);
+}
+
+void test_slot() {
+    uint8_t key[32] = {0};
+    key[31] = 7;
+    u256 have;
+
+    slot_reset();
+    u256 ten = {10, 0, 0, 0};
+    u256 three = {3, 0, 0, 0};
+    slot_add(key, ten);
+    slot_add(key, ten);
+    verbose_assert_bool(slot_sub_checked(key, three) == 0, true, "Slot",
+                        "Sub should succeed", true);
+    u256 big = {0, 0, 0, 1};
+    verbose_assert_bool(slot_sub_checked(key, big) == -1, true, "Slot",
+                        "Sub should fail on underflow", true);
+
+    // 17 * 2^255 / 2^254 = 34, with a 512 bit intermediate
+    u256 num = {0, 0, 0, 0x8000000000000000ULL};
+    u256 den = {0, 0, 0, 0x4000000000000000ULL};
+    verbose_assert_bool(slot_mul_div(key, num, den) == 0, true, "Slot",
+                        "MulDiv should succeed", true);
+    slot_get(have, key);
+    u256 want = {34, 0, 0, 0};
+    verbose_assert_eq(have, want, "Slot",
+                      "MulDiv should use the full product", true);
+
+    u256 one = {1, 0, 0, 0};
+    verbose_assert_bool(slot_mul_div(key, num, one) == -1, true, "Slot",
+                        "MulDiv should fail on overflow", true);
+    verbose_assert_bool(storage_loads == 1 && storage_stores == 0, true,
+                        "Slot", "The slot should be loaded once", true);
+
+    slot_flush();
+    slot_flush();
+    verbose_assert_bool(storage_stores == 1 && storage_find(key) != NULL
+                        && storage_find(key)[31] == 34, true, "Slot",
+                        "The slot should be written back once", true);
+
+    // a fresh call reads the stored value
+    slot_reset();
+    slot_get(have, key);
+    verbose_assert_eq(have, want, "Slot",
+                      "Reset should reload from storage", true);
+
+    // filling the table writes everything back and keeps going
+    storage_stores = 0;
+    for (int i = 0; i < SLOT_CACHE_SIZE*2; i++) {
+        uint8_t k[32] = {0};
+        k[0] = i;
+        slot_set(k, one);
+    }
+    slot_flush();
+    verbose_assert_bool(storage_stores == SLOT_CACHE_SIZE*2, true, "Slot",
+                        "Every slot should be written once", true);
+}
+
+/*
+    Environment tests
+*/
+static int env_calls;
+
+uint64_t block_number() { env_calls++; return 100; }
+uint64_t block_timestamp() { env_calls++; return 1700000000; }
+uint64_t chainid() { env_calls++; return 42161; }
+void block_basefee(uint8_t *basefee) { env_calls++; __builtin_memset(basefee, 0, 32); basefee[31] = 1; }
+void tx_gas_price(uint8_t *price) { env_calls++; __builtin_memset(price, 0, 32); price[0] = 0x80; }
+void msg_value(uint8_t *value) { env_calls++; __builtin_memset(value, 0, 32); }
+void msg_sender(uint8_t *sender) { env_calls++; __builtin_memset(sender, 0xaa, 20); }
+
+void test_env() {
+    u256 have;
+
+    env_reset();
+    env_calls = 0;
+    for (int i = 0; i < 3; i++) {
+        env_block_number(have);
+        env_block_timestamp(have);
+        env_chainid(have);
+        env_block_basefee(have);
+        env_tx_gas_price(have);
+        env_msg_value(have);
+        env_msg_sender();
+    }
+    verbose_assert_bool(env_calls == 7, true, "Env",
+                        "Each value should be read once", true);
+
+    env_tx_gas_price(have);
+    u256 price = {0, 0, 0, 0x8000000000000000ULL};
+    verbose_assert_eq(have, price, "Env",
+                      "Words should be converted to little endian", true);
+
+    env_chainid(have);
+    u256 id = {42161, 0, 0, 0};
+    verbose_assert_eq(have, id, "Env", "Chain id should be a u256", true);
+
+    const uint8_t *sender = env_msg_sender();
+    verbose_assert_bool(sender[11] == 0 && sender[12] == 0xaa
+                        && sender[31] == 0xaa, true, "Env",
+                        "Sender should be left padded", true);
+
+    env_reset();
+    env_block_number(have);
+    verbose_assert_bool(env_calls == 8, true, "Env",
+                        "Reset should read again", true);
+}
+
+/*
+    Vector tests
+*/
+static u64 xorshift_state = 88172645463325252ULL;
+
+u64 xorshift() {
+    xorshift_state ^= xorshift_state << 13;
+    xorshift_state ^= xorshift_state >> 7;
+    xorshift_state ^= xorshift_state << 17;
+    return xorshift_state;
+}
+
+void test_vector() {
+    const size_t n = 300;
+    u256v x, y, res;
+    u256 a, b, want, have, sum, dot;
+
+    arena_reset();
+    u256v_alloc(&x, n);
+    u256v_alloc(&y, n);
+    u256v_alloc(&res, n);
+    for (size_t i = 0; i < n; i++) {
+        // a mix of full width and short values
+        for (int j = 0; j < 4; j++) {
+            a[j] = (i % 3 == 0 && j > 0) ? 0 : xorshift();
+            b[j] = (i % 5 == 0 && j > 1) ? 0 : xorshift();
+        }
+        u256v_set(&x, i, a);
+        u256v_set(&y, i, b);
+    }
+    u256 m = {xorshift(), xorshift(), xorshift(), xorshift() >> 1};
+    u256 small_m = {xorshift(), 0, 0, 0};
+
+    u256v_add(&res, &x, &y);
+    for (size_t i = 0; i < n; i++) {
+        u256v_get(a, &x, i);
+        u256v_get(b, &y, i);
+        u256_add(want, a, b);
+        u256v_get(have, &res, i);
+        verbose_assert_eq(have, want, "Vector", "Add should match", false);
+    }
+
+    u256v_mul(&res, &x, &y);
+    for (size_t i = 0; i < n; i++) {
+        u256v_get(a, &x, i);
+        u256v_get(b, &y, i);
+        u256_mul(want, a, b);
+        u256v_get(have, &res, i);
+        verbose_assert_eq(have, want, "Vector", "Mul should match", false);
+    }
+
+    for (int k = 0; k < 2; k++) {
+        u64 *mod = k == 0 ? m : small_m;
+        u256v_mul_mod(&res, &x, &y, mod);
+        clear_words(&dot[0], 4);
+        for (size_t i = 0; i < n; i++) {
+            u256v_get(a, &x, i);
+            u256v_get(b, &y, i);
+            u256_mul_mod(want, a, b, mod);
+            u256v_get(have, &res, i);
+            verbose_assert_eq(have, want, "Vector",
+                              "MulMod should match", false);
+            u256_add_mod(dot, dot, want, mod);
+        }
+        u256v_dot_mod(have, &x, &y, mod);
+        verbose_assert_eq(have, dot, "Vector", "DotMod should match", true);
+    }
+
+    clear_words(&sum[0], 4);
+    for (size_t i = 0; i < n; i++) {
+        u256v_get(a, &x, i);
+        u256_add(sum, sum, a);
+    }
+    u256v_sum(have, &x);
+    verbose_assert_eq(have, sum, "Vector", "Sum should match", true);
+
+    u64 mask[(300 + 63) / 64];
+    u256v_lt_mask(mask, &x, &y);
+    for (size_t i = 0; i < n; i++) {
+        u256v_get(a, &x, i);
+        u256v_get(b, &y, i);
+        verbose_assert_bool((mask[i/64] >> (i%64)) & 1, u256_lt(a, b),
+                            "Vector", "LtMask should match Lt", false);
+    }
+
+    // inverses mod primes of 4 limbs and of 1, with zeros, m itself and
+    // values above m
+    u256 primes[2] = {
+        {0x43e1f593f0000001ULL, 0x2833e84879b97091ULL,
+         0xb85045b68181585dULL, 0x30644e72e131a029ULL},
+        {0x1fffffffffffffffULL, 0, 0, 0},
+    };
+    for (int k = 0; k < 2; k++) {
+        u64 *p = primes[k];
+        u256v_set(&x, 10, (u256){0, 0, 0, 0});
+        u256v_set(&x, 11, p);
+        u256v_mul_mod(&y, &x, &x, p);
+        bool ok = true;
+        for (int in_place = 0; in_place < 2; in_place++) {
+            u256v *r = in_place ? &y : &res;
+            u256v_inv_mod(r, &y, p);
+            for (size_t i = 0; i < n; i++) {
+                u256v_get(a, &x, i);
+                u256_mul_mod(b, a, a, p);
+                u256v_get(have, r, i);
+                u256_mul_mod(want, b, have, p);
+                u256 one = {1, 0, 0, 0};
+                ok = ok && (is_zero(b) ? is_zero(have) : eq(want, one));
+            }
+            u256v_mul_mod(&y, &x, &x, p);
+        }
+        verbose_assert_bool(ok, true, "Vector",
+                            "InvMod should invert, and map 0 to 0", true);
+    }
+    u256v_inv_mod(&res, &x, (u256){1, 0, 0, 0});
+    u256v_get(have, &res, 0);
+    verbose_assert_bool(is_zero(have), true, "Vector",
+                        "InvMod mod 1 should be 0", true);
+
+    // res may alias an operand
+    u256v_get(a, &x, 7);
+    u256_add(want, a, a);
+    u256v_add(&x, &x, &x);
+    u256v_get(have, &x, 7);
+    verbose_assert_eq(have, want, "Vector",
+                      "In place operations should work", true);
+    arena_reset();
+}
+
+/*
+    Big endian tests
+*/
+void write_be(uint8_t *word, u256 x) {
+    for (int i = 0; i < 4; i++) {
+        u64 limb = __builtin_bswap64(x[i]);
+        __builtin_memcpy(word+(24-(i*8)), &limb, 8);
+    }
+}
+
+void test_big_endian() {
+    uint8_t x[32], y[32];
+    u256 have;
+
+    u256 neg = {MAX_U64, MAX_U64, MAX_U64, MAX_U64};
+    u256 one = {1, 0, 0, 0};
+    write_be(x, neg);
+    write_be(y, one);
+    verbose_assert_bool(u256be_lt(x, y), false, "BigEndian",
+                        "-1 should not be less than 1 unsigned", true);
+    verbose_assert_bool(u256be_slt(x, y), true, "BigEndian",
+                        "-1 should be less than 1 signed", true);
+    verbose_assert_bool(u256be_sgt(y, x), true, "BigEndian",
+                        "1 should be greater than -1 signed", true);
+
+    // byte 0 is the most significant byte
+    u256 v = {0, 0, 0, 0xab00000000000000ULL};
+    u256 idx = {0, 0, 0, 0};
+    u256 want = {0xab, 0, 0, 0};
+    write_be(x, v);
+    write_be(y, idx);
+    u256be_byte(x, y);
+    read_be(have, x);
+    verbose_assert_eq(have, want, "BigEndian",
+                      "Byte 0 should be the most significant byte", true);
+
+    u256 big_idx = {0, 1, 0, 0};
+    write_be(x, v);
+    write_be(y, big_idx);
+    u256be_byte(x, y);
+    verbose_assert_bool(u256be_is_zero(x), true, "BigEndian",
+                        "Byte out of range should be zero", true);
+
+    // whole byte shifts
+    u256 sv = {0x1122334455667788ULL, 0, 0, 0x8000000000000000ULL};
+    u256 res, shift;
+    for (int n = 0; n <= 32; n++) {
+        u256 s = {n*8, 0, 0, 0};
+        copy_words(shift, s, 4);
+
+        write_be(x, sv);
+        u256be_shl_bytes(x, n);
+        read_be(have, x);
+        u256_shl(res, sv, shift);
+        verbose_assert_eq(have, res, "BigEndian",
+                          "Byte shl should match Shl", false);
+
+        write_be(x, sv);
+        u256be_shr_bytes(x, n);
+        read_be(have, x);
+        u256_shr(res, sv, shift);
+        verbose_assert_eq(have, res, "BigEndian",
+                          "Byte shr should match Shr", false);
+
+        write_be(x, sv);
+        u256be_sar_bytes(x, n);
+        read_be(have, x);
+        u256_sar(res, sv, shift);
+        verbose_assert_eq(have, res, "BigEndian",
+                          "Byte sar should match Sar", false);
+    }
+}
+
+/*
+    Bitfield tests
+*/
+#define TEST_LAYOUT(F, p)           \
+    F(p, amount, 0, 96)             \
+    F(p, flags, 96, 3)              \
+    F(p, owner, 99, 157)
+
+BITFIELD_LAYOUT(test_layout, TEST_LAYOUT)
+
+void test_bitfield() {
+    u256 x, v, have, want, mask, shift;
+    u256 one = {1, 0, 0, 0};
+
+    for (int t = 0; t < 200; t++) {
+        for (int j = 0; j < 4; j++) {
+            x[j] = xorshift();
+            v[j] = xorshift();
+        }
+        int off = xorshift() % 256;
+        int len = 1 + xorshift() % (256 - off);
+
+        // want = (x >> off) & (2^len - 1)
+        u256 l = {len, 0, 0, 0};
+        u256_shl(mask, one, l);
+        u256_sub(mask, mask, one);
+        u256 o = {off, 0, 0, 0};
+        copy_words(&shift[0], &o[0], 4);
+        u256_shr(want, x, shift);
+        u256_and(want, want, mask);
+        u256_extract_bits(have, x, off, len);
+        verbose_assert_eq(have, want, "Bitfield",
+                          "Extract should match shift and mask", false);
+
+        uint8_t word[32];
+        write_be(word, x);
+        u256be_extract_bits(have, word, off, len);
+        verbose_assert_eq(have, want, "Bitfield",
+                          "Big endian extract should match", false);
+
+        // want = (x & ~(mask << off)) | ((v & mask) << off)
+        u256 field, hole;
+        u256_and(field, v, mask);
+        u256_shl(field, field, shift);
+        u256_shl(hole, mask, shift);
+        u256_not(hole, hole);
+        u256_and(want, x, hole);
+        u256_or(want, want, field);
+        copy_words(&have[0], &x[0], 4);
+        u256_insert_bits(have, v, off, len);
+        verbose_assert_eq(have, want, "Bitfield",
+                          "Insert should match shift and mask", false);
+
+        u256be_insert_bits(word, v, off, len);
+        read_be(have, word);
+        verbose_assert_eq(have, want, "Bitfield",
+                          "Big endian insert should match", false);
+
+        if (len <= 64) {
+            u256_extract_bits(want, x, off, len);
+            verbose_assert_bool(u256_extract_u64(x, off, len) == want[0],
+                                true, "Bitfield",
+                                "u64 extract should match", false);
+        }
+    }
+
+    // generated accessors
+    u256 word = {0, 0, 0, 0};
+    u256 amount = {0x123456789abcdef0ULL, 0xfedcba98, 0, 0};
+    u256 flags = {5, 0, 0, 0};
+    u256 owner = {MAX_U64, MAX_U64, 0x1fffffffULL, 0};
+    test_layout_set_amount(word, amount);
+    test_layout_set_flags(word, flags);
+    test_layout_set_owner(word, owner);
+    test_layout_get_amount(have, word);
+    verbose_assert_eq(have, amount, "Bitfield", "Amount should round trip", true);
+    test_layout_get_flags(have, word);
+    verbose_assert_eq(have, flags, "Bitfield", "Flags should round trip", true);
+    test_layout_get_owner(have, word);
+    verbose_assert_eq(have, owner, "Bitfield", "Owner should round trip", true);
+
+    uint8_t be[32];
+    write_be(be, word);
+    u256 zero = {0, 0, 0, 0};
+    test_layout_be_set_flags(be, zero);
+    test_layout_be_get_flags(have, be);
+    verbose_assert_eq(have, zero, "Bitfield",
+                      "Big endian set should clear the field", true);
+    test_layout_be_get_amount(have, be);
+    verbose_assert_eq(have, amount, "Bitfield",
+                      "Big endian set should leave other fields", true);
+}
+
+/*
+    Bitmap tests
+*/
+static bitmap test_bits;
+
+void test_bitmap() {
+    u256 x = {0, 0, 0, 0};
+    u256_flip_bit(x, 3);
+    u256_flip_bit(x, 200);
+    verbose_assert_bool(u256_next_set_bit_le(x, 255) == 200, true, "Bitmap",
+                        "Le should find the highest bit", true);
+    verbose_assert_bool(u256_next_set_bit_le(x, 199) == 3, true, "Bitmap",
+                        "Le should skip bits above pos", true);
+    verbose_assert_bool(u256_next_set_bit_le(x, 2) == -1, true, "Bitmap",
+                        "Le should fail below the lowest bit", true);
+    verbose_assert_bool(u256_next_set_bit_ge(x, 3) == 3, true, "Bitmap",
+                        "Ge should include pos", true);
+    verbose_assert_bool(u256_next_set_bit_ge(x, 4) == 200, true, "Bitmap",
+                        "Ge should skip bits below pos", true);
+    verbose_assert_bool(u256_next_set_bit_ge(x, 201) == -1, true, "Bitmap",
+                        "Ge should fail above the highest bit", true);
+
+    // in memory, against a linear scan
+    bitmap_init(&test_bits);
+    static bool set[BITMAP_BITS];
+    for (int i = 0; i < 200; i++) {
+        int index = xorshift() % BITMAP_BITS;
+        bitmap_flip(&test_bits, index);
+        set[index] = !set[index];
+    }
+    bool ok = true;
+    for (int i = 0; i < 1000; i++) {
+        int index = xorshift() % BITMAP_BITS;
+        int le = index, ge = index;
+        while (le >= 0 && !set[le]) le--;
+        while (ge < BITMAP_BITS && !set[ge]) ge++;
+        if (ge == BITMAP_BITS) ge = -1;
+        ok = ok && bitmap_next_le(&test_bits, index) == le
+                && bitmap_next_ge(&test_bits, index) == ge
+                && bitmap_get(&test_bits, index) == set[index];
+    }
+    verbose_assert_bool(ok, true, "Bitmap",
+                        "Searches should match a linear scan", true);
+
+    // in storage, reading only the summary and the words it needs
+    uint8_t base[32] = {0};
+    base[0] = 0xbb;
+    base[31] = 0xff;
+    slot_reset();
+    sbitmap_flip(base, 10);
+    sbitmap_flip(base, 40000);
+    sbitmap_flip(base, 40001);
+    sbitmap_flip(base, 40001);
+    slot_flush();
+    verbose_assert_bool(sbitmap_get(base, 40000) && !sbitmap_get(base, 40001),
+                        true, "Bitmap", "Flip should set and clear bits",
+                        true);
+
+    slot_reset();
+    storage_loads = 0;
+    verbose_assert_bool(sbitmap_next_le(base, 39935) == 10, true, "Bitmap",
+                        "Storage le should skip empty words", true);
+    verbose_assert_bool(storage_loads == 2, true, "Bitmap",
+                        "Storage le should load the summary and one word",
+                        true);
+    slot_reset();
+    storage_loads = 0;
+    verbose_assert_bool(sbitmap_next_ge(base, 11) == 40000, true, "Bitmap",
+                        "Storage ge should skip empty words", true);
+    verbose_assert_bool(storage_loads == 3, true, "Bitmap",
+                        "Storage ge should load the summary and two words",
+                        true);
+    verbose_assert_bool(sbitmap_next_ge(base, 40001) == -1, true, "Bitmap",
+                        "Storage ge should fail past the last bit", true);
+}
+
+/*
+    Field tests
+*/
+typedef struct field_ops {
+    char *name;
+    const u64 *p;
+    void (*from)(u256 r, const u256 a);
+    void (*to)(u256 r, const u256 a);
+    void (*add)(u256 r, const u256 a, const u256 b);
+    void (*sub)(u256 r, const u256 a, const u256 b);
+    void (*mul)(u256 r, const u256 a, const u256 b);
+    void (*inv)(u256 r, const u256 a);
+    void (*inv_batch)(u256 *r, const u256 *a, size_t n, u256 *prefix);
+    int (*legendre)(const u256 a);
+    void (*sqrt)(u256 r, const u256 a);
+} field_ops;
+
+#define FIELD_OPS(name) {#name, name##_P, name##_from, name##_to, name##_add, \
+                         name##_sub, name##_mul, name##_inv,                 \
+                         name##_inv_batch, name##_legendre, NULL}
+#define FIELD_OPS_SQRT(name) {#name, name##_P, name##_from, name##_to,       \
+                              name##_add, name##_sub, name##_mul, name##_inv, \
+                              name##_inv_batch, name##_legendre, name##_sqrt}
+
+static const field_ops test_fields[] = {
+    FIELD_OPS_SQRT(secp256k1_fp), FIELD_OPS(secp256k1_fn),
+    FIELD_OPS_SQRT(bn254_fp), FIELD_OPS(bn254_fr), FIELD_OPS(f25519),
+    FIELD_OPS_SQRT(p256_fp), FIELD_OPS(p256_fn),
+};
+
+void test_field() {
+    for (size_t f = 0; f < sizeof(test_fields)/sizeof(field_ops); f++) {
+        const field_ops *F = &test_fields[f];
+        u256 p, x, y, a, b, fa, fb, have, want;
+        copy_words(p, (u64 *)F->p, 4);
+
+        bool ok = true;
+        for (int i = 0; i < 1000; i++) {
+            for (int j = 0; j < 4; j++) {
+                x[j] = xorshift();
+                y[j] = xorshift();
+            }
+            // near p, near zero and random values
+            if (i % 4 == 0) {
+                u256 k = {i + 1, 0, 0, 0};
+                u256_sub(x, p, k);
+            }
+            if (i % 4 == 1) {
+                y[1] = y[2] = y[3] = 0;
+            }
+            u256_mod(a, x, p);
+            u256_mod(b, y, p);
+            F->from(fa, a);
+            F->from(fb, b);
+
+            F->mul(have, fa, fb);
+            F->to(have, have);
+            u256_mul_mod(want, a, b, p);
+            ok = ok && eq(have, want);
+
+            F->add(have, fa, fb);
+            F->to(have, have);
+            u256_add_mod(want, a, b, p);
+            ok = ok && eq(have, want);
+
+            F->sub(have, fa, fb);
+            F->to(have, have);
+            u256 nb;
+            u256_sub(nb, p, b);
+            u256_add_mod(want, a, nb, p);
+            ok = ok && eq(have, want);
+        }
+        verbose_assert_bool(ok, true, F->name,
+                            "Field operations should match mulmod and addmod",
+                            true);
+
+        // a * a^-1 = 1
+        u256 one = {1, 0, 0, 0};
+        a[0] = 12345; a[1] = 0; a[2] = 0; a[3] = 1;
+        F->from(fa, a);
+        F->inv(have, fa);
+        F->mul(have, have, fa);
+        F->to(have, have);
+        verbose_assert_eq(have, one, F->name,
+                          "An element times its inverse should be one", true);
+        F->inv(have, (u256){0, 0, 0, 0});
+        verbose_assert_bool(is_zero(have), true, F->name,
+                            "The inverse of zero should be zero", true);
+
+        // batch inverses, in place and with a zero among them
+        u256 elems[8], batch[8], prefix[8];
+        for (int i = 0; i < 8; i++) {
+            a[0] = xorshift(); a[1] = xorshift(); a[2] = 0; a[3] = i;
+            F->from(elems[i], a);
+        }
+        clear_words(elems[5], 4);
+        copy_words((u64 *)batch, (u64 *)elems, 4 * 8);
+        F->inv_batch(batch, batch, 8, prefix);
+        ok = true;
+        for (int i = 0; i < 8; i++) {
+            F->inv(have, elems[i]);
+            ok = ok && eq(have, batch[i]);
+        }
+        verbose_assert_bool(ok, true, F->name,
+                            "Batch inverses should match inv", true);
+
+        // squares, and -1 times a square: -1 is a square for p = 1 mod 4,
+        // and not for p = 3 mod 4, the fields with a square root
+        ok = F->legendre((u256){0, 0, 0, 0}) == 0;
+        int non_squares = 0;
+        for (int i = 0; i < 20; i++) {
+            u256 sq, neg, zero = {0, 0, 0, 0};
+            a[0] = xorshift(); a[1] = xorshift(); a[2] = 0; a[3] = i;
+            F->from(fa, a);
+            F->mul(sq, fa, fa);
+            F->sub(neg, zero, sq);
+            ok = ok && F->legendre(sq) == 1;
+            non_squares += F->legendre(neg) == -1;
+            if (F->sqrt) {
+                F->sqrt(have, sq);
+                F->mul(have, have, have);
+                ok = ok && eq(have, sq);
+            }
+        }
+        ok = ok && non_squares == (F->sqrt ? 20 : 0);
+        verbose_assert_bool(ok, true, F->name,
+                            "Legendre symbols and square roots", true);
+    }
+
+    // r2 = 2^512 mod p for the Montgomery fields
+    const u64 *r2s[] = {secp256k1_fn_R2, bn254_fp_R2, bn254_fr_R2,
+                        p256_fn_R2};
+    const u64 *ps[] = {secp256k1_fn_P, bn254_fp_P, bn254_fr_P, p256_fn_P};
+    for (int f = 0; f < 4; f++) {
+        u256 p, x, r, have;
+        copy_words(p, (u64 *)ps[f], 4);
+        u256 zero = {0, 0, 0, 0};
+        u256_sub(x, zero, p);
+        u256_mod(r, x, p);
+        u256_mul_mod(have, r, r, p);
+        verbose_assert_bool(eq(have, (u64 *)r2s[f]), true, "Field",
+                            "R2 should be 2^512 mod p", true);
+    }
+}
+
+/*
+    secp256k1 tests
+*/
+// keccak256 for native_keccak256, from the Keccak reference
+static const u64 keccak_rc[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+static const int keccak_rot[25] = {
+    0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43,
+    25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14,
+};
+
+static u64 rotl64(u64 x, int n) {
+    return n == 0 ? x : (x << n) | (x >> (64 - n));
+}
+
+// a[x + 5y]
+static void keccak_f(u64 a[25]) {
+    for (int round = 0; round < 24; round++) {
+        u64 c[5], b[25];
+        for (int x = 0; x < 5; x++) {
+            c[x] = a[x] ^ a[x+5] ^ a[x+10] ^ a[x+15] ^ a[x+20];
+        }
+        for (int x = 0; x < 5; x++) {
+            u64 d = c[(x+4) % 5] ^ rotl64(c[(x+1) % 5], 1);
+            for (int y = 0; y < 5; y++) {
+                a[x + 5*y] ^= d;
+            }
+        }
+        for (int x = 0; x < 5; x++) {
+            for (int y = 0; y < 5; y++) {
+                b[y + 5*((2*x + 3*y) % 5)] = rotl64(a[x + 5*y], keccak_rot[x + 5*y]);
+            }
+        }
+        for (int x = 0; x < 5; x++) {
+            for (int y = 0; y < 5; y++) {
+                a[x + 5*y] = b[x + 5*y] ^ (~b[(x+1) % 5 + 5*y] & b[(x+2) % 5 + 5*y]);
+            }
+        }
+        a[0] ^= keccak_rc[round];
+    }
+}
+
+void native_keccak256(const uint8_t *bytes, size_t len, uint8_t *output) {
+    u64 a[25] = {0};
+    uint8_t block[136];
+    for (;;) {
+        size_t n = len < 136 ? len : 136;
+        __builtin_memset(block, 0, 136);
+        if (n > 0) {
+            __builtin_memcpy(block, bytes, n);
+        }
+        if (n < 136) {
+            block[n] ^= 0x01;
+            block[135] ^= 0x80;
+        }
+        for (int i = 0; i < 17; i++) {
+            u64 lane;
+            __builtin_memcpy(&lane, block + 8*i, 8);
+            a[i] ^= lane;
+        }
+        keccak_f(a);
+        if (n < 136) {
+            break;
+        }
+        bytes += 136;
+        len -= 136;
+    }
+    __builtin_memcpy(output, a, 32);
+}
+
+static void k1_random_scalar(u256 k) {
+    for (int i = 0; i < 4; i++) {
+        k[i] = xorshift();
+    }
+    u256 t;
+    u256_mod(t, k, (u64 *)secp256k1_fn_P);
+    copy_words(k, t, 4);
+}
+
+static bool k1_same_point(const secp256k1_jacobian *a,
+                          const secp256k1_jacobian *b) {
+    secp256k1_affine x, y;
+    secp256k1_to_affine(&x, a);
+    secp256k1_to_affine(&y, b);
+    return x.infinity == y.infinity && eq(x.x, y.x) && eq(x.y, y.y);
+}
+
+// the Ethereum address of a public key, left padded to a word
+static void k1_address(u256 res, const secp256k1_affine *q) {
+    uint8_t buf[64];
+    write_be(buf, (u64 *)q->x);
+    write_be(buf + 32, (u64 *)q->y);
+    native_keccak256(buf, 64, buf);
+    __builtin_memset(buf, 0, 12);
+    read_be(res, buf);
+}
+
+// sign hash with key d and nonce k
+static void k1_sign(secp256k1_signature *sig, const u256 hash, const u256 d,
+                    const u256 k) {
+    u256 n, t, z;
+    copy_words(n, (u64 *)secp256k1_fn_P, 4);
+    secp256k1_jacobian R, Q;
+    secp256k1_affine Ra;
+    secp256k1_mul_gen(&R, k);
+    secp256k1_to_affine(&Ra, &R);
+    u256_mod(sig->r, Ra.x, n);
+    sig->v = Ra.y[0] & 1;
+
+    // s = (z + r d) / k
+    u256_mod(z, (u64 *)hash, n);
+    u256_mul_mod(t, sig->r, (u64 *)d, n);
+    u256_add_mod(t, t, z, n);
+    secp256k1_fn_from(z, k);
+    secp256k1_fn_inv(z, z);
+    secp256k1_fn_to(z, z);
+    u256_mul_mod(sig->s, t, z, n);
+    copy_words(sig->hash, (u64 *)hash, 4);
+
+    secp256k1_mul_gen(&Q, d);
+    secp256k1_to_affine(&sig->pubkey, &Q);
+}
+
+void test_secp256k1() {
+    uint8_t digest[32];
+    u256 have, want;
+    native_keccak256(NULL, 0, digest);
+    read_be(have, digest);
+    u256 empty = {0x7bfad8045d85a470ULL, 0xe500b653ca82273bULL,
+                  0x927e7db2dcc703c0ULL, 0xc5d2460186f7233cULL};
+    verbose_assert_eq(have, empty, "keccak256", "keccak256 of nothing", true);
+
+    // 1 G and 2 G
+    u256 one = {1, 0, 0, 0}, two = {2, 0, 0, 0};
+    secp256k1_jacobian P, Q;
+    secp256k1_affine A;
+    secp256k1_mul_gen(&P, one);
+    secp256k1_to_affine(&A, &P);
+    verbose_assert_bool(eq(A.x, (u64 *)secp256k1_g_odd[0].x)
+                        && eq(A.y, (u64 *)secp256k1_g_odd[0].y), true,
+                        "secp256k1", "1 G should be G", true);
+    secp256k1_mul_gen(&P, two);
+    secp256k1_to_affine(&A, &P);
+    u256 g2x = {0xabac09b95c709ee5ULL, 0x5c778e4b8cef3ca7ULL,
+                0x3045406e95c07cd8ULL, 0xc6047f9441ed7d6dULL};
+    verbose_assert_eq(A.x, g2x, "secp256k1", "2 G", true);
+    verbose_assert_bool(secp256k1_on_curve(&A), true, "secp256k1",
+                        "2 G should be on the curve", true);
+
+    // the address of key 1
+    k1_address(have, &secp256k1_g_odd[0]);
+    u256 addr1 = {0xb8c2659029395bdfULL, 0x091a69125d5dfcb7ULL,
+                  0x000000007e5f4552ULL, 0};
+    verbose_assert_eq(have, addr1, "secp256k1", "Address of key 1", true);
+
+    // the comb, Strauss and the split agree
+    bool ok = true;
+    bool split_ok = true;
+    for (int i = 0; i < 200; i++) {
+        u256 k, k1, k2, t;
+        bool neg1, neg2;
+        k1_random_scalar(k);
+        secp256k1_mul_gen(&P, k);
+        secp256k1_msm(&Q, k, NULL, NULL, 0);
+        ok = ok && k1_same_point(&P, &Q);
+        secp256k1_msm(&Q, NULL, &secp256k1_g_odd[0], (const u256 *)&k, 1);
+        ok = ok && k1_same_point(&P, &Q);
+
+        secp256k1_split_lambda(k1, &neg1, k2, &neg2, k);
+        split_ok = split_ok && k1[2] == 0 && k1[3] == 0 && k2[2] == 0
+                   && k2[3] == 0;
+        if (neg1) {
+            secp256k1_fn_neg(k1, k1);
+        }
+        if (neg2) {
+            secp256k1_fn_neg(k2, k2);
+        }
+        u256 lambda = {0xdf02967c1b23bd72ULL, 0x122e22ea20816678ULL,
+                       0xa5261c028812645aULL, 0x5363ad4cc05c30e0ULL};
+        u256_mul_mod(t, k2, lambda, (u64 *)secp256k1_fn_P);
+        u256_add_mod(t, t, k1, (u64 *)secp256k1_fn_P);
+        split_ok = split_ok && eq(t, k);
+    }
+    verbose_assert_bool(ok, true, "secp256k1",
+                        "Comb and Strauss multiplication should agree", true);
+    verbose_assert_bool(split_ok, true, "secp256k1",
+                        "k = k1 + k2 lambda, with 128 bit halves", true);
+
+    // a + b = c for a sum of several points
+    secp256k1_affine pts[3];
+    u256 ks[3], g, sum = {0, 0, 0, 0};
+    k1_random_scalar(g);
+    u256_add_mod(sum, sum, g, (u64 *)secp256k1_fn_P);
+    for (int i = 0; i < 3; i++) {
+        u256 d;
+        k1_random_scalar(d);
+        k1_random_scalar(ks[i]);
+        secp256k1_mul_gen(&P, d);
+        secp256k1_to_affine(&pts[i], &P);
+        u256_mul_mod(d, d, ks[i], (u64 *)secp256k1_fn_P);
+        u256_add_mod(sum, sum, d, (u64 *)secp256k1_fn_P);
+    }
+    secp256k1_msm(&P, g, pts, (const u256 *)ks, 3);
+    secp256k1_mul_gen(&Q, sum);
+    verbose_assert_bool(k1_same_point(&P, &Q), true, "secp256k1",
+                        "Multi-scalar multiplication", true);
+
+    // the ecrecover vector from go-ethereum's precompile tests
+    u256 hash = {0x5423adf9ed98873eULL, 0x7054f66a817bd429ULL,
+                 0xb9942764b62f18e1ULL, 0x38d18acb67d25c8bULL};
+    u256 s = {0x8efb6dcff8a4ae02ULL, 0x1bb14d086eba8e8eULL,
+              0x72d2748d60f7e4b8ULL, 0x789d1dd423d25f07ULL};
+    bool recovered = secp256k1_recover(&A, hash, 0, hash, s);
+    k1_address(have, &A);
+    verbose_assert_bool(recovered, true, "secp256k1", "ecrecover", true);
+    want[0] = 0xd36ba501f28b699dULL;
+    want[1] = 0x40adf55b2028469bULL;
+    want[2] = 0x00000000ceaccac6ULL;
+    want[3] = 0;
+    verbose_assert_eq(have, want, "secp256k1", "ecrecover address", true);
+    verbose_assert_bool(secp256k1_recover(&A, hash, 0, hash,
+                                          (u64 *)secp256k1_fn_P),
+                        false, "secp256k1", "s = n should be rejected", true);
+
+    // signatures made here round trip
+    #define K1_SIGS 64
+    static secp256k1_signature sigs[K1_SIGS];
+    ok = true;
+    for (int i = 0; i < K1_SIGS; i++) {
+        u256 h, d, k;
+        k1_random_scalar(h);
+        k1_random_scalar(d);
+        k1_random_scalar(k);
+        h[3] = xorshift(); // any hash, even above n
+        k1_sign(&sigs[i], h, d, k);
+        ok = ok && secp256k1_verify(h, sigs[i].r, sigs[i].s, &sigs[i].pubkey);
+        ok = ok && secp256k1_recover(&A, h, sigs[i].v, sigs[i].r, sigs[i].s)
+             && eq(A.x, sigs[i].pubkey.x) && eq(A.y, sigs[i].pubkey.y);
+        h[0] ^= 1;
+        ok = ok && !secp256k1_verify(h, sigs[i].r, sigs[i].s,
+                                     &sigs[i].pubkey);
+    }
+    verbose_assert_bool(ok, true, "secp256k1",
+                        "Sign, verify and recover should round trip", true);
+
+    verbose_assert_bool(secp256k1_verify_batch(sigs, K1_SIGS), true,
+                        "secp256k1", "Batch of valid signatures", true);
+    sigs[K1_SIGS/2].s[0] ^= 1;
+    verbose_assert_bool(secp256k1_verify_batch(sigs, K1_SIGS), false,
+                        "secp256k1", "Batch with a bad s", true);
+    sigs[K1_SIGS/2].s[0] ^= 1;
+    sigs[K1_SIGS-1].v ^= 1;
+    verbose_assert_bool(secp256k1_verify_batch(sigs, K1_SIGS), false,
+                        "secp256k1", "Batch with a bad v", true);
+    sigs[K1_SIGS-1].v ^= 1;
+    verbose_assert_bool(secp256k1_verify_batch(sigs, 1), true,
+                        "secp256k1", "Batch of one", true);
+
+    // a batch whose points, seeds and tables take more than a megabyte
+    size_t many = 1000;
+    arena_reset();
+    secp256k1_signature *big = arena_alloc(many * sizeof(secp256k1_signature));
+    for (size_t i = 0; i < many; i++) {
+        u256 h, d, k;
+        k1_random_scalar(h);
+        k1_random_scalar(d);
+        k1_random_scalar(k);
+        k1_sign(&big[i], h, d, k);
+    }
+    verbose_assert_bool(secp256k1_verify_batch(big, many), true,
+                        "secp256k1", "Batch of 1000 valid signatures", true);
+    big[many-1].s[0] ^= 1;
+    verbose_assert_bool(secp256k1_verify_batch(big, many), false,
+                        "secp256k1", "Batch of 1000 with a bad s", true);
+    arena_reset();
+}
+
+/*
+    P-256 tests
+*/
+void test_p256() {
+    // the first vector of the RIP-7212 reference tests
+    u256 hash = {0x785011fe190f0b4dULL, 0x6b9c72bd725d39d4ULL,
+                 0x036147a12d49004bULL, 0x4cee90eb86eaa050ULL};
+    u256 r = {0x68e8fb19086e8cacULL, 0x31ff4bcf5993d584ULL,
+              0x39bbbf6e8e80d169ULL, 0xa73bd4903f0ce3b6ULL};
+    u256 s = {0x0d312af6c66b1d60ULL, 0xc0450c9aa81be5d1ULL,
+              0x9286b162af3bd7fcULL, 0x36dbcd03009df8c5ULL};
+    p256_affine q = {{0x4a3bb6060e44eff3ULL, 0x9ab5eadf74b75420ULL,
+                      0xfcfe16ae7770b0c4ULL, 0x4aebd3099c618202ULL},
+                     {0x2ddf79ae00b4e10eULL, 0x26d0f7c00181a5fbULL,
+                      0xca6ca971a7a1adc8ULL, 0x7618b065f9832de4ULL}, false};
+    verbose_assert_bool(p256_verify(hash, r, s, &q), true, "P256",
+                        "RIP-7212 vector", true);
+    hash[0] ^= 1;
+    verbose_assert_bool(p256_verify(hash, r, s, &q), false, "P256",
+                        "Wrong hash should fail", true);
+    hash[0] ^= 1;
+    q.y[0] ^= 1;
+    verbose_assert_bool(p256_verify(hash, r, s, &q), false, "P256",
+                        "Points off the curve should fail", true);
+    q.y[0] ^= 1;
+    verbose_assert_bool(p256_verify(hash, r, (u64 *)p256_fn_P, &q), false,
+                        "P256", "s = n should fail", true);
+
+    // signatures made here verify
+    u256 n;
+    copy_words(n, (u64 *)p256_fn_P, 4);
+    bool ok = true;
+    for (int i = 0; i < 32; i++) {
+        u256 d, k, z, t, zero = {0, 0, 0, 0};
+        for (int j = 0; j < 4; j++) {
+            d[j] = xorshift();
+            k[j] = xorshift();
+            hash[j] = xorshift();
+        }
+        u256_mod(t, d, n);
+        copy_words(d, t, 4);
+        u256_mod(t, k, n);
+        copy_words(k, t, 4);
+
+        p256_jacobian R, Q;
+        p256_affine Ra, none = {{0}, {0}, true};
+        p256_mul2(&R, k, &none, zero);
+        p256_to_affine(&Ra, &R);
+        p256_mul2(&Q, d, &none, zero);
+        p256_to_affine(&q, &Q);
+        ok = ok && p256_on_curve(&q);
+
+        // s = (z + r d) / k
+        u256_mod(r, Ra.x, n);
+        u256_mod(z, hash, n);
+        u256_mul_mod(t, r, d, n);
+        u256_add_mod(t, t, z, n);
+        p256_fn_from(z, k);
+        p256_fn_inv(z, z);
+        p256_fn_to(z, z);
+        u256_mul_mod(s, t, z, n);
+        ok = ok && p256_verify(hash, r, s, &q);
+        s[1] ^= 1;
+        ok = ok && !p256_verify(hash, r, s, &q);
+    }
+    verbose_assert_bool(ok, true, "P256", "Sign and verify should round trip",
+                        true);
+}
+
+/*
+    BN254 tests
+*/
+static void bn254_word(uint8_t *out, u64 v) {
+    u256 x = {v, 0, 0, 0};
+    write_be(out, x);
+}
+
+void test_bn254() {
+    uint8_t in[128], out[64], want[64];
+    u256 x, y;
+
+    // G + G and 2 G
+    u256 g2x = {0xd3c208c16d87cfd3ULL, 0xd97816a916871ca8ULL,
+                0x9b85045b68181585ULL, 0x030644e72e131a02ULL};
+    u256 g2y = {0xff3ebf7a5a18a2c4ULL, 0x68a6a449e3538fc7ULL,
+                0xe7845f96b2ae9c0aULL, 0x15ed738c0e0a7c92ULL};
+    write_be(want, g2x);
+    write_be(want + 32, g2y);
+    bn254_word(in, 1);
+    bn254_word(in + 32, 2);
+    bn254_word(in + 64, 1);
+    bn254_word(in + 96, 2);
+    bool ok = bn254_ec_add(out, in, 128);
+    verbose_assert_bool(ok && __builtin_memcmp(out, want, 64) == 0, true, "BN254",
+                        "G + G", true);
+    bn254_word(in + 64, 2);
+    ok = bn254_ec_mul(out, in, 96);
+    verbose_assert_bool(ok && __builtin_memcmp(out, want, 64) == 0, true, "BN254",
+                        "2 G", true);
+
+    // a scalar above r
+    u256 k = {0xef369f20db1f0ad3ULL, 0x2833e84879b97091ULL,
+              0xb85045b68181585dULL, 0x30644e72e131a029ULL};
+    write_be(in + 64, k);
+    u256 kx = {0x83a5a278b3d1b675ULL, 0xff2267495f19207dULL,
+               0xd6c8d3bc8ebce97aULL, 0x14e2946f9ea29efcULL};
+    u256 ky = {0xc449eea611b9ed31ULL, 0xdfa16ef85493ca2cULL,
+               0x02b7c664972665bbULL, 0x0d6d60e75a6a4aefULL};
+    write_be(want, kx);
+    write_be(want + 32, ky);
+    ok = bn254_ec_mul(out, in, 96);
+    verbose_assert_bool(ok && __builtin_memcmp(out, want, 64) == 0, true, "BN254",
+                        "k G", true);
+
+    // r G, G - G and G + 0 with the short input padded
+    write_be(in + 64, (u64 *)bn254_fr_P);
+    ok = bn254_ec_mul(out, in, 96);
+    __builtin_memset(want, 0, 64);
+    verbose_assert_bool(ok && __builtin_memcmp(out, want, 64) == 0, true, "BN254",
+                        "r G should be infinity", true);
+    bn254_word(in + 64, 1);
+    u256 two = {2, 0, 0, 0};
+    u256_sub(y, (u64 *)bn254_fp_P, two);
+    write_be(in + 96, y);
+    ok = bn254_ec_add(out, in, 128);
+    verbose_assert_bool(ok && __builtin_memcmp(out, want, 64) == 0, true, "BN254",
+                        "G - G should be infinity", true);
+    ok = bn254_ec_add(out, in, 64);
+    verbose_assert_bool(ok && __builtin_memcmp(out, in, 64) == 0, true, "BN254",
+                        "Short input should be padded with zeros", true);
+
+    // invalid points
+    bn254_word(in + 32, 3);
+    verbose_assert_bool(bn254_ec_add(out, in, 128), false, "BN254",
+                        "Points off the curve should fail", true);
+    write_be(in, (u64 *)bn254_fp_P);
+    bn254_word(in + 32, 0);
+    verbose_assert_bool(bn254_ec_mul(out, in, 96), false, "BN254",
+                        "Coordinates above p should fail", true);
+
+    // a G + b G = (a + b) G
+    bn254_g1 g, a, b, c;
+    bn254_word(in, 1);
+    bn254_word(in + 32, 2);
+    bn254_g1_from_bytes(&g, in);
+    ok = true;
+    for (int i = 0; i < 50; i++) {
+        u256 ka, kb, kc;
+        for (int j = 0; j < 4; j++) {
+            ka[j] = xorshift();
+            kb[j] = xorshift();
+        }
+        bn254_g1_mul(&a, &g, ka);
+        bn254_g1_mul(&b, &g, kb);
+        bn254_g1_add(&a, &a, &b);
+        u256_mod(x, ka, (u64 *)bn254_fr_P);
+        u256_mod(y, kb, (u64 *)bn254_fr_P);
+        u256_add_mod(kc, x, y, (u64 *)bn254_fr_P);
+        bn254_g1_mul(&c, &g, kc);
+        ok = ok && bn254_g1_valid(&a) && a.infinity == c.infinity
+             && eq(a.x, c.x) && eq(a.y, c.y);
+
+        // and the same in Jacobian coordinates
+        bn254_g1j ja, jb;
+        bn254_g1_mul(&a, &g, ka);
+        bn254_g1j_from(&ja, &a);
+        bn254_g1j_from(&jb, &b);
+        bn254_g1j_add(&ja, &ja, &jb);
+        bn254_g1j_to(&a, &ja);
+        ok = ok && eq(a.x, c.x) && eq(a.y, c.y);
+    }
+    verbose_assert_bool(ok, true, "BN254", "a G + b G = (a + b) G", true);
+}
+
+// the G2 generator, x_im, x_re, y_im, y_re
+static void bn254_g2_gen(uint8_t *out) {
+    u256 x_im = {0x97e485b7aef312c2ULL, 0xf1aa493335a9e712ULL,
+                 0x7260bfb731fb5d25ULL, 0x198e9393920d483aULL};
+    u256 x_re = {0x46debd5cd992f6edULL, 0x674322d4f75edaddULL,
+                 0x426a00665e5c4479ULL, 0x1800deef121f1e76ULL};
+    u256 y_im = {0x55acdadcd122975bULL, 0xbc4b313370b38ef3ULL,
+                 0xec9e99ad690c3395ULL, 0x090689d0585ff075ULL};
+    u256 y_re = {0x4ce6cc0166fa7daaULL, 0xe3d1e7690c43d37bULL,
+                 0x4aab71808dcb408fULL, 0x12c85ea5db8c6debULL};
+    write_be(out, x_im);
+    write_be(out + 32, x_re);
+    write_be(out + 64, y_im);
+    write_be(out + 96, y_re);
+}
+
+void test_bn254_pairing() {
+    uint8_t in[4*192], out[32];
+    bn254_g1 g1, p[2];
+    bn254_g2 g2, q[2];
+    bn254_fp12 e, f;
+
+    bn254_word(in, 1);
+    bn254_word(in + 32, 2);
+    bn254_g1_from_bytes(&g1, in);
+    bn254_g2_gen(in + 64);
+    verbose_assert_bool(bn254_g2_from_bytes(&g2, in + 64), true, "BN254",
+                        "The G2 generator should be valid", true);
+    bn254_pairing(&e, &g1, &g2);
+    verbose_assert_bool(bn254_fp12_is_one(&e), false, "BN254",
+                        "e(G1, G2) should not be 1", true);
+
+    // e has order r
+    bn254_fp12 acc;
+    bn254_fp12_one(&acc);
+    for (int i = 253; i >= 0; i--) {
+        bn254_fp12_mul(&acc, &acc, &acc);
+        if ((bn254_fr_P[i/64] >> (i%64)) & 1) {
+            bn254_fp12_mul(&acc, &acc, &e);
+        }
+    }
+    verbose_assert_bool(bn254_fp12_is_one(&acc), true, "BN254",
+                        "e(G1, G2)^r should be 1", true);
+
+    // e(a G1, b G2) = e(ab G1, G2) = e(G1, ab G2)
+    bool ok = true;
+    for (int i = 0; i < 3; i++) {
+        u256 ka, kb, kab;
+        for (int j = 0; j < 4; j++) {
+            ka[j] = xorshift();
+            kb[j] = xorshift();
+        }
+        u256_mul_mod(kab, ka, kb, (u64 *)bn254_fr_P);
+        bn254_g1_mul(&p[0], &g1, ka);
+        bn254_g2_mul(&q[0], &g2, kb);
+        bn254_pairing(&e, &p[0], &q[0]);
+        bn254_g1_mul(&p[1], &g1, kab);
+        bn254_pairing(&f, &p[1], &g2);
+        ok = ok && bn254_fp12_eq(&e, &f);
+        bn254_g2_mul(&q[1], &g2, kab);
+        bn254_pairing(&f, &g1, &q[1]);
+        ok = ok && bn254_fp12_eq(&e, &f) && bn254_g2_valid(&q[0]);
+
+        // e(a G1, b G2) e(-ab G1, G2) = 1
+        bn254_fp_neg(p[1].y, p[1].y);
+        q[1] = g2;
+        ok = ok && bn254_pairing_check(p, q, 2);
+    }
+    verbose_assert_bool(ok, true, "BN254", "The pairing should be bilinear",
+                        true);
+
+    // the precompile: e(G1, G2) e(-G1, G2) = 1, but not e(G1, G2)^2
+    __builtin_memcpy(in + 192, in, 192);
+    ok = bn254_ec_pairing(out, in, 192);
+    verbose_assert_bool(ok && out[31] == 0, true, "BN254",
+                        "A single pair of generators should give 0", true);
+    ok = bn254_ec_pairing(out, in, 384);
+    verbose_assert_bool(ok && out[31] == 0, true, "BN254",
+                        "e(G1, G2)^2 should give 0", true);
+    u256 y;
+    u256 two = {2, 0, 0, 0};
+    u256_sub(y, (u64 *)bn254_fp_P, two);
+    write_be(in + 192 + 32, y);
+    ok = bn254_ec_pairing(out, in, 384);
+    verbose_assert_bool(ok && out[31] == 1, true, "BN254",
+                        "e(G1, G2) e(-G1, G2) should give 1", true);
+
+    // pairs with infinity count as 1, and no pairs give 1
+    __builtin_memset(in + 384, 0, 192);
+    ok = bn254_ec_pairing(out, in, 576);
+    verbose_assert_bool(ok && out[31] == 1, true, "BN254",
+                        "Pairs with infinity should be skipped", true);
+    __builtin_memset(in + 576, 0, 64);
+    __builtin_memcpy(in + 576 + 64, in + 64, 128);
+    ok = bn254_ec_pairing(out, in, 768);
+    verbose_assert_bool(ok && out[31] == 1, true, "BN254",
+                        "Pairs with G1 infinity should be skipped", true);
+    ok = bn254_ec_pairing(out, in, 0);
+    verbose_assert_bool(ok && out[31] == 1, true, "BN254",
+                        "Empty input should give 1", true);
+
+    // failures
+    verbose_assert_bool(bn254_ec_pairing(out, in, 191), false, "BN254",
+                        "Input should be whole pairs", true);
+    // (1, y) is on the twist, but not in G2
+    u256 y_im = {0x1b7f8da82de048a4ULL, 0x998c7f790cb4d751ULL,
+                 0x36846e70a1934187ULL, 0x0d1271953ed9ea08ULL};
+    u256 y_re = {0xab4b871c0531f1bbULL, 0xaadd70e52c9830e9ULL,
+                 0xf8e2728fdb825a51ULL, 0x2869111d5381f072ULL};
+    __builtin_memset(in + 64, 0, 64);
+    in[64 + 63] = 1;
+    write_be(in + 128, y_im);
+    write_be(in + 160, y_re);
+    verbose_assert_bool(bn254_ec_pairing(out, in, 192), false, "BN254",
+                        "Twist points outside of G2 should fail", true);
+    write_be(in + 160, y);
+    verbose_assert_bool(bn254_ec_pairing(out, in, 192), false, "BN254",
+                        "Points off the twist should fail", true);
+}
+
+// the sum of the scalar multiples one by one
+static void bn254_msm_naive(bn254_g1 *r, const bn254_g1 *points,
+                            const u256 *scalars, size_t n) {
+    bn254_g1j acc;
+    clear_words(acc.z, 4);
+    for (size_t i = 0; i < n; i++) {
+        bn254_g1 m;
+        bn254_g1_mul(&m, &points[i], scalars[i]);
+        bn254_g1j_add_affine(&acc, &acc, &m);
+    }
+    bn254_g1j_to(r, &acc);
+}
+
+static bool bn254_g1_same(const bn254_g1 *a, const bn254_g1 *b) {
+    return a->infinity == b->infinity && eq((u64 *)a->x, (u64 *)b->x)
+           && eq((u64 *)a->y, (u64 *)b->y);
+}
+
+void test_bn254_msm() {
+    static bn254_g1 points[200];
+    static u256 scalars[200];
+    uint8_t in[64];
+    bn254_g1 g, want, have;
+    bn254_word(in, 1);
+    bn254_word(in + 32, 2);
+    bn254_g1_from_bytes(&g, in);
+    for (int i = 0; i < 200; i++) {
+        u256 k;
+        for (int j = 0; j < 4; j++) {
+            k[j] = xorshift();
+            scalars[i][j] = xorshift();
+        }
+        bn254_g1_mul(&points[i], &g, k);
+    }
+
+    // repeated and opposite points land in the same buckets, and the
+    // scalars 0 and r and the point at infinity add nothing
+    for (int i = 0; i < 200; i += 50) {
+        points[i+1] = points[i];
+        copy_words(scalars[i+1], scalars[i], 4);
+        points[i+2] = points[i];
+        bn254_fp_neg(points[i+2].y, points[i+2].y);
+        clear_words(scalars[i+3], 4);
+        copy_words(scalars[i+4], (u64 *)bn254_fr_P, 4);
+        points[i+5].infinity = true;
+    }
+
+    size_t sizes[] = {0, 1, 5, 40, 200};
+    bool ok = true;
+    for (int i = 0; i < 5; i++) {
+        size_t n = sizes[i];
+        bn254_msm_naive(&want, points, scalars, n);
+        bn254_g1_msm(&have, points, scalars, n);
+        ok = ok && bn254_g1_same(&have, &want);
+        bn254_g1_msm_threads(&have, points, scalars, n, 3);
+        ok = ok && bn254_g1_same(&have, &want);
+    }
+    verbose_assert_bool(ok, true, "BN254", "MSM should match the sum of ecMul",
+                        true);
+
+    // points and scalars that cancel out
+    for (int i = 0; i < 50; i++) {
+        points[50 + i] = points[i];
+        bn254_fp_neg(points[50 + i].y, points[i].y);
+        copy_words(scalars[50 + i], scalars[i], 4);
+    }
+    bn254_g1_msm(&have, points, scalars, 100);
+    verbose_assert_bool(have.infinity, true, "BN254",
+                        "MSM of cancelling terms should be infinity", true);
+
+    // 2^16 points (i + 1) g, whose sum is (sum of k_i (i + 1)) g, take more
+    // digits and buckets than a megabyte
+    size_t big = (size_t)1 << 16;
+    arena_reset();
+    bn254_g1 *many = arena_alloc(big * sizeof(bn254_g1));
+    bn254_g1j *jac = arena_alloc(big * sizeof(bn254_g1j));
+    u256 *ks = arena_alloc(big * sizeof(u256));
+    u256 *zi = arena_alloc(big * sizeof(u256));
+    u256 sum = {0}, r, zi2;
+    copy_words(r, (u64 *)bn254_fr_P, 4);
+    // the Jacobian multiples go affine with one inversion, with ks as the
+    // scratch until the scalars overwrite it
+    bn254_g1j_from(&jac[0], &g);
+    copy_words(zi[0], jac[0].z, 4);
+    for (size_t i = 1; i < big; i++) {
+        bn254_g1j_add_affine(&jac[i], &jac[i-1], &g);
+        copy_words(zi[i], jac[i].z, 4);
+    }
+    bn254_fp_inv_batch(zi, zi, big, ks);
+    for (size_t i = 0; i < big; i++) {
+        bn254_fp_sqr(zi2, zi[i]);
+        bn254_fp_mul(many[i].x, jac[i].x, zi2);
+        bn254_fp_mul(zi2, zi2, zi[i]);
+        bn254_fp_mul(many[i].y, jac[i].y, zi2);
+        many[i].infinity = false;
+    }
+    for (size_t i = 0; i < big; i++) {
+        u256 k = {xorshift(), xorshift(), xorshift(), xorshift()};
+        u256 m = {i + 1, 0, 0, 0};
+        copy_words(ks[i], k, 4);
+        u256_mul_mod(k, k, m, r);
+        u256_add_mod(sum, sum, k, r);
+    }
+    bn254_g1_mul(&want, &g, sum);
+    bn254_g1_msm(&have, many, ks, big);
+    ok = bn254_g1_same(&have, &want);
+    bn254_g1_msm_threads(&have, many, ks, big, 2);
+    ok = ok && bn254_g1_same(&have, &want);
+    verbose_assert_bool(ok, true, "BN254", "MSM of 2^16 points should match",
+                        true);
+    arena_reset();
+}
+
+/*
+    Poseidon tests
+*/
+void test_poseidon() {
+    // circomlib's poseidon of [1], [1, 2], [1, 2, 3, 4] and [1, ..., 16]
+    u256 want[4] = {
+        {0x8b897dc502820133ULL, 0x0e96a4d1168b3384ULL,
+         0xc1fe6c654d6a3c13ULL, 0x29176100eaa962bdULL},
+        {0x9e19607a4417189aULL, 0x2a3617f274324551ULL,
+         0x3df64c6b9662e9cfULL, 0x115cc0f5e7d69041ULL},
+        {0xbaa525df65250465ULL, 0x37e60ebb1ce0663dULL,
+         0x9dcefa40e4510b98ULL, 0x299c867db6c1fdd7ULL},
+        {0xde2ffb96b919b765ULL, 0xae08afd7f1f2ec06ULL,
+         0x8281a48099fff949ULL, 0x16159a551cbb6610ULL},
+    };
+    size_t sizes[4] = {1, 2, 4, 16};
+    u256 inputs[POSEIDON_MAX_INPUTS + 1], h;
+    for (int i = 0; i <= POSEIDON_MAX_INPUTS; i++) {
+        u256 x = {i + 1, 0, 0, 0};
+        copy_words(inputs[i], x, 4);
+    }
+    bool ok = true;
+    for (int i = 0; i < 4; i++) {
+        ok = ok && poseidon_hash(h, inputs, sizes[i]) && eq(h, want[i]);
+    }
+    verbose_assert_bool(ok, true, "Poseidon", "should match circomlib", true);
+
+    // no inputs and too many
+    ok = poseidon_hash(h, inputs, 0)
+      || poseidon_hash(h, inputs, POSEIDON_MAX_INPUTS + 1);
+    verbose_assert_bool(ok, false, "Poseidon",
+                        "should take 1 to POSEIDON_MAX_INPUTS inputs", true);
+
+    // inputs are reduced mod r, so r + 1 hashes like 1
+    u256 one = {1, 0, 0, 0};
+    u256_add(inputs[0], (u64 *)bn254_fr_P, one);
+    ok = poseidon_hash(h, inputs, 1) && eq(h, want[0]);
+    verbose_assert_bool(ok, true, "Poseidon", "r + 1 should hash like 1", true);
+}
+
+/*
+    NTT tests
+*/
+#define NTT_TEST_LOG 16
+
+static u256 ntt_a[1 << NTT_TEST_LOG], ntt_b[1 << NTT_TEST_LOG];
+static u256 ntt_twiddles[1 << NTT_TEST_LOG];
+
+static void ntt_random(u256 *a, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        u256 x = {xorshift(), xorshift(), xorshift(), xorshift()};
+        bn254_fr_from(a[i], x);
+    }
+}
+
+void test_ntt() {
+    ntt_domain d;
+    bool ok = !ntt_domain_init(&d, 0, ntt_twiddles)
+           && !ntt_domain_init(&d, NTT_MAX_LOG + 1, ntt_twiddles);
+    verbose_assert_bool(ok, true, "NTT", "domains are 2^1 to 2^28", true);
+
+    // a[i] = i goes to a[reverse(i)], in tiles from 2^(2 NTT_TILE_LOG) on
+    ok = true;
+    for (int log_n = 1; log_n <= 12; log_n++) {
+        size_t n = (size_t)1 << log_n;
+        for (size_t i = 0; i < n; i++) {
+            u256 x = {i, 0, 0, 0};
+            copy_words(ntt_a[i], x, 4);
+        }
+        ntt_bit_reverse(ntt_a, log_n);
+        for (size_t i = 0; i < n; i++) {
+            size_t r = 0;
+            for (int j = 0; j < log_n; j++) {
+                r |= ((i >> j) & 1) << (log_n - 1 - j);
+            }
+            ok = ok && ntt_a[r][0] == i;
+        }
+    }
+    verbose_assert_bool(ok, true, "NTT", "bit reversal", true);
+
+    // the forward transform evaluates at the powers of a primitive root w,
+    // w^(n/2) = -1, and the inverse undoes it
+    ok = true;
+    for (int log_n = 1; log_n <= 12; log_n++) {
+        size_t n = (size_t)1 << log_n;
+        ntt_domain_init(&d, log_n, ntt_twiddles);
+        u256 root, minus_one, x;
+        if (log_n == 1) {
+            bn254_fr_one(root);
+            bn254_fr_neg(root, root);
+        } else {
+            copy_words(root, (u64 *)d.w[1], 4);
+        }
+        bn254_fr_one(minus_one);
+        bn254_fr_neg(minus_one, minus_one);
+        copy_words(x, root, 4);
+        for (int i = 1; i < log_n; i++) {
+            bn254_fr_sqr(x, x);
+        }
+        ok = ok && bn254_fr_eq(x, minus_one);
+
+        ntt_random(ntt_a, n);
+        copy_words((u64 *)ntt_b, (u64 *)ntt_a, 4 * n);
+        ntt_forward(&d, ntt_b);
+        if (log_n <= 6) {
+            // Horner at w^k
+            bn254_fr_one(x);
+            for (size_t k = 0; k < n; k++) {
+                u256 y = {0, 0, 0, 0};
+                for (size_t i = n; i-- > 0;) {
+                    bn254_fr_mul(y, y, x);
+                    bn254_fr_add(y, y, ntt_a[i]);
+                }
+                ok = ok && bn254_fr_eq(y, ntt_b[k]);
+                bn254_fr_mul(x, x, root);
+            }
+        }
+        ntt_inverse(&d, ntt_b);
+        ok = ok && __builtin_memcmp(ntt_a, ntt_b, n * sizeof(u256)) == 0;
+    }
+    verbose_assert_bool(ok, true, "NTT", "should evaluate at the roots of unity",
+                        true);
+
+    // the product of two polynomials of degree below 32
+    ntt_domain_init(&d, 6, ntt_twiddles);
+    u256 want[64];
+    ntt_random(ntt_a, 32);
+    ntt_random(ntt_b, 32);
+    clear_words((u64 *)(ntt_a + 32), 4 * 32);
+    clear_words((u64 *)(ntt_b + 32), 4 * 32);
+    clear_words((u64 *)want, 4 * 64);
+    for (int i = 0; i < 32; i++) {
+        for (int j = 0; j < 32; j++) {
+            u256 t;
+            bn254_fr_mul(t, ntt_a[i], ntt_b[j]);
+            bn254_fr_add(want[i+j], want[i+j], t);
+        }
+    }
+    ntt_forward(&d, ntt_a);
+    ntt_forward(&d, ntt_b);
+    for (int i = 0; i < 64; i++) {
+        bn254_fr_mul(ntt_a[i], ntt_a[i], ntt_b[i]);
+    }
+    ntt_inverse(&d, ntt_a);
+    ok = __builtin_memcmp(ntt_a, want, sizeof(want)) == 0;
+    verbose_assert_bool(ok, true, "NTT", "polynomial multiplication", true);
+
+    // threads, from 2^NTT_THREAD_LOG on
+    size_t n = (size_t)1 << NTT_TEST_LOG;
+    ntt_domain_init(&d, NTT_TEST_LOG, ntt_twiddles);
+    ntt_random(ntt_a, n);
+    copy_words((u64 *)ntt_b, (u64 *)ntt_a, 4 * n);
+    ntt_forward(&d, ntt_a);
+    ntt_forward_threads(&d, ntt_b, 3);
+    ok = __builtin_memcmp(ntt_a, ntt_b, n * sizeof(u256)) == 0;
+    ntt_inverse(&d, ntt_a);
+    ntt_inverse_threads(&d, ntt_b, 4);
+    ok = ok && __builtin_memcmp(ntt_a, ntt_b, n * sizeof(u256)) == 0;
+    verbose_assert_bool(ok, true, "NTT", "threads should match", true);
+}
+
+/*
+    Branch-free tests
+*/
+#ifdef U256_BRANCH_FREE
+// counts the user space instructions retired, see perf_event_open(2)
+static int perf_fd = -1;
+
+static bool perf_open() {
+    struct perf_event_attr attr;
+    __builtin_memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perf_fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return perf_fd >= 0;
+}
+
+static void perf_start() {
+    ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+static long long perf_stop() {
+    long long count = 0;
+    ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(perf_fd, &count, sizeof(count)) != sizeof(count)) {
+        return -1;
+    }
+    return count;
+}
+
+// the instructions run by stmt, which should be the same for every input
+#define COUNT_INSTRUCTIONS(stmt) ({ perf_start(); stmt; perf_stop(); })
+
+static void random_word(u256 x) {
+    for (int i = 0; i < 4; i++) {
+        x[i] = xorshift();
+    }
+}
+
+void test_branch_free() {
+    if (!perf_open()) {
+        printf("No instruction counter, skipping the branch-free tests\n");
+        return;
+    }
+
+    u256 x, y, m, ma, res;
+    u512 p;
+    u320 mu;
+    long long want[7];
+    random_word(x);
+    random_word(y);
+    random_word(m);
+    m[3] |= 1;
+    // add_mod keeps the reciprocal of its last modulus, so keep one m
+    copy_words(&ma[0], &m[0], 4);
+    u256_add_mod(res, x, y, ma);
+    x[3] = m[3];
+    y[3] = m[3] >> 1;
+    umul(p, x, y);
+    reciprocal(mu, m);
+    want[0] = COUNT_INSTRUCTIONS(lsh(res, x, 0));
+    want[1] = COUNT_INSTRUCTIONS(rsh(res, x, 0));
+    want[2] = COUNT_INSTRUCTIONS(srsh(res, x, 0));
+    want[3] = COUNT_INSTRUCTIONS(reduce4(res, p, m, mu));
+    want[4] = COUNT_INSTRUCTIONS(u256_add_mod(res, x, y, ma));
+    want[5] = COUNT_INSTRUCTIONS(u256_slt(x, y));
+    want[6] = COUNT_INSTRUCTIONS(u256_sgt(x, y));
+
+    bool same[7] = {true, true, true, true, true, true, true};
+    for (int i = 0; i < 1000; i++) {
+        random_word(x);
+        random_word(y);
+        random_word(m);
+        m[3] |= 1;
+        // every shift amount from 0 to past 256, and negative values
+        u64 n = i % 300;
+        x[3] ^= (u64)(i & 1) << 63;
+        same[0] &= COUNT_INSTRUCTIONS(lsh(res, x, n)) == want[0];
+        same[1] &= COUNT_INSTRUCTIONS(rsh(res, x, n)) == want[1];
+        same[2] &= COUNT_INSTRUCTIONS(srsh(res, x, n)) == want[2];
+
+        // products near m^2 need the most correction steps
+        if (i & 2) {
+            u256_mod(x, x, m);
+            u256_mod(y, y, m);
+        }
+        umul(p, x, y);
+        reciprocal(mu, m);
+        same[3] &= COUNT_INSTRUCTIONS(reduce4(res, p, m, mu)) == want[3];
+
+        // add_mod is branch-free for m >= 2^192, with x and y reduced,
+        // near m or anywhere up to 2^256
+        if (i % 3 == 1) {
+            x[3] = ma[3] - (i % 2);
+            y[3] = ma[3] >> (i % 5);
+        }
+        same[4] &= COUNT_INSTRUCTIONS(u256_add_mod(res, x, y, ma)) == want[4];
+        same[5] &= COUNT_INSTRUCTIONS(u256_slt(x, y)) == want[5];
+        same[6] &= COUNT_INSTRUCTIONS(u256_sgt(x, y)) == want[6];
+    }
+
+    char *names[7] = {"lsh", "rsh", "srsh", "reduce4", "u256_add_mod",
+                            "u256_slt", "u256_sgt"};
+    for (int i = 0; i < 7; i++) {
+        verbose_assert_bool(same[i], true, names[i],
+                            "Should run the same instructions for any input",
+                            true);
+    }
+}
+#endif // U256_BRANCH_FREE
+
 /*
     Randomized tests: arithmetic
 */
@@ -1057,6 +3098,129 @@ void test_sar_random() {
     }
 }
 
+/*
+    Randomized tests: bit counting
+*/
+void test_clz_random() {
+    u256 x, have, want;
+
+    printf("Testing Clz\n");
+    for (int i = 0; i < NUM_TESTS; i++) {
+        GenClzTest((char*)x, (char*)want);
+        u256_clz(have, x);
+        verbose_assert_eq(have, want, "Clz",
+                        "Random bit count should match Go implementation",
+                        false);
+    }
+}
+
+void test_ctz_random() {
+    u256 x, have, want;
+
+    printf("Testing Ctz\n");
+    for (int i = 0; i < NUM_TESTS; i++) {
+        GenCtzTest((char*)x, (char*)want);
+        u256_ctz(have, x);
+        verbose_assert_eq(have, want, "Ctz",
+                        "Random bit count should match Go implementation",
+                        false);
+    }
+}
+
+void test_popcount_random() {
+    u256 x, have, want;
+
+    printf("Testing Popcount\n");
+    for (int i = 0; i < NUM_TESTS; i++) {
+        GenPopcountTest((char*)x, (char*)want);
+        u256_popcount(have, x);
+        verbose_assert_eq(have, want, "Popcount",
+                        "Random bit count should match Go implementation",
+                        false);
+    }
+}
+
+void test_bit_reverse_random() {
+    u256 x, have, want;
+
+    printf("Testing BitReverse\n");
+    for (int i = 0; i < NUM_TESTS; i++) {
+        GenBitReverseTest((char*)x, (char*)want);
+        u256_bit_reverse(have, x);
+        verbose_assert_eq(have, want, "BitReverse",
+                        "Random bit reversal should match Go implementation",
+                        false);
+    }
+}
+
+void test_bswap_random() {
+    u256 x, have, want;
+
+    printf("Testing Bswap\n");
+    for (int i = 0; i < NUM_TESTS; i++) {
+        GenBswapTest((char*)x, (char*)want);
+        u256_bswap(have, x);
+        verbose_assert_eq(have, want, "Bswap",
+                        "Random byte swap should match Go implementation",
+                        false);
+    }
+}
+
+void test_big_endian_random() {
+    u256 x, y, index, have, want;
+    uint8_t bx[32], by[32];
+
+    printf("Testing BigEndian\n");
+    for (int i = 0; i < NUM_TESTS; i++) {
+        GenXorTest((char*)x, (char*)y, (char*)want);
+        write_be(bx, x);
+        write_be(by, y);
+        u256be_xor(bx, by);
+        read_be(have, bx);
+        verbose_assert_eq(have, want, "BigEndian",
+                        "Random big endian xor should match Go implementation",
+                        false);
+
+        write_be(bx, x);
+        verbose_assert_bool(u256be_lt(bx, by), u256_lt(x, y), "BigEndian",
+                            "Big endian lt should match Lt", false);
+        verbose_assert_bool(u256be_slt(bx, by), u256_slt(x, y), "BigEndian",
+                            "Big endian slt should match Slt", false);
+        verbose_assert_bool(u256be_eq(bx, bx), true, "BigEndian",
+                            "Big endian eq should be reflexive", false);
+
+        u256_and(want, x, y);
+        write_be(bx, x);
+        u256be_and(bx, by);
+        read_be(have, bx);
+        verbose_assert_eq(have, want, "BigEndian",
+                          "Big endian and should match And", false);
+        u256_or(want, x, y);
+        write_be(bx, x);
+        u256be_or(bx, by);
+        read_be(have, bx);
+        verbose_assert_eq(have, want, "BigEndian",
+                          "Big endian or should match Or", false);
+        u256_not(want, x);
+        write_be(bx, x);
+        u256be_not(bx);
+        read_be(have, bx);
+        verbose_assert_eq(have, want, "BigEndian",
+                          "Big endian not should match Not", false);
+
+        // index into x with the low bits of y
+        clear_words(&index[0], 4);
+        index[0] = y[0] & 0x3f;
+        u256_byte(want, x, index);
+        write_be(bx, x);
+        write_be(by, index);
+        u256be_byte(bx, by);
+        read_be(have, bx);
+        verbose_assert_eq(have, want, "BigEndian",
+                          "Big endian byte should match Byte", false);
+    }
+}
+
 
 int main() {
     //////////////////////////// Arithmetic tests
@@ -1090,6 +3254,67 @@ int main() {
     test_shr();
     test_sar();
 
+    //////////////////////////// Bit counting tests
+    test_bit_counting();
+
+    //////////////////////////// Batch tests
+    test_batch();
+
+    //////////////////////////// ABI tests
+    test_abi();
+
+    //////////////////////////// Packed tests
+    test_packed();
+
+    //////////////////////////// Interpreter tests
+    test_interp();
+
+    //////////////////////////// Arena tests
+    test_arena();
+
+    //////////////////////////// Slot cache tests
+    test_slot();
+
+    //////////////////////////// Environment tests
+    test_env();
+
+    //////////////////////////// Vector tests
+    test_vector();
+
+    //////////////////////////// Big endian tests
+    test_big_endian();
+
+    //////////////////////////// Bitfield tests
+    test_bitfield();
+
+    //////////////////////////// Bitmap tests
+    test_bitmap();
+
+    //////////////////////////// Field tests
+    test_field();
+
+    //////////////////////////// secp256k1 tests
+    test_secp256k1();
+
+    //////////////////////////// P-256 tests
+    test_p256();
+
+    //////////////////////////// BN254 tests
+    test_bn254();
+    test_bn254_pairing();
+    test_bn254_msm();
+
+    //////////////////////////// Poseidon tests
+    test_poseidon();
+
+    //////////////////////////// NTT tests
+    test_ntt();
+
+#ifdef U256_BRANCH_FREE
+    //////////////////////////// Branch-free tests
+    test_branch_free();
+#endif
+
     //////////////////////////// Random tests: Arithmetic
     printf("Running %i random tests!\n", NUM_TESTS);
     test_add_random();
@@ -1122,5 +3347,15 @@ int main() {
     test_shr_random();
     test_sar_random();
 
+    //////////////////////////// Random tests: Bit counting
+    test_clz_random();
+    test_ctz_random();
+    test_popcount_random();
+    test_bit_reverse_random();
+    test_bswap_random();
+
+    //////////////////////////// Random tests: Big endian
+    test_big_endian_random();
+
     printf("All tests passed!\n");
 }
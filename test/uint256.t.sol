@@ -33,6 +33,46 @@ interface Uint256 {
     function Shl(uint x, uint shift) external pure returns (uint z);
     function Shr(uint x, uint shift) external pure returns (uint z);
     function Sar(uint x, uint shift) external pure returns (uint z);
+
+    // bit counting
+    function Clz(uint x) external pure returns (uint z);
+    function Ctz(uint x) external pure returns (uint z);
+    function Popcount(uint x) external pure returns (uint z);
+
+    // signatures, see include/secp256k1.h
+    function EcRecover(bytes32 hash, uint8 v, bytes32 r, bytes32 s) external pure returns (address);
+    function EcVerifyBatch(uint[] calldata sigs) external pure returns (bool);
+
+    // returns 1, or no data if the signature is invalid, like the RIP-7212
+    // precompile
+    function P256Verify(bytes32 hash, bytes32 r, bytes32 s, bytes32 x, bytes32 y) external pure returns (uint);
+
+    // BN254, with the input and output of the precompiles 0x06 and 0x07
+    function EcAdd(uint x1, uint y1, uint x2, uint y2) external pure returns (uint x, uint y);
+    function EcMul(uint x1, uint y1, uint k) external pure returns (uint x, uint y);
+    function EcMsm(uint[] calldata terms) external pure returns (uint x, uint y);
+    function EcPairing(uint[] calldata pairs) external pure returns (bool);
+
+    // poseidon
+    function Poseidon(uint[] calldata inputs) external pure returns (uint);
+
+    // batch
+    function Batch(bytes calldata program) external pure returns (uint[] memory);
+    function Exec(bytes calldata code, uint[] calldata inputs) external pure returns (uint[] memory);
+
+    // arrays
+    function AddArray(uint[] calldata x, uint[] calldata y) external pure returns (uint[] memory);
+    function MulArray(uint[] calldata x, uint[] calldata y) external pure returns (uint[] memory);
+    function MulModArray(uint[] calldata x, uint[] calldata y, uint m) external pure returns (uint[] memory);
+    function InvModArray(uint[] calldata x, uint m) external pure returns (uint[] memory);
+    function SumArray(uint[] calldata x) external pure returns (uint z);
+    function DotMod(uint[] calldata x, uint[] calldata y, uint m) external pure returns (uint z);
+    function LtMask(uint[] calldata x, uint[] calldata y) external pure returns (uint[] memory);
+
+    // packed: called with the selector followed by the packed bytes, not an
+    // ABI encoded bytes argument. See include/packed.h and scripts/packed.js
+    function AddPacked(bytes calldata data) external pure returns (uint z);
+    function BatchPacked(bytes calldata program) external pure returns (uint[] memory);
 }
 
 contract Uint256Test {
@@ -3,6 +3,7 @@ package main
 import "C"
 import (
     "crypto/rand"
+    "math/bits"
     "unsafe"
     "github.com/holiman/uint256"
 )
@@ -78,6 +79,24 @@ func randomize_to_small_int(c_bytes []byte, n byte) *uint256.Int {
     return bytes_to_uint(c_bytes)
 }
 
+// bit counts need values with any number of leading and trailing zeros
+func randomize_to_sparse(c_bytes []byte) *uint256.Int {
+    d := randomize_to_uint(c_bytes)
+    hi := uint(c_bytes[31])
+    lo := uint(c_bytes[0]) % (256 - hi)
+
+    // clear the top hi bits and the bottom lo bits
+    d.Lsh(d, hi)
+    d.Rsh(d, hi)
+    d.Rsh(d, lo)
+    d.Lsh(d, lo)
+
+    for i, b := range d.Bytes32() {
+        c_bytes[31 - i] = b
+    }
+    return d
+}
+
 //export GenAddTest
 func GenAddTest(x, y, res *C.char) {
     // typecast x to byte slice
@@ -612,4 +631,100 @@ func GenSarTest(x, y, res *C.char) {
     }
 }
 
+func ctz(x *uint256.Int) uint64 {
+    for i := 0; i < 4; i++ {
+        if x[i] != 0 {
+            return uint64(64*i + bits.TrailingZeros64(x[i]))
+        }
+    }
+    return 256
+}
+
+//export GenClzTest
+func GenClzTest(x, res *C.char) {
+    // typecast x to byte slice
+    x_bytes := (*[32]byte)(unsafe.Pointer(x))[:32:32]
+    x_int := randomize_to_sparse(x_bytes)
+
+    // compute result
+    res_int := uint256.NewInt(uint64(256 - x_int.BitLen()))
+
+    // write result as little endian bytes
+    res_bytes := (*[32]byte)(unsafe.Pointer(res))[:32:32]
+    for i, b := range res_int.Bytes32() {
+        res_bytes[31 - i] = b
+    }
+}
+
+//export GenCtzTest
+func GenCtzTest(x, res *C.char) {
+    // typecast x to byte slice
+    x_bytes := (*[32]byte)(unsafe.Pointer(x))[:32:32]
+    x_int := randomize_to_sparse(x_bytes)
+
+    // compute result
+    res_int := uint256.NewInt(ctz(x_int))
+
+    // write result as little endian bytes
+    res_bytes := (*[32]byte)(unsafe.Pointer(res))[:32:32]
+    for i, b := range res_int.Bytes32() {
+        res_bytes[31 - i] = b
+    }
+}
+
+//export GenPopcountTest
+func GenPopcountTest(x, res *C.char) {
+    // typecast x to byte slice
+    x_bytes := (*[32]byte)(unsafe.Pointer(x))[:32:32]
+    x_int := randomize_to_sparse(x_bytes)
+
+    // compute result
+    res_int := uint256.NewInt(uint64(bits.OnesCount64(x_int[0]) + bits.OnesCount64(x_int[1]) +
+        bits.OnesCount64(x_int[2]) + bits.OnesCount64(x_int[3])))
+
+    // write result as little endian bytes
+    res_bytes := (*[32]byte)(unsafe.Pointer(res))[:32:32]
+    for i, b := range res_int.Bytes32() {
+        res_bytes[31 - i] = b
+    }
+}
+
+//export GenBitReverseTest
+func GenBitReverseTest(x, res *C.char) {
+    // typecast x to byte slice
+    x_bytes := (*[32]byte)(unsafe.Pointer(x))[:32:32]
+    x_int := randomize_to_uint(x_bytes)
+
+    // compute result
+    res_int := &uint256.Int{
+        bits.Reverse64(x_int[3]), bits.Reverse64(x_int[2]),
+        bits.Reverse64(x_int[1]), bits.Reverse64(x_int[0]),
+    }
+
+    // write result as little endian bytes
+    res_bytes := (*[32]byte)(unsafe.Pointer(res))[:32:32]
+    for i, b := range res_int.Bytes32() {
+        res_bytes[31 - i] = b
+    }
+}
+
+//export GenBswapTest
+func GenBswapTest(x, res *C.char) {
+    // typecast x to byte slice
+    x_bytes := (*[32]byte)(unsafe.Pointer(x))[:32:32]
+    x_int := randomize_to_uint(x_bytes)
+
+    // compute result
+    res_int := &uint256.Int{
+        bits.ReverseBytes64(x_int[3]), bits.ReverseBytes64(x_int[2]),
+        bits.ReverseBytes64(x_int[1]), bits.ReverseBytes64(x_int[0]),
+    }
+
+    // write result as little endian bytes
+    res_bytes := (*[32]byte)(unsafe.Pointer(res))[:32:32]
+    for i, b := range res_int.Bytes32() {
+        res_bytes[31 - i] = b
+    }
+}
+
 func main() {}